@@ -0,0 +1,163 @@
+#ifndef ARRAY_STATS_GUARD
+#define ARRAY_STATS_GUARD
+
+/*
+ *  Allocation and copy statistics of dynamic arrays.
+ *
+ *  Counting is opt-in: define DS_ARRAY_STATS to 1 before including
+ *  dynamic_array.hpp (consistently in every translation unit). Otherwise
+ *  dynamic_array has no counters and stats() reports zeros.
+ *
+ *  The counters of one array are read with arr.stats(). Arrays created at
+ *  the same place are aggregated by attaching them to a stats_site, which
+ *  receives their counters when they are destroyed:
+ *
+ *      dynamic_array<Order> orders;
+ *      orders.attach_stats(DS_ARRAY_STATS_SITE);
+ *      ...
+ *      ds::stats_site::report(std::cerr);
+*/
+
+#include <algorithm> // std::max, std::sort
+#include <cstddef>   // std::size_t
+#include <mutex>     // Site aggregation is thread-safe
+#include <ostream>   // Reports
+#include <string>    // Site names
+#include <utility>   // std::pair
+#include <vector>    // Site registry
+
+#ifndef DS_ARRAY_STATS
+#define DS_ARRAY_STATS 0
+#endif
+
+namespace ds
+{
+    struct array_stats
+    {
+        std::size_t allocations = 0;     // Buffers requested from the allocator
+        std::size_t reallocations = 0;   // Buffers replaced by a larger or smaller one
+        std::size_t bytes_allocated = 0; // Sum of the requested buffer sizes
+        std::size_t bytes_copied = 0;    // Elements copied into a new buffer (sizeof(T) each, memcpy included)
+        std::size_t moves = 0;           // Elements move-constructed into a new buffer
+        std::size_t peak_capacity = 0;   // Largest capacity ever held
+        std::size_t wasted_capacity = 0; // Unused capacity when the counters were taken
+
+        // Aggregation - the peak is the largest one, everything else adds up
+        array_stats &operator+=(const array_stats &other)
+        {
+            allocations += other.allocations;
+            reallocations += other.reallocations;
+            bytes_allocated += other.bytes_allocated;
+            bytes_copied += other.bytes_copied;
+            moves += other.moves;
+            peak_capacity = std::max(peak_capacity, other.peak_capacity);
+            wasted_capacity += other.wasted_capacity;
+
+            return *this;
+        }
+
+        friend array_stats operator+(array_stats lhs, const array_stats &rhs) { return lhs += rhs; }
+
+        friend std::ostream &operator<<(std::ostream &os, const array_stats &stats)
+        {
+            return os << "allocations: " << stats.allocations << ", reallocations: " << stats.reallocations
+                      << ", bytes allocated: " << stats.bytes_allocated << ", bytes copied: " << stats.bytes_copied
+                      << ", moves: " << stats.moves << ", peak capacity: " << stats.peak_capacity
+                      << ", wasted capacity: " << stats.wasted_capacity;
+        }
+    };
+
+    // Sum of the statistics of the arrays attached to it, e.g. all arrays created on one source line.
+    // Recording is thread-safe; every live site is listed by report().
+    class stats_site
+    {
+    public:
+        explicit stats_site(std::string name) : m_name(std::move(name))
+        {
+            std::lock_guard<std::mutex> lock(registry_mutex());
+            registry().push_back(this);
+        }
+
+        ~stats_site()
+        {
+            std::lock_guard<std::mutex> lock(registry_mutex());
+            auto &sites = registry();
+            sites.erase(std::remove(sites.begin(), sites.end(), this), sites.end());
+        }
+
+        stats_site(const stats_site &) = delete;
+        stats_site &operator=(const stats_site &) = delete;
+
+        // Adds the counters of one array
+        void record(const array_stats &stats)
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_total += stats;
+            m_arrays++;
+        }
+
+        array_stats total() const
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            return m_total;
+        }
+
+        // Number of recorded arrays
+        std::size_t arrays() const
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            return m_arrays;
+        }
+
+        const std::string &name() const { return m_name; }
+
+        // One line per site, the sites with the most reallocations first
+        static void report(std::ostream &os)
+        {
+            std::vector<std::pair<const stats_site *, array_stats>> totals;
+            {
+                std::lock_guard<std::mutex> lock(registry_mutex());
+                for (const stats_site *site : registry())
+                    totals.emplace_back(site, site->total());
+            }
+
+            std::sort(totals.begin(), totals.end(), [](const auto &lhs, const auto &rhs)
+                      { return lhs.second.reallocations > rhs.second.reallocations; });
+
+            for (const auto &[site, total] : totals)
+                os << site->name() << " (" << site->arrays() << " arrays): " << total << '\n';
+        }
+
+    private:
+        // Never destroyed, sites of static arrays may outlive any other static object
+        static std::mutex &registry_mutex()
+        {
+            static std::mutex *mutex = new std::mutex;
+            return *mutex;
+        }
+
+        static std::vector<stats_site *> &registry()
+        {
+            static std::vector<stats_site *> *sites = new std::vector<stats_site *>;
+            return *sites;
+        }
+
+        std::string m_name;
+        mutable std::mutex m_mutex;
+        array_stats m_total;
+        std::size_t m_arrays = 0;
+    };
+
+} // namespace ds
+
+#define DS_ARRAY_STATS_STRINGIFY_(x) #x
+#define DS_ARRAY_STATS_STRINGIFY(x) DS_ARRAY_STATS_STRINGIFY_(x)
+
+// The stats_site of the current source line (created on first use and never destroyed)
+#define DS_ARRAY_STATS_SITE                                                                                  \
+    ([]() -> ::ds::stats_site * {                                                                           \
+        static ::ds::stats_site *site = new ::ds::stats_site(__FILE__ ":" DS_ARRAY_STATS_STRINGIFY(__LINE__)); \
+        return site;                                                                                        \
+    }())
+
+#endif // ARRAY_STATS_GUARD
@@ -0,0 +1,130 @@
+#define CATCH_CONFIG_MAIN
+#define DS_ARRAY_STATS 1
+#include "../Catch2/catch.hpp"
+#include "dynamic_array.hpp"
+
+#include <sstream>
+#include <string>
+
+using namespace ds;
+
+// Copyable only - relocation has to copy
+struct CopyOnly
+{
+    CopyOnly(int value) : value(value) {}
+    CopyOnly(const CopyOnly &other) : value(other.value) {}
+    CopyOnly &operator=(const CopyOnly &) = default;
+
+    int value;
+};
+
+TEST_CASE("ARRAY COUNTERS", "[STATS]")
+{
+    SECTION("GROWTH")
+    {
+        dynamic_array<int> foo(4);
+        for (int i = 0; i < 20; i++)
+            foo.push_back(i);
+
+        // 4 -> 8 -> 16 -> 32
+        const array_stats stats = foo.stats();
+        REQUIRE(stats.allocations == 4);
+        REQUIRE(stats.reallocations == 3);
+        REQUIRE(stats.bytes_allocated == (4 + 8 + 16 + 32) * sizeof(int));
+        REQUIRE(stats.bytes_copied == (4 + 8 + 16) * sizeof(int)); // Trivially copyable - memcpy
+        REQUIRE(stats.moves == 0);
+        REQUIRE(stats.peak_capacity == 32);
+        REQUIRE(stats.wasted_capacity == 12);
+
+        foo.shrink_to_fit();
+        REQUIRE(foo.stats().reallocations == 4);
+        REQUIRE(foo.stats().wasted_capacity == 0);
+        REQUIRE(foo.stats().peak_capacity == 32);
+    }
+
+    SECTION("MOVES AND COPIES")
+    {
+        dynamic_array<std::string> foo(2);
+        foo.push_back("a");
+        foo.push_back("b");
+        foo.push_back("c");
+
+        REQUIRE(foo.stats().moves == 2);
+        REQUIRE(foo.stats().bytes_copied == 0);
+
+        dynamic_array<CopyOnly> bar(1);
+        bar.push_back(1);
+        bar.insert(0, 2);
+
+        REQUIRE(bar.stats().moves == 0);
+        REQUIRE(bar.stats().bytes_copied == sizeof(CopyOnly));
+
+        dynamic_array<std::string> baz(foo);
+        REQUIRE(baz.stats().allocations == 1);
+        REQUIRE(baz.stats().bytes_copied == 3 * sizeof(std::string));
+
+        dynamic_array<std::string> qux;
+        qux = foo;
+        REQUIRE(qux.stats().allocations == 2);
+        REQUIRE(qux.stats().bytes_copied == 3 * sizeof(std::string));
+    }
+
+    SECTION("RESERVE AVOIDS REALLOCATIONS")
+    {
+        dynamic_array<int> foo;
+        foo.reserve(1000);
+        for (int i = 0; i < 1000; i++)
+            foo.push_back(i);
+
+        REQUIRE(foo.stats().reallocations == 1);
+        REQUIRE(foo.stats().wasted_capacity == 0);
+    }
+}
+
+TEST_CASE("AGGREGATION", "[STATS]")
+{
+    SECTION("SUM OF STATS")
+    {
+        array_stats a, b;
+        a.allocations = 2;
+        a.peak_capacity = 10;
+        b.allocations = 3;
+        b.peak_capacity = 7;
+
+        const array_stats sum = a + b;
+        REQUIRE(sum.allocations == 5);
+        REQUIRE(sum.peak_capacity == 10);
+    }
+
+    SECTION("CALL SITES")
+    {
+        stats_site site("orders");
+
+        for (int round = 0; round < 3; round++)
+        {
+            dynamic_array<int> foo(4);
+            foo.attach_stats(&site);
+            for (int i = 0; i < 5; i++)
+                foo.push_back(i);
+        }
+
+        REQUIRE(site.arrays() == 3);
+        REQUIRE(site.total().reallocations == 3);
+        REQUIRE(site.total().wasted_capacity == 9);
+        REQUIRE(site.total().peak_capacity == 8);
+
+        stats_site *line = nullptr;
+        for (int round = 0; round < 2; round++)
+        {
+            dynamic_array<int> foo;
+            line = DS_ARRAY_STATS_SITE;
+            foo.attach_stats(line);
+        }
+        REQUIRE(line->arrays() == 2);
+        REQUIRE(line->name().find("array_stats_tests.cpp:") != std::string::npos);
+
+        std::ostringstream report;
+        stats_site::report(report);
+        REQUIRE(report.str().find("orders (3 arrays): allocations: 6, reallocations: 3") != std::string::npos);
+    }
+}
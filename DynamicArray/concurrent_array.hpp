@@ -0,0 +1,662 @@
+#ifndef CONCURRENT_ARRAY_GUARD
+#define CONCURRENT_ARRAY_GUARD
+
+/*
+ *  Append-only random access container which many threads can grow at once.
+ *
+ *  The storage is the block layout of segmented_array: elements never move,
+ *  so a thread can keep reading an element while others append. A push_back
+ *  claims its slots by advancing an atomic counter and constructs the
+ *  element in place, missing blocks are allocated with a compare-and-swap on
+ *  their directory entry - no lock is taken anywhere.
+ *
+ *  Every slot has a ready flag which is set once its element is constructed.
+ *  size() counts the published elements only: the longest prefix of ready
+ *  slots. Whoever finishes a slot advances it, so no appender waits for a
+ *  slower one and a reader never sees an element under construction.
+ *
+ *  Thread safety:
+ *  - push_back, emplace_back, grow_by, reserve and all read operations may be
+ *    called concurrently.
+ *  - The elements below size(), and the ones returned by the caller's own
+ *    appends, are fully constructed and may be read at any time.
+ *  - clear, copy, move, assignment and destruction require exclusive access.
+ *
+ *  A constructor that throws leaves its slot (and the rest of the slots it
+ *  claimed) value-initialized, hence T has to be nothrow default constructible.
+*/
+
+#include "segmented_array.hpp" // Block layout, iterator
+
+#include <algorithm>   // std::min
+#include <atomic>      // Size counter, directory
+#include <cstddef>     // std::size_t
+#include <memory>      // std::allocator_traits
+#include <stdexcept>   // Exceptions
+#include <type_traits> // Requirements on T
+#include <utility>     // std::move_if_noexcept
+
+namespace ds
+{
+    template <class T, std::size_t FirstBlock = INIT_CAPACITY, class Allocator = std::allocator<T>>
+    class concurrent_array
+    {
+        static_assert(std::is_nothrow_default_constructible_v<T>, "concurrent_array: T has to be nothrow default constructible");
+
+        using alloc_traits = std::allocator_traits<Allocator>;
+        using layout = detail::block_layout<FirstBlock>;
+
+        template <class, class>
+        friend class detail::indexed_iterator;
+
+    public:
+        using value_type = T;
+        using allocator_type = Allocator;
+        using size_type = std::size_t;
+        using difference_type = std::ptrdiff_t;
+        using reference = T &;
+        using const_reference = const T &;
+
+        using iterator = detail::indexed_iterator<T, concurrent_array>;
+        using const_iterator = detail::indexed_iterator<const T, const concurrent_array>;
+
+        // Constructors, Destructors; Gang of Four
+
+        // Constructs an empty container, no block is allocated until the first element
+        explicit concurrent_array(const Allocator &alloc = Allocator());
+
+        // Constructs a container with a copy of each of the elements in il, in the same order.
+        concurrent_array(const std::initializer_list<T> &i_list, const Allocator &alloc = Allocator());
+
+        // Constructs a container with a copy of each of the elements and keep the original order
+        // The allocator is obtained by select_on_container_copy_construction
+        concurrent_array(const concurrent_array &other);
+
+        // Allocator-extended copy constructor
+        concurrent_array(const concurrent_array &other, const Allocator &alloc);
+
+        // Move constructor - takes over the blocks and the allocator, other is left empty with no storage
+        concurrent_array(concurrent_array &&other) noexcept;
+
+        // Copy assignment operator (copy-and-swap idiom)
+        // The allocator is replaced only if it propagates on copy assignment
+        concurrent_array &operator=(const concurrent_array &other);
+
+        // Move assignment operator - takes over the blocks if the allocator propagates on move assignment
+        // or the allocators compare equal, otherwise the elements are moved one by one
+        concurrent_array &operator=(concurrent_array &&other) noexcept(alloc_traits::propagate_on_container_move_assignment::value ||
+                                                                       alloc_traits::is_always_equal::value);
+
+        // Destructor
+        ~concurrent_array();
+
+        ///
+        // Basic Operations - thread-safe
+
+        // Add one element to the back, returns its position
+        iterator push_back(const T &el);
+        iterator push_back(T &&el);
+
+        // Constructs an element in place at the back from args, returns its position
+        template <class... Args>
+        iterator emplace_back(Args &&...args);
+
+        // Appends count value-initialized elements in consecutive slots, returns the first of them
+        iterator grow_by(size_type count);
+
+        // Appends count copies of value in consecutive slots, returns the first of them
+        iterator grow_by(size_type count, const T &value);
+
+        ///
+        // Access operations - thread-safe for published elements, and for the caller's own ones
+        // The subscripts are checked against the claimed slots
+        const T &operator[](size_type index) const;
+        T &operator[](size_type index);
+        const T &at(size_type index) const;
+        T &at(size_type index);
+        const T &front() const;
+        T &front();
+        const T &back() const;
+        T &back();
+
+        ///
+        // Remove operations - not thread-safe
+
+        // Destroys all elements, the blocks are kept for reuse
+        void clear();
+
+        ///
+        // Capacity operations
+
+        // Allocates blocks until new_capacity elements fit - thread-safe
+        void reserve(size_type new_capacity);
+
+        // Published elements - every one of them is fully constructed
+        size_type size() const { return m_size.load(std::memory_order_acquire); }
+        size_type capacity() const;
+        size_type max_size() const;
+        bool empty() const { return size() == 0; }
+        allocator_type get_allocator() const { return m_alloc; }
+
+        ///
+        // Iterator - random access through the directory, end() is the size at the time of the call
+        iterator begin() noexcept { return iterator(this, 0); }
+        iterator end() noexcept { return iterator(this, size()); }
+        const_iterator begin() const noexcept { return const_iterator(this, 0); }
+        const_iterator end() const noexcept { return const_iterator(this, size()); }
+        const_iterator cbegin() const noexcept { return begin(); }
+        const_iterator cend() const noexcept { return end(); }
+
+    private:
+        using flag = std::atomic<bool>;
+        using flag_allocator = typename alloc_traits::template rebind_alloc<flag>;
+        using flag_traits = std::allocator_traits<flag_allocator>;
+
+        Allocator m_alloc; // Its allocate and deallocate are called concurrently
+        std::atomic<T *> m_directory[layout::max_blocks] = {};
+        std::atomic<flag *> m_ready[layout::max_blocks] = {}; // Ready flags, same layout as the elements
+        std::atomic<size_type> m_claimed{0};                   // Slots handed out to appenders
+        std::atomic<size_type> m_size{0};                      // Published prefix, m_size <= m_claimed
+
+        ///
+        // Helpers
+    private:
+        // O(1) - Address of the element at index
+        T *locate(size_type index) const
+        {
+            return m_directory[layout::block_of(index)].load(std::memory_order_acquire) + layout::offset_of(index);
+        }
+
+        // O(1) - Ready flag of the slot at index
+        flag &ready(size_type index) const
+        {
+            return m_ready[layout::block_of(index)].load(std::memory_order_acquire)[layout::offset_of(index)];
+        }
+
+        void ensure_blocks(size_type first, size_type last);
+        size_type claim(size_type count);
+
+        template <class Construct>
+        iterator construct_claimed(size_type first, size_type count, Construct construct);
+
+        void publish(size_type first, size_type count) noexcept;
+        void destroy_elements() noexcept;
+        void release() noexcept;
+        void steal(concurrent_array &src) noexcept;
+
+        // The allocators are exchanged only if they propagate on swap,
+        // otherwise they must compare equal. Requires exclusive access to both.
+        friend void swap(concurrent_array &first, concurrent_array &second) noexcept
+        {
+            using std::swap;
+            if constexpr (alloc_traits::propagate_on_container_swap::value)
+            {
+                swap(first.m_alloc, second.m_alloc);
+            }
+            else
+            {
+                assert(first.m_alloc == second.m_alloc);
+            }
+
+            for (size_type block = 0; block < layout::max_blocks; block++)
+            {
+                first.m_directory[block].store(second.m_directory[block].exchange(first.m_directory[block].load(std::memory_order_relaxed)), std::memory_order_relaxed);
+                first.m_ready[block].store(second.m_ready[block].exchange(first.m_ready[block].load(std::memory_order_relaxed)), std::memory_order_relaxed);
+            }
+
+            first.m_claimed.store(second.m_claimed.exchange(first.m_claimed.load(std::memory_order_relaxed)), std::memory_order_relaxed);
+            first.m_size.store(second.m_size.exchange(first.m_size.load(std::memory_order_relaxed)), std::memory_order_release);
+        }
+    };
+
+    // O(1) - Constant time
+    template <class T, std::size_t FirstBlock, class Allocator>
+    inline concurrent_array<T, FirstBlock, Allocator>::concurrent_array(const Allocator &alloc)
+        : m_alloc(alloc)
+    {
+    }
+
+    // O(n) - Linear time
+    template <class T, std::size_t FirstBlock, class Allocator>
+    inline concurrent_array<T, FirstBlock, Allocator>::concurrent_array(const std::initializer_list<T> &i_list, const Allocator &alloc)
+        : m_alloc(alloc)
+    {
+        try
+        {
+            const T *source = i_list.begin();
+            construct_claimed(claim(i_list.size()), i_list.size(), [&](T *slot, size_type i)
+                              { alloc_traits::construct(m_alloc, slot, source[i]); });
+        }
+        catch (...)
+        {
+            release();
+            throw;
+        }
+    }
+
+    // O(n) - Linear time
+    template <class T, std::size_t FirstBlock, class Allocator>
+    inline concurrent_array<T, FirstBlock, Allocator>::concurrent_array(const concurrent_array &other)
+        : concurrent_array(other, alloc_traits::select_on_container_copy_construction(other.m_alloc))
+    {
+    }
+
+    // O(n) - Linear time
+    template <class T, std::size_t FirstBlock, class Allocator>
+    inline concurrent_array<T, FirstBlock, Allocator>::concurrent_array(const concurrent_array &other, const Allocator &alloc)
+        : m_alloc(alloc)
+    {
+        try
+        {
+            const size_type count = other.size();
+            construct_claimed(claim(count), count, [&](T *slot, size_type i)
+                              { alloc_traits::construct(m_alloc, slot, *other.locate(i)); });
+        }
+        catch (...)
+        {
+            release();
+            throw;
+        }
+    }
+
+    // O(1) - Constant time
+    template <class T, std::size_t FirstBlock, class Allocator>
+    inline concurrent_array<T, FirstBlock, Allocator>::concurrent_array(concurrent_array &&other) noexcept
+        : m_alloc(std::move(other.m_alloc))
+    {
+        steal(other);
+    }
+
+    // O(n) - Linear time
+    // The copy is made with the allocator *this should end up with, so the
+    // following swap never has to exchange unequal allocators.
+    template <class T, std::size_t FirstBlock, class Allocator>
+    inline concurrent_array<T, FirstBlock, Allocator> &concurrent_array<T, FirstBlock, Allocator>::operator=(const concurrent_array &other)
+    {
+        if (this == &other)
+            return *this;
+
+        if constexpr (alloc_traits::propagate_on_container_copy_assignment::value)
+        {
+            concurrent_array copy(other, other.m_alloc);
+            release(); // Releases the blocks with the allocator that owns them
+            m_alloc = other.m_alloc;
+            swap(*this, copy);
+        }
+        else
+        {
+            concurrent_array copy(other, m_alloc);
+            swap(*this, copy);
+        }
+
+        return *this;
+    }
+
+    // O(1) - Constant time, O(n) if the allocators differ and do not propagate
+    template <class T, std::size_t FirstBlock, class Allocator>
+    inline concurrent_array<T, FirstBlock, Allocator> &concurrent_array<T, FirstBlock, Allocator>::operator=(concurrent_array &&other) noexcept(
+        alloc_traits::propagate_on_container_move_assignment::value || alloc_traits::is_always_equal::value)
+    {
+        if (this == &other)
+            return *this;
+
+        if constexpr (alloc_traits::propagate_on_container_move_assignment::value)
+        {
+            release(); // Releases the blocks with the allocator that owns them
+            m_alloc = std::move(other.m_alloc);
+            steal(other);
+        }
+        else
+        {
+            if (alloc_traits::is_always_equal::value || m_alloc == other.m_alloc)
+            {
+                release();
+                steal(other);
+            }
+            else
+            {
+                // The blocks of other can not be freed by m_alloc - move the elements into blocks of our own
+                concurrent_array moved(m_alloc);
+                const size_type count = other.size();
+                moved.construct_claimed(moved.claim(count), count, [&](T *slot, size_type i)
+                                        { alloc_traits::construct(moved.m_alloc, slot, std::move_if_noexcept(*other.locate(i))); });
+                swap(*this, moved);
+                other.clear();
+            }
+        }
+
+        return *this;
+    }
+
+    // O(n) - Linear time
+    template <class T, std::size_t FirstBlock, class Allocator>
+    inline concurrent_array<T, FirstBlock, Allocator>::~concurrent_array()
+    {
+        release();
+    }
+
+    // O(1) - Constant time
+    template <class T, std::size_t FirstBlock, class Allocator>
+    inline typename concurrent_array<T, FirstBlock, Allocator>::iterator concurrent_array<T, FirstBlock, Allocator>::push_back(const T &el)
+    {
+        return emplace_back(el);
+    }
+
+    // O(1) - Constant time
+    template <class T, std::size_t FirstBlock, class Allocator>
+    inline typename concurrent_array<T, FirstBlock, Allocator>::iterator concurrent_array<T, FirstBlock, Allocator>::push_back(T &&el)
+    {
+        return emplace_back(std::move(el));
+    }
+
+    // O(1) - Constant time (lock-free)
+    template <class T, std::size_t FirstBlock, class Allocator>
+    template <class... Args>
+    inline typename concurrent_array<T, FirstBlock, Allocator>::iterator concurrent_array<T, FirstBlock, Allocator>::emplace_back(Args &&...args)
+    {
+        return construct_claimed(claim(1), 1, [&](T *slot, size_type)
+                                 { alloc_traits::construct(m_alloc, slot, std::forward<Args>(args)...); });
+    }
+
+    // O(count) - Linear time (lock-free)
+    template <class T, std::size_t FirstBlock, class Allocator>
+    inline typename concurrent_array<T, FirstBlock, Allocator>::iterator concurrent_array<T, FirstBlock, Allocator>::grow_by(size_type count)
+    {
+        return construct_claimed(claim(count), count, [&](T *slot, size_type)
+                                 { alloc_traits::construct(m_alloc, slot); });
+    }
+
+    // O(count) - Linear time (lock-free)
+    template <class T, std::size_t FirstBlock, class Allocator>
+    inline typename concurrent_array<T, FirstBlock, Allocator>::iterator concurrent_array<T, FirstBlock, Allocator>::grow_by(size_type count, const T &value)
+    {
+        return construct_claimed(claim(count), count, [&](T *slot, size_type)
+                                 { alloc_traits::construct(m_alloc, slot, value); });
+    }
+
+    // O(1) - Constant time
+    template <class T, std::size_t FirstBlock, class Allocator>
+    inline const T &concurrent_array<T, FirstBlock, Allocator>::operator[](size_type index) const
+    {
+        detail::check_subscript(index, m_claimed.load(std::memory_order_acquire)); // Policy selected by DS_BOUNDS_CHECK
+
+        return *locate(index);
+    }
+
+    // O(1) - Constant time
+    template <class T, std::size_t FirstBlock, class Allocator>
+    inline T &concurrent_array<T, FirstBlock, Allocator>::operator[](size_type index)
+    {
+        detail::check_subscript(index, m_claimed.load(std::memory_order_acquire));
+
+        return *locate(index);
+    }
+
+    // O(1) - Constant time
+    template <class T, std::size_t FirstBlock, class Allocator>
+    inline const T &concurrent_array<T, FirstBlock, Allocator>::at(size_type index) const
+    {
+        if (index >= m_claimed.load(std::memory_order_acquire))
+            throw std::out_of_range("Invalid index!");
+
+        return *locate(index);
+    }
+
+    // O(1) - Constant time
+    template <class T, std::size_t FirstBlock, class Allocator>
+    inline T &concurrent_array<T, FirstBlock, Allocator>::at(size_type index)
+    {
+        if (index >= m_claimed.load(std::memory_order_acquire))
+            throw std::out_of_range("Invalid index!");
+
+        return *locate(index);
+    }
+
+    // O(1) - Constant time
+    template <class T, std::size_t FirstBlock, class Allocator>
+    inline const T &concurrent_array<T, FirstBlock, Allocator>::front() const
+    {
+        if (empty())
+            throw std::logic_error("Empty container!");
+
+        return *locate(0);
+    }
+
+    // O(1) - Constant time
+    template <class T, std::size_t FirstBlock, class Allocator>
+    inline T &concurrent_array<T, FirstBlock, Allocator>::front()
+    {
+        if (empty())
+            throw std::logic_error("Empty container!");
+
+        return *locate(0);
+    }
+
+    // O(1) - Constant time
+    template <class T, std::size_t FirstBlock, class Allocator>
+    inline const T &concurrent_array<T, FirstBlock, Allocator>::back() const
+    {
+        const size_type count = size();
+        if (count == 0)
+            throw std::logic_error("Empty container!");
+
+        return *locate(count - 1);
+    }
+
+    // O(1) - Constant time
+    template <class T, std::size_t FirstBlock, class Allocator>
+    inline T &concurrent_array<T, FirstBlock, Allocator>::back()
+    {
+        const size_type count = size();
+        if (count == 0)
+            throw std::logic_error("Empty container!");
+
+        return *locate(count - 1);
+    }
+
+    // O(n) - Linear time
+    template <class T, std::size_t FirstBlock, class Allocator>
+    inline void concurrent_array<T, FirstBlock, Allocator>::clear()
+    {
+        destroy_elements();
+    }
+
+    // O(log n) - Logarithmic time (one allocation per missing block)
+    template <class T, std::size_t FirstBlock, class Allocator>
+    inline void concurrent_array<T, FirstBlock, Allocator>::reserve(size_type new_capacity)
+    {
+        if (new_capacity > max_size())
+            throw std::length_error("Requested capacity exceeds max_size()!");
+
+        ensure_blocks(0, new_capacity);
+    }
+
+    // O(log n) - Logarithmic time
+    template <class T, std::size_t FirstBlock, class Allocator>
+    inline typename concurrent_array<T, FirstBlock, Allocator>::size_type concurrent_array<T, FirstBlock, Allocator>::capacity() const
+    {
+        // Blocks are claimed front to back, the allocated ones form a prefix of the directory
+        size_type blocks = 0;
+        while (blocks < layout::max_blocks && m_directory[blocks].load(std::memory_order_acquire) != nullptr)
+            blocks++;
+
+        return layout::block_start(blocks);
+    }
+
+    // O(1) - Constant time
+    template <class T, std::size_t FirstBlock, class Allocator>
+    inline typename concurrent_array<T, FirstBlock, Allocator>::size_type concurrent_array<T, FirstBlock, Allocator>::max_size() const
+    {
+        // Iterator differences must fit in std::ptrdiff_t
+        const size_type max_elements = std::numeric_limits<std::ptrdiff_t>::max() / sizeof(T);
+        const size_type alloc_max = alloc_traits::max_size(m_alloc);
+
+        return alloc_max < max_elements ? alloc_max : max_elements;
+    }
+
+    ///
+    // Helpers
+
+    // Allocates the missing blocks holding the indices [first, last). Racing threads
+    // both allocate a block, the one that loses the compare-and-swap frees its copy.
+    template <class T, std::size_t FirstBlock, class Allocator>
+    inline void concurrent_array<T, FirstBlock, Allocator>::ensure_blocks(size_type first, size_type last)
+    {
+        if (first >= last)
+            return;
+
+        for (size_type block = layout::block_of(first); block <= layout::block_of(last - 1); block++)
+        {
+            T *current = m_directory[block].load(std::memory_order_acquire);
+            if (current != nullptr)
+                continue;
+
+            // The flags go first - a block in the directory always has its flags
+            const size_type slots = layout::block_size(block);
+            flag *flags = m_ready[block].load(std::memory_order_acquire);
+            if (flags == nullptr)
+            {
+                flag_allocator flag_alloc(m_alloc);
+                flag *fresh = flag_traits::allocate(flag_alloc, slots);
+                for (size_type i = 0; i < slots; i++)
+                    flag_traits::construct(flag_alloc, fresh + i, false);
+
+                if (!m_ready[block].compare_exchange_strong(flags, fresh, std::memory_order_acq_rel, std::memory_order_acquire))
+                    flag_traits::deallocate(flag_alloc, fresh, slots);
+            }
+
+            T *fresh = alloc_traits::allocate(m_alloc, slots);
+            if (!m_directory[block].compare_exchange_strong(current, fresh, std::memory_order_acq_rel, std::memory_order_acquire))
+                alloc_traits::deallocate(m_alloc, fresh, slots);
+        }
+    }
+
+    // Claims count consecutive slots, returns the first. The blocks are allocated before the size
+    // moves, so a failed allocation claims nothing and every claimed slot has its block.
+    template <class T, std::size_t FirstBlock, class Allocator>
+    inline typename concurrent_array<T, FirstBlock, Allocator>::size_type concurrent_array<T, FirstBlock, Allocator>::claim(size_type count)
+    {
+        size_type first = m_claimed.load(std::memory_order_relaxed);
+        do
+        {
+            if (count > max_size() - first)
+                throw std::length_error("Maximum capacity reached!");
+
+            ensure_blocks(first, first + count);
+        } while (!m_claimed.compare_exchange_weak(first, first + count, std::memory_order_acq_rel, std::memory_order_relaxed));
+
+        return first;
+    }
+
+    // Constructs the claimed slots [first, first + count) with construct(slot, i) and publishes them. If a
+    // constructor throws, the slots left are value-initialized and published before the exception propagates.
+    template <class T, std::size_t FirstBlock, class Allocator>
+    template <class Construct>
+    inline typename concurrent_array<T, FirstBlock, Allocator>::iterator concurrent_array<T, FirstBlock, Allocator>::construct_claimed(size_type first, size_type count, Construct construct)
+    {
+        size_type done = 0;
+        try
+        {
+            for (; done < count; done++)
+                construct(locate(first + done), done);
+        }
+        catch (...)
+        {
+            for (; done < count; done++)
+                alloc_traits::construct(m_alloc, locate(first + done));
+            publish(first, count);
+            throw;
+        }
+
+        publish(first, count);
+        return iterator(this, first);
+    }
+
+    // Marks the constructed slots [first, first + count) ready and advances the published prefix over every
+    // ready slot behind it. The flag stores and the loads of the prefix are sequentially consistent: either
+    // this thread sees the prefix reach its slots, or the thread which moved it there sees their flags.
+    template <class T, std::size_t FirstBlock, class Allocator>
+    inline void concurrent_array<T, FirstBlock, Allocator>::publish(size_type first, size_type count) noexcept
+    {
+        for (size_type i = 0; i < count; i++)
+            ready(first + i).store(true, std::memory_order_seq_cst);
+
+        size_type published = m_size.load(std::memory_order_seq_cst);
+        for (;;)
+        {
+            const size_type claimed = m_claimed.load(std::memory_order_acquire);
+            size_type next = published;
+            while (next < claimed && ready(next).load(std::memory_order_seq_cst))
+                next++;
+
+            if (next == published)
+                return; // The first slot behind the prefix is still under construction - its owner moves on
+
+            // On failure published holds the prefix another thread advanced to, scan again from there
+            if (m_size.compare_exchange_weak(published, next, std::memory_order_seq_cst, std::memory_order_seq_cst))
+                published = next;
+        }
+    }
+
+    // Destroys the elements block by block
+    template <class T, std::size_t FirstBlock, class Allocator>
+    inline void concurrent_array<T, FirstBlock, Allocator>::destroy_elements() noexcept
+    {
+        // Exclusive access - every claimed slot is constructed
+        const size_type count = m_claimed.load(std::memory_order_acquire);
+
+        for (size_type block = 0; layout::block_start(block) < count; block++)
+        {
+            T *data = m_directory[block].load(std::memory_order_relaxed);
+            flag *flags = m_ready[block].load(std::memory_order_relaxed);
+            const size_type in_block = std::min(layout::block_size(block), count - layout::block_start(block));
+            detail::destroy_range(m_alloc, data, data + in_block);
+
+            for (size_type i = 0; i < in_block; i++)
+                flags[i].store(false, std::memory_order_relaxed); // The blocks are reused
+        }
+
+        m_claimed.store(0, std::memory_order_relaxed);
+        m_size.store(0, std::memory_order_release);
+    }
+
+    // Destroys the elements and deallocates every block
+    template <class T, std::size_t FirstBlock, class Allocator>
+    inline void concurrent_array<T, FirstBlock, Allocator>::release() noexcept
+    {
+        destroy_elements();
+
+        flag_allocator flag_alloc(m_alloc);
+        for (size_type block = 0; block < layout::max_blocks; block++)
+        {
+            T *data = m_directory[block].exchange(nullptr, std::memory_order_relaxed);
+            if (data != nullptr)
+                alloc_traits::deallocate(m_alloc, data, layout::block_size(block));
+
+            // A block which lost its compare-and-swap may leave flags without elements
+            flag *flags = m_ready[block].exchange(nullptr, std::memory_order_relaxed);
+            if (flags != nullptr)
+            {
+                detail::destroy_range(flag_alloc, flags, flags + layout::block_size(block));
+                flag_traits::deallocate(flag_alloc, flags, layout::block_size(block));
+            }
+        }
+    }
+
+    // Takes over the blocks of src, src is left empty with no storage. Requires exclusive access to both.
+    template <class T, std::size_t FirstBlock, class Allocator>
+    inline void concurrent_array<T, FirstBlock, Allocator>::steal(concurrent_array &src) noexcept
+    {
+        for (size_type block = 0; block < layout::max_blocks; block++)
+        {
+            m_directory[block].store(src.m_directory[block].exchange(nullptr, std::memory_order_relaxed), std::memory_order_relaxed);
+            m_ready[block].store(src.m_ready[block].exchange(nullptr, std::memory_order_relaxed), std::memory_order_relaxed);
+        }
+
+        m_claimed.store(src.m_claimed.exchange(0, std::memory_order_relaxed), std::memory_order_relaxed);
+        m_size.store(src.m_size.exchange(0, std::memory_order_relaxed), std::memory_order_release);
+    }
+
+} // namespace ds
+
+#endif // CONCURRENT_ARRAY_GUARD
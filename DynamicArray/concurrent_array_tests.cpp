@@ -0,0 +1,259 @@
+#define CATCH_CONFIG_MAIN
+#include "../Catch2/catch.hpp"
+#include "concurrent_array.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <memory_resource>
+#include <numeric>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace ds;
+
+// Throws on construction from a negative value
+struct Picky
+{
+    Picky() noexcept = default;
+    Picky(int value) : value(value)
+    {
+        if (value < 0)
+            throw std::runtime_error("negative");
+    }
+
+    int value = 0;
+};
+
+TEST_CASE("CONSTRUCTORS", "[CONSTRUCTOR]")
+{
+    concurrent_array<int> def;
+
+    REQUIRE(def.size() == 0);
+    REQUIRE(def.empty());
+    REQUIRE(def.capacity() == 0);
+    REQUIRE_THROWS(def.at(0));
+    REQUIRE_THROWS(def.back());
+
+    concurrent_array<std::string, 2> foo = {"a", "b", "c"};
+    REQUIRE(foo.size() == 3);
+    REQUIRE(foo.capacity() == 6); // Blocks of 2 and 4
+    REQUIRE(foo.back() == "c");
+
+    concurrent_array<std::string, 2> bar(foo);
+    bar[0] = "z";
+    REQUIRE(foo[0] == "a");
+    REQUIRE(std::equal(foo.begin() + 1, foo.end(), bar.begin() + 1, bar.end()));
+
+    foo = bar;
+    REQUIRE(foo[0] == "z");
+    REQUIRE(foo.size() == 3);
+
+    SECTION("MOVE")
+    {
+        const std::string *first = &bar[0];
+        concurrent_array<std::string, 2> moved(std::move(bar));
+        REQUIRE(&moved[0] == first); // The blocks are taken over
+        REQUIRE(moved.size() == 3);
+        REQUIRE(bar.empty());
+        REQUIRE(bar.capacity() == 0);
+
+        bar.push_back("q"); // The moved-from container is usable again
+        REQUIRE(bar.back() == "q");
+
+        bar = std::move(moved);
+        REQUIRE(&bar[0] == first);
+        REQUIRE(moved.empty());
+    }
+
+    SECTION("ALLOCATOR PROPAGATION")
+    {
+        using pmr_array = concurrent_array<int, 4, std::pmr::polymorphic_allocator<int>>;
+        std::pmr::monotonic_buffer_resource first, second;
+        pmr_array source({1, 2, 3, 4, 5}, &first);
+        pmr_array target(&second);
+
+        // polymorphic_allocator does not propagate - target keeps its resource
+        target = source;
+        REQUIRE(std::equal(target.begin(), target.end(), source.begin(), source.end()));
+        REQUIRE(target.get_allocator().resource() == &second);
+
+        target = std::move(source); // Unequal resources - the elements are moved one by one
+        REQUIRE(target.size() == 5);
+        REQUIRE(target.back() == 5);
+        REQUIRE(target.get_allocator().resource() == &second);
+    }
+}
+
+TEST_CASE("SINGLE THREAD OPERATIONS", "[OPERATIONS]")
+{
+    concurrent_array<int, 4> foo;
+
+    SECTION("PUSH BACK RETURNS THE POSITION")
+    {
+        for (int i = 0; i < 100; i++)
+            REQUIRE(*foo.push_back(i) == i);
+
+        auto it = foo.emplace_back(100);
+        REQUIRE(it - foo.begin() == 100);
+        REQUIRE(foo.size() == 101);
+        REQUIRE(foo.front() == 0);
+        REQUIRE(foo.back() == 100);
+    }
+
+    SECTION("GROW BY")
+    {
+        foo.push_back(1);
+        auto it = foo.grow_by(50, 7);
+
+        REQUIRE(it - foo.begin() == 1);
+        REQUIRE(foo.size() == 51);
+        REQUIRE(std::all_of(it, foo.end(), [](int el)
+                            { return el == 7; }));
+
+        foo.grow_by(3);
+        REQUIRE(foo[53] == 0);
+        REQUIRE(foo.grow_by(0) == foo.end());
+    }
+
+    SECTION("ADDRESSES ARE STABLE WHILE GROWING")
+    {
+        int *first = &*foo.push_back(42);
+        for (int i = 0; i < 10000; i++)
+            foo.push_back(i);
+
+        REQUIRE(first == &foo[0]);
+        REQUIRE(*first == 42);
+    }
+
+    SECTION("RESERVE AND CLEAR")
+    {
+        foo.reserve(100);
+        const std::size_t capacity = foo.capacity();
+        REQUIRE(capacity >= 100);
+
+        foo.grow_by(100);
+        REQUIRE(foo.capacity() == capacity);
+
+        foo.clear();
+        REQUIRE(foo.empty());
+        REQUIRE(foo.capacity() == capacity);
+        REQUIRE_THROWS_AS(foo.reserve(foo.max_size() + 1), std::length_error);
+    }
+
+    SECTION("FAILED CONSTRUCTION LEAVES A VALUE-INITIALIZED SLOT")
+    {
+        concurrent_array<Picky> bar;
+        bar.push_back(1);
+
+        REQUIRE_THROWS(bar.emplace_back(-1));
+        REQUIRE(bar.size() == 2);
+        REQUIRE(bar[1].value == 0);
+    }
+}
+
+TEST_CASE("CONCURRENT OPERATIONS", "[CONCURRENCY]")
+{
+    const int THREADS = 4;
+    const int PER_THREAD = 20000;
+
+    SECTION("PUSH BACK FROM MANY THREADS")
+    {
+        concurrent_array<int> foo;
+
+        std::vector<std::thread> threads;
+        for (int t = 0; t < THREADS; t++)
+            threads.emplace_back([&foo, t]
+                                 {
+                                     for (int i = 0; i < PER_THREAD; i++)
+                                         foo.push_back(t * PER_THREAD + i); });
+        for (std::thread &thread : threads)
+            thread.join();
+
+        REQUIRE(foo.size() == THREADS * PER_THREAD);
+
+        std::vector<int> values(foo.begin(), foo.end());
+        std::sort(values.begin(), values.end());
+        std::vector<int> expected(THREADS * PER_THREAD);
+        std::iota(expected.begin(), expected.end(), 0);
+        REQUIRE(values == expected);
+    }
+
+    SECTION("GROW BY KEEPS EACH BATCH CONSECUTIVE")
+    {
+        concurrent_array<std::string> foo;
+
+        std::vector<std::thread> threads;
+        for (int t = 0; t < THREADS; t++)
+            threads.emplace_back([&foo, t]
+                                 {
+                                     for (int i = 0; i < 100; i++)
+                                         foo.grow_by(10, std::to_string(t)); });
+        for (std::thread &thread : threads)
+            thread.join();
+
+        REQUIRE(foo.size() == THREADS * 100 * 10);
+
+        bool consecutive = true;
+        for (std::size_t i = 0; i < foo.size(); i += 10)
+            consecutive = consecutive && std::all_of(foo.begin() + i, foo.begin() + i + 10, [&](const std::string &el)
+                                                     { return el == foo[i]; });
+        REQUIRE(consecutive);
+    }
+
+    SECTION("READERS SEE PUBLISHED ELEMENTS")
+    {
+        concurrent_array<int> foo;
+        std::atomic<std::size_t> published{0};
+
+        std::thread writer([&]
+                           {
+                               for (int i = 0; i < PER_THREAD; i++)
+                               {
+                                   foo.push_back(i);
+                                   published.store(i + 1, std::memory_order_release);
+                               } });
+
+        bool valid = true;
+        std::size_t seen = 0;
+        while (seen < PER_THREAD)
+        {
+            seen = published.load(std::memory_order_acquire);
+            if (seen > 0)
+                valid = valid && foo[seen - 1] == int(seen - 1);
+        }
+        writer.join();
+
+        REQUIRE(valid);
+    }
+
+    SECTION("SIZE COUNTS CONSTRUCTED ELEMENTS ONLY")
+    {
+        concurrent_array<std::string> foo;
+        const std::string value(64, 'x'); // Heap allocated - construction takes a while
+
+        std::vector<std::thread> writers;
+        for (int t = 0; t < THREADS; t++)
+            writers.emplace_back([&]
+                                 {
+                                     for (int i = 0; i < PER_THREAD; i++)
+                                         foo.push_back(value); });
+
+        // No external synchronization - everything below size() has to be complete
+        bool valid = true;
+        std::size_t seen = 0;
+        while (seen < std::size_t(THREADS) * PER_THREAD)
+        {
+            seen = foo.size();
+            if (seen > 0)
+                valid = valid && foo[seen - 1] == value && std::all_of(foo.begin() + (seen - 1) / 2, foo.begin() + seen, [&](const std::string &el)
+                                                                       { return el == value; });
+        }
+
+        for (auto &writer : writers)
+            writer.join();
+
+        REQUIRE(valid);
+        REQUIRE(foo.size() == std::size_t(THREADS) * PER_THREAD);
+    }
+}
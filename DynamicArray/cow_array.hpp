@@ -0,0 +1,349 @@
+#ifndef COW_ARRAY_GUARD
+#define COW_ARRAY_GUARD
+
+/*
+ *  Copy-on-write dynamic array: copies share one reference-counted
+ *  dynamic_array, the first mutation through a shared copy detaches it
+ *  with a deep copy. Handing out read-only snapshots is O(1).
+ *
+ *  The reference count is atomic, so copies of the same buffer may be read,
+ *  modified (each detaches on its own) and destroyed from different threads.
+ *  A single cow_array object is not synchronized, like any other container.
+ *
+ *  Every non-const access may detach - read through view(), a const
+ *  reference or std::as_const to keep sharing.
+ *  A moved-from array owns no buffer: it reads as empty and allocates a new
+ *  one with a default constructed allocator on its first write.
+ *  References, pointers and iterators obtained through non-const access
+ *  point into a buffer this array owns alone at that moment - they must not
+ *  be used to write once the array has been copied again.
+*/
+
+#include "dynamic_array.hpp" // Shared buffer
+
+#include <atomic>  // Reference count
+#include <cstddef> // std::size_t
+#include <memory>  // std::allocator_traits
+#include <utility> // std::move
+
+namespace ds
+{
+    template <class T, class Allocator = detail::default_allocator<T>, class GrowthPolicy = growth::doubling>
+    class cow_array
+    {
+    public:
+        using array_type = dynamic_array<T, Allocator, GrowthPolicy>;
+
+        using value_type = T;
+        using allocator_type = Allocator;
+        using size_type = std::size_t;
+        using difference_type = std::ptrdiff_t;
+        using reference = T &;
+        using const_reference = const T &;
+        using iterator = typename array_type::iterator;
+        using const_iterator = typename array_type::const_iterator;
+
+        static constexpr size_type npos = array_type::npos;
+
+        // Constructors, Destructors; Gang of Four
+
+        // Constructs an empty container with selected or default initial capacity
+        explicit cow_array(size_type capacity = INIT_CAPACITY, const Allocator &alloc = Allocator());
+
+        // Constructs a container with a copy of each of the elements in il, in the same order.
+        cow_array(const std::initializer_list<T> &i_list, const Allocator &alloc = Allocator());
+
+        // Deep copy of arr - the last copy ever made of these elements
+        explicit cow_array(const array_type &arr);
+
+        // Takes over the buffer of arr, which is left empty with no storage
+        explicit cow_array(array_type &&arr);
+
+        // O(1) - Shares the buffer of other
+        cow_array(const cow_array &other) noexcept;
+
+        // O(1) - Takes over the buffer of other, the count of owners does not change
+        cow_array(cow_array &&other) noexcept;
+
+        // Copy assignment operator (copy-and-swap idiom) - shares the buffer of other
+        cow_array &operator=(const cow_array &other) noexcept;
+
+        // Move assignment operator - takes over the buffer of other
+        cow_array &operator=(cow_array &&other) noexcept;
+
+        // Destructor - the last owner destroys the buffer
+        ~cow_array();
+
+        ///
+        // Read operations - never copy
+
+        // The shared elements
+        const array_type &view() const noexcept { return m_block ? m_block->array : empty_array(); }
+
+        const T &operator[](size_type index) const { return view()[index]; }
+        const T &at(size_type index) const { return view().at(index); }
+        const T &front() const { return view().front(); }
+        const T &back() const { return view().back(); }
+        const T *data() const noexcept { return view().data(); }
+
+        const_iterator begin() const noexcept { return view().begin(); }
+        const_iterator end() const noexcept { return view().end(); }
+        const_iterator cbegin() const noexcept { return view().cbegin(); }
+        const_iterator cend() const noexcept { return view().cend(); }
+
+        size_type size() const { return view().size(); }
+        size_type capacity() const { return view().capacity(); }
+        bool empty() const { return view().empty(); }
+        allocator_type get_allocator() const { return view().get_allocator(); }
+
+        size_type find(const T &value) const { return view().find(value); }
+        size_type count(const T &value) const { return view().count(value); }
+        bool contains(const T &value) const { return view().contains(value); }
+
+        bool operator==(const cow_array &other) const { return m_block == other.m_block || view() == other.view(); }
+
+        // Number of cow_arrays sharing the buffer (a snapshot when other threads hold copies)
+        size_type use_count() const noexcept { return m_block ? m_block->refs.load(std::memory_order_acquire) : 0; }
+        bool is_shared() const noexcept { return use_count() > 1; }
+
+        ///
+        // Write operations - detach a shared buffer first
+
+        // The elements, owned by this array alone - for any dynamic_array operation
+        array_type &edit();
+
+        // Gives this array its own copy of a shared buffer
+        void detach();
+
+        T &operator[](size_type index) { return edit()[index]; }
+        T &at(size_type index) { return edit().at(index); }
+        T &front() { return edit().front(); }
+        T &back() { return edit().back(); }
+        T *data() { return edit().data(); }
+
+        iterator begin() { return edit().begin(); }
+        iterator end() { return edit().end(); }
+
+        void push_back(const T &el) { edit().push_back(el); }
+        void push_back(T &&el) { edit().push_back(std::move(el)); }
+
+        template <class... Args>
+        T &emplace_back(Args &&...args) { return edit().emplace_back(std::forward<Args>(args)...); }
+
+        void insert(size_type position, const T &val) { edit().insert(position, val); }
+        void insert(size_type position, T &&val) { edit().insert(position, std::move(val)); }
+        void pop_back() { edit().pop_back(); }
+        void erase(size_type position) { edit().erase(position); }
+        void erase(size_type first, size_type last) { edit().erase(first, last); }
+
+        template <class Predicate>
+        size_type erase_if(Predicate pred) { return edit().erase_if(pred); }
+
+        size_type remove(const T &value) { return edit().remove(value); }
+
+        void reserve(size_type new_capacity) { edit().reserve(new_capacity); }
+        void shrink_to_fit() { edit().shrink_to_fit(); }
+
+        // Destroys all elements - a shared buffer is left to its other owners, nothing is copied
+        void clear();
+
+    private:
+        // The shared state - the count of owners next to the elements. The block keeps the allocator
+        // it was allocated with, the one of the array may be replaced through edit().
+        struct shared_block
+        {
+            template <class... Args>
+            explicit shared_block(const Allocator &alloc, Args &&...args) : alloc(alloc), array(std::forward<Args>(args)...) {}
+
+            Allocator alloc;
+            std::atomic<size_type> refs{1};
+            array_type array;
+        };
+
+        using block_alloc = typename std::allocator_traits<Allocator>::template rebind_alloc<shared_block>;
+        using block_traits = std::allocator_traits<block_alloc>;
+
+        shared_block *m_block; // nullptr once moved from
+
+        ///
+        // Helpers
+    private:
+        template <class... Args>
+        static shared_block *make_block(const Allocator &alloc, Args &&...args);
+
+        static void release(shared_block *block) noexcept;
+
+        // What a moved-from array reads as
+        static const array_type &empty_array();
+    };
+
+    // O(1) - Constant time
+    template <class T, class Allocator, class GrowthPolicy>
+    inline cow_array<T, Allocator, GrowthPolicy>::cow_array(size_type capacity, const Allocator &alloc)
+        : m_block(make_block(alloc, capacity, alloc))
+    {
+    }
+
+    // O(n) - Linear time
+    template <class T, class Allocator, class GrowthPolicy>
+    inline cow_array<T, Allocator, GrowthPolicy>::cow_array(const std::initializer_list<T> &i_list, const Allocator &alloc)
+        : m_block(make_block(alloc, i_list, alloc))
+    {
+    }
+
+    // O(n) - Linear time
+    template <class T, class Allocator, class GrowthPolicy>
+    inline cow_array<T, Allocator, GrowthPolicy>::cow_array(const array_type &arr)
+        : m_block(make_block(arr.get_allocator(), arr))
+    {
+    }
+
+    // O(1) - Constant time
+    template <class T, class Allocator, class GrowthPolicy>
+    inline cow_array<T, Allocator, GrowthPolicy>::cow_array(array_type &&arr)
+        : m_block(make_block(arr.get_allocator(), std::move(arr)))
+    {
+    }
+
+    // O(1) - Constant time
+    template <class T, class Allocator, class GrowthPolicy>
+    inline cow_array<T, Allocator, GrowthPolicy>::cow_array(const cow_array &other) noexcept
+        : m_block(other.m_block)
+    {
+        // A new owner only needs the count to go up; the buffer is published by the copied object
+        if (m_block)
+            m_block->refs.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    // O(1) - Constant time
+    template <class T, class Allocator, class GrowthPolicy>
+    inline cow_array<T, Allocator, GrowthPolicy>::cow_array(cow_array &&other) noexcept
+        : m_block(other.m_block)
+    {
+        other.m_block = nullptr;
+    }
+
+    // O(1) - Constant time
+    template <class T, class Allocator, class GrowthPolicy>
+    inline cow_array<T, Allocator, GrowthPolicy> &cow_array<T, Allocator, GrowthPolicy>::operator=(const cow_array &other) noexcept
+    {
+        cow_array copy(other);
+        std::swap(m_block, copy.m_block);
+        return *this;
+    }
+
+    // O(1) - Constant time, O(n) if this was the last owner of its buffer
+    template <class T, class Allocator, class GrowthPolicy>
+    inline cow_array<T, Allocator, GrowthPolicy> &cow_array<T, Allocator, GrowthPolicy>::operator=(cow_array &&other) noexcept
+    {
+        if (this != &other)
+        {
+            release(m_block);
+            m_block = other.m_block;
+            other.m_block = nullptr;
+        }
+
+        return *this;
+    }
+
+    // O(1) - Constant time, O(n) for the last owner
+    template <class T, class Allocator, class GrowthPolicy>
+    inline cow_array<T, Allocator, GrowthPolicy>::~cow_array()
+    {
+        release(m_block);
+    }
+
+    // O(1) - Constant time, O(n) when the buffer is shared
+    template <class T, class Allocator, class GrowthPolicy>
+    inline typename cow_array<T, Allocator, GrowthPolicy>::array_type &cow_array<T, Allocator, GrowthPolicy>::edit()
+    {
+        detach();
+        return m_block->array;
+    }
+
+    // O(1) - Constant time, O(n) when the buffer is shared
+    template <class T, class Allocator, class GrowthPolicy>
+    inline void cow_array<T, Allocator, GrowthPolicy>::detach()
+    {
+        if (!m_block)
+        {
+            // Moved from - a new buffer of our own
+            m_block = make_block(Allocator(), INIT_CAPACITY, Allocator());
+            return;
+        }
+
+        // Acquire pairs with the release of the other owners - their last reads happen before our writes
+        if (m_block->refs.load(std::memory_order_acquire) == 1)
+            return;
+
+        shared_block *copy = make_block(m_block->array.get_allocator(), m_block->array);
+        release(m_block);
+        m_block = copy;
+    }
+
+    // O(n) - Linear time
+    template <class T, class Allocator, class GrowthPolicy>
+    inline void cow_array<T, Allocator, GrowthPolicy>::clear()
+    {
+        if (!m_block)
+            return; // Empty already
+
+        if (m_block->refs.load(std::memory_order_acquire) == 1)
+        {
+            m_block->array.clear();
+            return;
+        }
+
+        const Allocator alloc = m_block->array.get_allocator();
+        shared_block *empty = make_block(alloc, INIT_CAPACITY, alloc);
+        release(m_block);
+        m_block = empty;
+    }
+
+    ///
+    // Helpers
+
+    // Allocates a block owned by one array, its elements constructed from args
+    template <class T, class Allocator, class GrowthPolicy>
+    template <class... Args>
+    inline typename cow_array<T, Allocator, GrowthPolicy>::shared_block *cow_array<T, Allocator, GrowthPolicy>::make_block(const Allocator &alloc, Args &&...args)
+    {
+        block_alloc balloc(alloc);
+        shared_block *block = block_traits::allocate(balloc, 1);
+
+        try
+        {
+            block_traits::construct(balloc, block, alloc, std::forward<Args>(args)...);
+        }
+        catch (...)
+        {
+            block_traits::deallocate(balloc, block, 1);
+            throw;
+        }
+
+        return block;
+    }
+
+    // Drops one owner of block, the last one destroys it
+    template <class T, class Allocator, class GrowthPolicy>
+    inline void cow_array<T, Allocator, GrowthPolicy>::release(shared_block *block) noexcept
+    {
+        if (!block || block->refs.fetch_sub(1, std::memory_order_acq_rel) != 1)
+            return;
+
+        // The allocator which allocated the block - it outlives the block it frees
+        block_alloc balloc(block->alloc);
+        block_traits::destroy(balloc, block);
+        block_traits::deallocate(balloc, block, 1);
+    }
+
+    template <class T, class Allocator, class GrowthPolicy>
+    inline const typename cow_array<T, Allocator, GrowthPolicy>::array_type &cow_array<T, Allocator, GrowthPolicy>::empty_array()
+    {
+        static const array_type empty;
+        return empty;
+    }
+
+} // namespace ds
+
+#endif // COW_ARRAY_GUARD
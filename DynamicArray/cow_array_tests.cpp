@@ -0,0 +1,241 @@
+#define CATCH_CONFIG_MAIN
+#include "../Catch2/catch.hpp"
+#include "cow_array.hpp"
+
+#include <algorithm>
+#include <numeric>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+using namespace ds;
+
+namespace
+{
+    // Counts the live allocations of each tag - copy assignment hands the tag over
+    template <class T>
+    struct tagged_allocator
+    {
+        using value_type = T;
+        using propagate_on_container_copy_assignment = std::true_type;
+
+        static inline int live[2] = {0, 0};
+
+        int tag = 0;
+
+        tagged_allocator() = default;
+        explicit tagged_allocator(int tag) : tag(tag) {}
+
+        template <class U>
+        tagged_allocator(const tagged_allocator<U> &other) : tag(other.tag) {}
+
+        T *allocate(std::size_t n)
+        {
+            ++tagged_allocator<char>::live[tag];
+            return std::allocator<T>().allocate(n);
+        }
+
+        void deallocate(T *p, std::size_t n)
+        {
+            --tagged_allocator<char>::live[tag];
+            std::allocator<T>().deallocate(p, n);
+        }
+
+        template <class U>
+        bool operator==(const tagged_allocator<U> &other) const { return tag == other.tag; }
+
+        template <class U>
+        bool operator!=(const tagged_allocator<U> &other) const { return tag != other.tag; }
+    };
+}
+
+TEST_CASE("CONSTRUCTORS", "[CONSTRUCTOR]")
+{
+    cow_array<int> def;
+
+    REQUIRE(def.size() == 0);
+    REQUIRE(def.empty());
+    REQUIRE(def.capacity() == INIT_CAPACITY);
+    REQUIRE(def.use_count() == 1);
+    REQUIRE_THROWS(def.at(0));
+
+    cow_array<std::string> foo = {"a", "b", "c"};
+    REQUIRE(foo.size() == 3);
+    REQUIRE(foo[2] == "c");
+
+    dynamic_array<int> arr = {1, 2, 3};
+    const int *buffer = arr.data();
+
+    cow_array<int> copied(arr);
+    REQUIRE(copied.view() == arr);
+    REQUIRE(std::as_const(copied).data() != buffer);
+
+    cow_array<int> taken(std::move(arr));
+    REQUIRE(std::as_const(taken).data() == buffer);
+    REQUIRE(arr.empty());
+    REQUIRE(arr.capacity() == 0); // No replacement buffer is allocated
+}
+
+TEST_CASE("SHARING", "[COPY ON WRITE]")
+{
+    cow_array<std::string> foo = {"a", "b", "c"};
+    const std::string *buffer = std::as_const(foo).data();
+
+    SECTION("COPIES SHARE THE BUFFER")
+    {
+        cow_array<std::string> bar(foo);
+        cow_array<std::string> baz;
+        baz = bar;
+
+        REQUIRE(foo.use_count() == 3);
+        REQUIRE(bar.is_shared());
+        REQUIRE(std::as_const(bar).data() == buffer);
+        REQUIRE(baz.view().data() == buffer);
+        REQUIRE(baz == foo);
+    }
+
+    SECTION("FIRST WRITE DETACHES")
+    {
+        cow_array<std::string> bar(foo);
+
+        bar.push_back("d");
+        REQUIRE(std::as_const(bar).data() != buffer);
+        REQUIRE(std::as_const(foo).data() == buffer);
+        REQUIRE(foo.size() == 3);
+        REQUIRE(bar.size() == 4);
+        REQUIRE_FALSE(foo.is_shared());
+        REQUIRE_FALSE(bar.is_shared());
+
+        // The owner alone writes in place
+        bar[0] = "z";
+        bar.erase(1);
+        REQUIRE(bar.view() == dynamic_array<std::string>({"z", "c", "d"}));
+        REQUIRE(foo[0] == "a");
+        REQUIRE(std::as_const(foo).data() == buffer);
+    }
+
+    SECTION("READS DO NOT DETACH")
+    {
+        const cow_array<std::string> bar(foo);
+
+        REQUIRE(bar[1] == "b");
+        REQUIRE(bar.front() == "a");
+        REQUIRE(bar.find("c") == 2);
+        REQUIRE(std::accumulate(bar.begin(), bar.end(), std::string()) == "abc");
+        REQUIRE(bar.is_shared());
+    }
+
+    SECTION("CLEAR LEAVES THE SHARED BUFFER ALONE")
+    {
+        cow_array<std::string> bar(foo);
+
+        bar.clear();
+        REQUIRE(bar.empty());
+        REQUIRE(foo.size() == 3);
+        REQUIRE(std::as_const(foo).data() == buffer);
+
+        foo.clear();
+        REQUIRE(foo.empty());
+    }
+
+    SECTION("EDIT GIVES THE WHOLE ARRAY")
+    {
+        cow_array<std::string> bar(foo);
+
+        bar.edit().insert(1, std::size_t(2), std::string("x"));
+        REQUIRE(bar.size() == 5);
+        REQUIRE(bar.remove("x") == 2);
+        REQUIRE(bar == foo);
+        REQUIRE_FALSE(bar.is_shared());
+    }
+
+    SECTION("MOVES TAKE THE BUFFER")
+    {
+        cow_array<std::string> bar(foo);
+        cow_array<std::string> baz(std::move(bar));
+
+        REQUIRE(foo.use_count() == 2);
+        REQUIRE(baz.view().data() == buffer);
+
+        cow_array<std::string> qux;
+        qux = std::move(baz);
+        REQUIRE(foo.use_count() == 2);
+        REQUIRE(qux.view().data() == buffer);
+
+        qux = std::move(foo);
+        REQUIRE(qux.use_count() == 1);
+        REQUIRE(std::as_const(qux).data() == buffer);
+
+        // Moved from arrays read as empty and stay usable
+        REQUIRE(foo.empty());
+        REQUIRE(bar.size() == 0);
+        REQUIRE(baz.use_count() == 0);
+        REQUIRE_FALSE(baz.is_shared());
+        REQUIRE(std::as_const(bar).begin() == std::as_const(bar).end());
+
+        bar.push_back("d");
+        REQUIRE(bar.view() == dynamic_array<std::string>({"d"}));
+        REQUIRE(bar.use_count() == 1);
+
+        baz = qux;
+        REQUIRE(qux.use_count() == 2);
+        foo.clear();
+        REQUIRE(foo.empty());
+        foo = cow_array<std::string>(foo);
+        REQUIRE(foo.empty());
+    }
+}
+
+TEST_CASE("BLOCK ALLOCATOR", "[ALLOCATOR]")
+{
+    using alloc = tagged_allocator<int>;
+    int *live = tagged_allocator<char>::live;
+
+    {
+        cow_array<int, alloc> foo({1, 2, 3}, alloc(0));
+        const dynamic_array<int, alloc> other({4, 5}, alloc(1));
+
+        // The array now allocates with tag 1, the block itself was allocated with tag 0
+        foo.edit() = other;
+        REQUIRE(foo.get_allocator().tag == 1);
+        REQUIRE(foo.view() == other);
+    }
+
+    REQUIRE(live[0] == 0);
+    REQUIRE(live[1] == 0);
+}
+
+TEST_CASE("SNAPSHOTS ACROSS THREADS", "[CONCURRENCY]")
+{
+    cow_array<int> config;
+    for (int i = 0; i < 10000; i++)
+        config.push_back(i);
+
+    const long long expected = 9999LL * 10000 / 2;
+    std::vector<long long> sums(8);
+    std::vector<std::thread> workers;
+
+    for (std::size_t t = 0; t < sums.size(); t++)
+    {
+        workers.emplace_back([snapshot = config, &sums, t]() mutable
+                             {
+                                 sums[t] = std::accumulate(snapshot.cbegin(), snapshot.cend(), 0LL);
+
+                                 // Odd workers change their own copy
+                                 if (t % 2)
+                                 {
+                                     snapshot.push_back(1);
+                                     sums[t] -= snapshot.back();
+                                 } });
+    }
+
+    config.pop_back(); // Detaches while the workers read
+    for (std::thread &worker : workers)
+        worker.join();
+
+    REQUIRE(std::all_of(sums.begin(), sums.end(), [&](long long sum)
+                        { return sum == expected || sum == expected - 1; }));
+    REQUIRE(config.size() == 9999);
+    REQUIRE_FALSE(config.is_shared());
+}
@@ -1,6 +1,7 @@
 #define CATCH_CONFIG_MAIN
 #include "../Catch2/catch.hpp"
 #include "dynamic_array.hpp"
+#include "mmap_allocator.hpp"
 
 using namespace ds;
 
@@ -95,6 +96,47 @@ TEST_CASE("CONSTRUCTORS_DESTRUCTOR", "[CONSTRUCTOR][DESTRUCTOR]")
         REQUIRE(bar.capacity() == foo.capacity());
         REQUIRE(bar.at(0) == foo.at(0));
     }
+
+    SECTION("MOVE CONSTRUCTOR AND MOVE OPERATOR=")
+    {
+        STATIC_REQUIRE(std::is_nothrow_move_constructible_v<dynamic_array<int>>);
+        STATIC_REQUIRE(std::is_nothrow_move_assignable_v<dynamic_array<int>>);
+
+        dynamic_array<int> foo = {1, 2, 3};
+        const int *storage = foo.data();
+
+        dynamic_array<int> bar(std::move(foo));
+        REQUIRE(bar.data() == storage); // The buffer changes hands, nothing is copied
+        REQUIRE(bar == dynamic_array<int>({1, 2, 3}));
+        REQUIRE(foo.size() == 0);
+        REQUIRE(foo.capacity() == 0);
+
+        // A moved-from array is reusable
+        foo.push_back(7);
+        REQUIRE(foo.size() == 1);
+        REQUIRE(foo[0] == 7);
+
+        foo = std::move(bar);
+        REQUIRE(foo.data() == storage);
+        REQUIRE(foo.size() == 3);
+        REQUIRE(bar.empty());
+
+        dynamic_array<int> baz(bar); // Copy of a moved-from array
+        REQUIRE(baz.empty());
+    }
+
+    SECTION("NESTED ARRAYS ARE MOVED ON GROWTH")
+    {
+        dynamic_array<dynamic_array<int>> foo(1);
+        foo.push_back(dynamic_array<int>({1, 2}));
+        const int *storage = foo[0].data();
+
+        for (int i = 0; i < 100; i++)
+            foo.emplace_back(1);
+
+        REQUIRE(foo[0].data() == storage);
+        REQUIRE(foo[0] == dynamic_array<int>({1, 2}));
+    }
 }
 
 TEST_CASE("DEFAULT OPERATIONS", "[OPERATIONS]")
@@ -228,4 +270,766 @@ TEST_CASE("ITERATOR", "[ITERATOR]")
 
         REQUIRE(EQUAL_FLAG);
     }
+
+    SECTION("RANDOM ACCESS ARITHMETIC")
+    {
+        dynamic_array<int> vec = {10, 20, 30, 40, 50};
+        dynamic_array<int>::iterator it = vec.begin();
+
+        static_assert(std::is_same_v<std::iterator_traits<dynamic_array<int>::iterator>::iterator_category,
+                                     std::random_access_iterator_tag>);
+
+        REQUIRE(vec.end() - vec.begin() == 5);
+        REQUIRE(*(it + 2) == 30);
+        REQUIRE(*(3 + it) == 40);
+        REQUIRE(it[4] == 50);
+
+        it += 4;
+        it -= 1;
+        REQUIRE(*it == 40);
+        REQUIRE(*(it - 3) == 10);
+        REQUIRE(vec.begin() < it);
+        REQUIRE(dynamic_array<int>::iterator() == dynamic_array<int>::iterator());
+    }
+
+    SECTION("CONST ITERATOR AND DATA")
+    {
+        dynamic_array<int> vec = {1, 2, 3};
+        const dynamic_array<int> &cref = vec;
+
+        dynamic_array<int>::const_iterator cit = vec.begin(); // iterator -> const_iterator
+        static_assert(std::is_same_v<decltype(*cit), const int &>);
+        static_assert(!std::is_convertible_v<dynamic_array<int>::const_iterator, dynamic_array<int>::iterator>);
+
+        REQUIRE(cit == vec.cbegin());
+        REQUIRE(vec.begin() == cit); // Mixed comparison
+        REQUIRE(cref.end() - cit == 3);
+        REQUIRE(vec.data() == &vec[0]);
+        REQUIRE(cref.data()[2] == 3);
+
+        int sum = 0;
+        for (const int &el : cref)
+            sum += el;
+        REQUIRE(sum == 6);
+    }
+
+    SECTION("REVERSE ITERATORS")
+    {
+        dynamic_array<int> vec = {1, 2, 3, 4};
+        dynamic_array<int> reversed(std::size_t(4));
+
+        reversed.append(vec.rbegin(), vec.rend());
+
+        REQUIRE(reversed == dynamic_array<int>({4, 3, 2, 1}));
+        REQUIRE(*vec.crbegin() == 4);
+        REQUIRE(vec.crend() - vec.crbegin() == 4);
+    }
+
+    SECTION("STANDARD ALGORITHMS")
+    {
+        dynamic_array<int> vec = {5, 1, 4, 2, 3};
+        std::sort(vec.begin(), vec.end());
+        REQUIRE(vec == dynamic_array<int>({1, 2, 3, 4, 5}));
+
+        REQUIRE(std::lower_bound(vec.cbegin(), vec.cend(), 4) - vec.cbegin() == 3);
+        REQUIRE(std::binary_search(vec.begin(), vec.end(), 2));
+
+        dynamic_array<int> copy(vec.size(), 0);
+        std::copy(vec.cbegin(), vec.cend(), copy.begin());
+        REQUIRE(copy == vec);
+
+        std::reverse(copy.begin(), copy.end());
+        REQUIRE(std::is_sorted(copy.rbegin(), copy.rend()));
+
+        // Iterators of another array are copied in one block
+        dynamic_array<int> foo = {0, 9};
+        foo.insert(1, vec.cbegin() + 1, vec.cend() - 1);
+        REQUIRE(foo == dynamic_array<int>({0, 2, 3, 4, 9}));
+    }
+}
+
+// Element type without default ctor which tracks its special member calls
+struct Tracked
+{
+    static int copies, moves, alive;
+
+    explicit Tracked(int value) : value(value) { ++alive; }
+    Tracked(const Tracked &other) : value(other.value) { ++copies, ++alive; }
+    Tracked(Tracked &&other) noexcept : value(other.value) { ++moves, ++alive; }
+    Tracked &operator=(const Tracked &other) = default;
+    Tracked &operator=(Tracked &&other) noexcept = default;
+    ~Tracked() { --alive; }
+
+    bool operator!=(const Tracked &other) const { return value != other.value; }
+
+    static void reset() { copies = moves = alive = 0; }
+
+    int value;
+};
+
+int Tracked::copies = 0;
+int Tracked::moves = 0;
+int Tracked::alive = 0;
+
+TEST_CASE("STORAGE", "[STORAGE]")
+{
+    SECTION("GROWTH MOVES INSTEAD OF COPIES")
+    {
+        const int COUNT = 100;
+        Tracked::reset();
+        {
+            dynamic_array<Tracked> foo(1);
+            for (int i = 0; i < COUNT; i++)
+                foo.push_back(Tracked(i));
+
+            REQUIRE(foo.size() == COUNT);
+            REQUIRE(Tracked::alive == COUNT);
+            REQUIRE(Tracked::copies == 0); // Temporaries are moved in
+            REQUIRE(foo.back().value == COUNT - 1);
+        }
+        REQUIRE(Tracked::alive == 0);
+    }
+
+    SECTION("ONLY LIVE ELEMENTS ARE DESTROYED")
+    {
+        Tracked::reset();
+        {
+            dynamic_array<Tracked> foo(10);
+            foo.push_back(Tracked(1));
+            foo.push_back(Tracked(2));
+            foo.push_back(Tracked(3));
+
+            foo.insert(0, Tracked(0));
+            CHECK(Tracked::alive == 4);
+
+            foo.erase(1);
+            foo.pop_back();
+            REQUIRE(Tracked::alive == 2);
+            REQUIRE(foo[0].value == 0);
+            REQUIRE(foo[1].value == 2);
+        }
+        REQUIRE(Tracked::alive == 0);
+    }
+
+    SECTION("PUSH BACK OF OWN ELEMENT DURING GROWTH")
+    {
+        dynamic_array<std::string> foo(1);
+        foo.push_back("a string long enough to live on the heap");
+
+        foo.push_back(foo[0]);
+
+        REQUIRE(foo.size() == 2);
+        REQUIRE(foo[1] == foo[0]);
+    }
+}
+
+TEST_CASE("TRIVIALLY COPYABLE FAST PATH", "[STORAGE]")
+{
+    SECTION("INSERT, ERASE AND COPY")
+    {
+        const uint64_t COUNT = 1000;
+        dynamic_array<uint64_t> foo(1);
+        for (uint64_t i = 1; i < COUNT; i++)
+            foo.push_back(i);
+
+        foo.insert(0, 0);
+        foo.insert(COUNT / 2, COUNT);
+
+        dynamic_array<uint64_t> bar(foo);
+        REQUIRE(bar == foo);
+
+        bar.erase(COUNT / 2);
+        REQUIRE_FALSE(bar == foo);
+        REQUIRE(bar.size() == COUNT);
+
+        bool EQUAL_FLAG = true;
+        for (uint64_t i = 0; i < COUNT; i++)
+        {
+            if (bar[i] != i)
+            {
+                EQUAL_FLAG = false;
+                break;
+            }
+        }
+
+        REQUIRE(EQUAL_FLAG);
+    }
+
+    SECTION("EQUALITY OF TYPES WITH PADDING")
+    {
+        struct Padded
+        {
+            char c;
+            double d;
+
+            bool operator!=(const Padded &other) const { return c != other.c || d != other.d; }
+        };
+
+        dynamic_array<Padded> foo(2), bar(2);
+        Padded first, second;
+        std::memset(&first, 0x00, sizeof(Padded));
+        std::memset(&second, 0xFF, sizeof(Padded));
+        first.c = second.c = 'a';
+        first.d = second.d = 0.5;
+
+        foo.push_back(first);
+        bar.push_back(second);
+
+        REQUIRE(foo == bar);
+    }
+}
+
+TEST_CASE("ALLOCATOR", "[ALLOCATOR]")
+{
+    SECTION("PMR ARRAY ALLOCATES FROM ITS RESOURCE")
+    {
+        char buffer[1024];
+        std::pmr::monotonic_buffer_resource arena(buffer, sizeof(buffer), std::pmr::null_memory_resource());
+
+        ds::pmr::dynamic_array<int> foo(4, &arena);
+        for (int i = 0; i < 32; i++)
+            foo.push_back(i);
+
+        REQUIRE(foo.size() == 32);
+        REQUIRE(foo.get_allocator().resource() == &arena);
+        REQUIRE(foo.back() == 31);
+    }
+
+    SECTION("PMR ELEMENTS RECEIVE THE ARRAY RESOURCE")
+    {
+        std::pmr::monotonic_buffer_resource arena;
+        ds::pmr::dynamic_array<std::pmr::string> foo(&arena);
+
+        foo.push_back(std::pmr::string("a string long enough to live on the heap"));
+
+        REQUIRE(foo[0].get_allocator().resource() == &arena);
+    }
+
+    SECTION("COPY ASSIGNMENT KEEPS A NON-PROPAGATING ALLOCATOR")
+    {
+        std::pmr::monotonic_buffer_resource first, second;
+        ds::pmr::dynamic_array<int> foo({1, 2, 3}, &first);
+        ds::pmr::dynamic_array<int> bar(&second);
+
+        bar = foo;
+
+        REQUIRE(bar == foo);
+        REQUIRE(bar.get_allocator().resource() == &second);
+
+        // Copy construction selects the default resource
+        ds::pmr::dynamic_array<int> baz(foo);
+        REQUIRE(baz.get_allocator().resource() == std::pmr::get_default_resource());
+    }
+
+    SECTION("MOVE ASSIGNMENT KEEPS A NON-PROPAGATING ALLOCATOR")
+    {
+        std::pmr::monotonic_buffer_resource first, second;
+        ds::pmr::dynamic_array<std::pmr::string> foo(&first);
+        foo.push_back(std::pmr::string("a string long enough to live on the heap"));
+        ds::pmr::dynamic_array<std::pmr::string> bar(&second);
+
+        // Different resources - the elements are moved into storage of the target
+        bar = std::move(foo);
+        REQUIRE(bar.size() == 1);
+        REQUIRE(bar.get_allocator().resource() == &second);
+        REQUIRE(bar[0].get_allocator().resource() == &second);
+        REQUIRE(foo.empty());
+
+        // Same resource - the buffer changes hands
+        ds::pmr::dynamic_array<std::pmr::string> baz(&second);
+        const std::pmr::string *storage = bar.data();
+        baz = std::move(bar);
+        REQUIRE(baz.data() == storage);
+
+        // Move construction takes the resource along
+        ds::pmr::dynamic_array<std::pmr::string> qux(std::move(baz));
+        REQUIRE(qux.get_allocator().resource() == &second);
+        REQUIRE(qux[0] == "a string long enough to live on the heap");
+    }
+}
+
+TEST_CASE("EMPLACE AND RVALUE INSERTION", "[OPERATIONS]")
+{
+    SECTION("EMPLACE BACK CONSTRUCTS IN PLACE")
+    {
+        Tracked::reset();
+        {
+            dynamic_array<Tracked> foo(1);
+            for (int i = 0; i < 10; i++)
+                REQUIRE(foo.emplace_back(i).value == i);
+
+            REQUIRE(Tracked::copies == 0);
+            REQUIRE(Tracked::alive == 10);
+        }
+        REQUIRE(Tracked::alive == 0);
+    }
+
+    SECTION("MOVE-ONLY ELEMENTS")
+    {
+        dynamic_array<std::unique_ptr<int>> foo(1);
+        foo.push_back(std::make_unique<int>(1));
+        foo.emplace_back(new int(3));
+        foo.insert(1, std::make_unique<int>(2));
+        foo.emplace(0, new int(0));
+
+        REQUIRE(foo.size() == 4);
+        for (int i = 0; i < 4; i++)
+            REQUIRE(*foo[i] == i);
+    }
+
+    SECTION("EMPLACE OF OWN ELEMENT")
+    {
+        dynamic_array<std::string> foo = {"first", "second", "third"};
+
+        foo.emplace(0, foo[2]);
+        foo.emplace_back(foo[0]);
+
+        REQUIRE(foo == dynamic_array<std::string>({"third", "first", "second", "third", "third"}));
+    }
+}
+
+TEST_CASE("BOUNDS CHECKING", "[ACCESS]")
+{
+    dynamic_array<int> foo = {1, 2, 3};
+
+    // at() throws under every policy
+    REQUIRE(foo[2] == 3);
+    REQUIRE_THROWS_AS(foo.at(3), std::out_of_range);
+    REQUIRE_THROWS_AS(static_cast<const dynamic_array<int> &>(foo).at(3), std::out_of_range);
+
+    // operator[] follows the policy of the build - an assertion failure can not be tested,
+    // an unchecked access is undefined
+#if DS_BOUNDS_CHECK == DS_BOUNDS_CHECK_THROW
+    REQUIRE_THROWS_AS(foo[3], std::out_of_range);
+    REQUIRE_THROWS_AS(static_cast<const dynamic_array<int> &>(foo)[3], std::out_of_range);
+#endif
+}
+
+// std::allocator which reports a small max_size()
+template <class T>
+struct LimitedAllocator : std::allocator<T>
+{
+    static const std::size_t LIMIT = 20;
+
+    LimitedAllocator() = default;
+    template <class U>
+    LimitedAllocator(const LimitedAllocator<U> &) {}
+
+    template <class U>
+    struct rebind
+    {
+        using other = LimitedAllocator<U>;
+    };
+
+    std::size_t max_size() const { return LIMIT; }
+};
+
+TEST_CASE("SIZE LIMITS", "[CAPACITY]")
+{
+    SECTION("SIZE TYPE")
+    {
+        dynamic_array<char> foo;
+
+        STATIC_REQUIRE(std::is_same_v<dynamic_array<char>::size_type, std::size_t>);
+        REQUIRE(foo.max_size() >= std::numeric_limits<unsigned int>::max());
+        REQUIRE_THROWS_AS(dynamic_array<char>(foo.max_size() + 1), std::length_error);
+    }
+
+    SECTION("GROWTH SATURATES AT MAX SIZE")
+    {
+        const std::size_t LIMIT = LimitedAllocator<int>::LIMIT;
+        dynamic_array<int, LimitedAllocator<int>> foo(LIMIT / 2);
+
+        for (std::size_t i = 0; i < LIMIT; i++)
+            foo.push_back(i);
+
+        REQUIRE(foo.size() == LIMIT);
+        REQUIRE(foo.capacity() == LIMIT);
+        REQUIRE_THROWS_AS(foo.push_back(0), std::length_error);
+        REQUIRE(foo.size() == LIMIT);
+    }
+}
+
+TEST_CASE("RANGE INSERTION", "[OPERATIONS]")
+{
+    SECTION("INSERT RANGE")
+    {
+        const int range[] = {10, 11, 12};
+        dynamic_array<int> foo = {1, 2, 3};
+        dynamic_array<int> bar(16);
+        bar.push_back(1), bar.push_back(2), bar.push_back(3);
+
+        foo.insert(1, std::begin(range), std::end(range)); // Reallocates
+        bar.insert(1, std::begin(range), std::end(range)); // In place
+
+        REQUIRE(foo == dynamic_array<int>({1, 10, 11, 12, 2, 3}));
+        REQUIRE(bar == foo);
+        REQUIRE_THROWS(foo.insert(foo.size(), std::begin(range), std::end(range)));
+    }
+
+    SECTION("INSERT RANGE OF NON-TRIVIAL ELEMENTS")
+    {
+        const std::string range[] = {"x", "y"};
+        dynamic_array<std::string> longTail(16), shortTail(16);
+        for (const char *str : {"a", "b", "c", "d"})
+            longTail.push_back(str), shortTail.push_back(str);
+
+        longTail.insert(1, std::begin(range), std::end(range));  // Tail longer than the range
+        shortTail.insert(3, std::begin(range), std::end(range)); // Tail shorter than the range
+
+        REQUIRE(longTail == dynamic_array<std::string>({"a", "x", "y", "b", "c", "d"}));
+        REQUIRE(shortTail == dynamic_array<std::string>({"a", "b", "c", "x", "y", "d"}));
+    }
+
+    SECTION("INSERT COPIES OF A VALUE")
+    {
+        dynamic_array<std::string> foo = {"a", "b"};
+
+        foo.insert(1, 3, foo[0]);
+
+        REQUIRE(foo == dynamic_array<std::string>({"a", "a", "a", "a", "b"}));
+    }
+
+    SECTION("APPEND")
+    {
+        const uint64_t COUNT = 1000;
+        dynamic_array<uint64_t> src(COUNT, 7);
+        dynamic_array<uint64_t> foo(1);
+
+        foo.append(&src.front(), &src.back() + 1);
+
+        REQUIRE(foo == src);
+        REQUIRE(foo.capacity() == COUNT); // Single growth to the needed size
+    }
+
+    SECTION("SINGLE PASS RANGE")
+    {
+        std::istringstream input("4 5 6");
+        dynamic_array<int> foo = {1, 2, 3};
+
+        foo.insert(1, std::istream_iterator<int>(input), std::istream_iterator<int>());
+
+        REQUIRE(foo == dynamic_array<int>({1, 4, 5, 6, 2, 3}));
+    }
+}
+
+TEST_CASE("REALLOCATING ALLOCATOR", "[ALLOCATOR]")
+{
+    // Mapped (and remapped) from a single page on
+    using page_allocator = ds::mmap_allocator<uint64_t, 4096>;
+
+    SECTION("GROWTH KEEPS THE ELEMENTS")
+    {
+        const uint64_t COUNT = 1 << 20;
+        dynamic_array<uint64_t, page_allocator> foo(1);
+
+        for (uint64_t i = 0; i < COUNT; i++)
+            foo.push_back(i);
+
+        bool EQUAL_FLAG = true;
+        for (uint64_t i = 0; i < COUNT; i++)
+        {
+            if (foo[i] != i)
+            {
+                EQUAL_FLAG = false;
+                break;
+            }
+        }
+
+        REQUIRE(foo.size() == COUNT);
+        REQUIRE(EQUAL_FLAG);
+    }
+
+    SECTION("PUSH BACK OF OWN ELEMENT AND RANGE INSERT")
+    {
+        dynamic_array<uint64_t, page_allocator> foo(512, 1);
+        dynamic_array<uint64_t, page_allocator> tail(600, 2);
+
+        foo.push_back(foo[0]);
+        foo.insert(1, &tail.front(), &tail.back() + 1);
+
+        REQUIRE(foo.size() == 512 + 1 + 600);
+        REQUIRE(foo.front() == 1);
+        REQUIRE(foo[600] == 2);
+        REQUIRE(foo[601] == 1);
+        REQUIRE(foo.back() == 1);
+    }
+}
+
+TEST_CASE("CAPACITY MANAGEMENT", "[CAPACITY]")
+{
+    SECTION("GROWTH POLICIES")
+    {
+        const std::size_t MAX = 1000;
+
+        REQUIRE(growth::doubling::grow(10, MAX, 1) == 10 * GROWTH_RATE);
+        REQUIRE(growth::doubling::grow(600, MAX, 1) == MAX);
+        REQUIRE(growth::one_and_half::grow(10, MAX, 1) == 15);
+        REQUIRE(growth::one_and_half::grow(1, MAX, 1) == 2);
+        REQUIRE(growth::fixed_step<64>::grow(10, MAX, 1) == 74);
+        REQUIRE(growth::fixed_step<64>::grow(990, MAX, 1) == MAX);
+        REQUIRE(growth::page_rounded<growth::doubling, 4096>::grow(16, std::size_t(-1), 8) == 512);
+    }
+
+    SECTION("ARRAY WITH A GROWTH POLICY")
+    {
+        const std::size_t STEP = 4;
+        dynamic_array<int, std::allocator<int>, growth::fixed_step<STEP>> foo(1);
+
+        for (int i = 0; i < 6; i++)
+            foo.push_back(i);
+
+        REQUIRE(foo.capacity() == 1 + 2 * STEP);
+        REQUIRE(foo.back() == 5);
+    }
+
+    SECTION("RESERVE")
+    {
+        const std::size_t CAPACITY = 100;
+        dynamic_array<std::string> foo = {"a", "b"};
+
+        foo.reserve(CAPACITY);
+        REQUIRE(foo.capacity() == CAPACITY);
+        REQUIRE(foo == dynamic_array<std::string>({"a", "b"}));
+
+        foo.reserve(1); // Never shrinks
+        REQUIRE(foo.capacity() == CAPACITY);
+        REQUIRE_THROWS_AS(foo.reserve(foo.max_size() + 1), std::length_error);
+    }
+
+    SECTION("CLEAR KEEPS CAPACITY, SHRINK TO FIT RELEASES IT")
+    {
+        dynamic_array<std::string> foo(32, "element");
+
+        foo.pop_back();
+        foo.shrink_to_fit();
+        REQUIRE(foo.capacity() == 31);
+        REQUIRE(foo.back() == "element");
+
+        foo.clear();
+        REQUIRE(foo.empty());
+        REQUIRE(foo.capacity() == 31);
+
+        foo.shrink_to_fit();
+        REQUIRE(foo.capacity() == 0);
+
+        foo.push_back("again");
+        REQUIRE(foo.capacity() == INIT_CAPACITY);
+        REQUIRE(foo.front() == "again");
+    }
+}
+
+// Checks find / count / contains against a plain loop for every needle position
+template <class T>
+static bool scanMatchesScalar()
+{
+    const std::size_t SIZE = 300;
+    bool MATCH_FLAG = true;
+
+    for (std::size_t size : {std::size_t(0), std::size_t(7), std::size_t(64), SIZE})
+    {
+        dynamic_array<T> foo(SIZE);
+        for (std::size_t i = 0; i < size; i++)
+            foo.push_back(static_cast<T>(i % 100 + 1));
+
+        for (std::size_t needle = 0; needle <= 101; needle++)
+        {
+            const T value = static_cast<T>(needle);
+            std::size_t expectIndex = dynamic_array<T>::npos, expectCount = 0;
+            for (std::size_t i = 0; i < size; i++)
+            {
+                if (foo[i] == value)
+                {
+                    expectIndex = expectCount ? expectIndex : i;
+                    ++expectCount;
+                }
+            }
+
+            MATCH_FLAG = MATCH_FLAG && foo.find(value) == expectIndex && foo.count(value) == expectCount &&
+                         foo.contains(value) == (expectCount > 0);
+        }
+    }
+
+    return MATCH_FLAG;
+}
+
+TEST_CASE("SEARCH", "[SEARCH]")
+{
+    SECTION("VECTORIZED ELEMENT TYPES")
+    {
+        REQUIRE(scanMatchesScalar<int8_t>());
+        REQUIRE(scanMatchesScalar<uint16_t>());
+        REQUIRE(scanMatchesScalar<int32_t>());
+        REQUIRE(scanMatchesScalar<uint64_t>());
+        REQUIRE(scanMatchesScalar<float>());
+        REQUIRE(scanMatchesScalar<double>());
+    }
+
+    SECTION("FLOATING POINT SEMANTICS")
+    {
+        dynamic_array<double> foo = {1.0, -0.0, std::numeric_limits<double>::quiet_NaN(), 4.0, 5.0, 6.0};
+
+        REQUIRE(foo.find(0.0) == 1);
+        REQUIRE_FALSE(foo.contains(std::numeric_limits<double>::quiet_NaN()));
+    }
+
+    SECTION("OTHER ELEMENT TYPES AND FIND IF")
+    {
+        dynamic_array<std::string> foo = {"a", "bb", "a", "ccc"};
+
+        REQUIRE(foo.find("bb") == 1);
+        REQUIRE(foo.count("a") == 2);
+        REQUIRE_FALSE(foo.contains("d"));
+        REQUIRE(foo.find_if([](const std::string &str) { return str.size() > 2; }) == 3);
+        REQUIRE(foo.find_if([](const std::string &str) { return str.empty(); }) == dynamic_array<std::string>::npos);
+    }
+}
+
+// Checks remove against erase_if (scalar path) for every value and several tails
+template <class T>
+static bool removeMatchesScalar()
+{
+    bool MATCH_FLAG = true;
+
+    for (std::size_t size : {std::size_t(0), std::size_t(5), std::size_t(64), std::size_t(301)})
+    {
+        for (std::size_t needle = 0; needle <= 8; needle++)
+        {
+            dynamic_array<T> foo(size + 1), bar(size + 1);
+            for (std::size_t i = 0; i < size; i++)
+            {
+                foo.push_back(static_cast<T>((i * 7) % 8));
+                bar.push_back(static_cast<T>((i * 7) % 8));
+            }
+
+            const T value = static_cast<T>(needle);
+            const std::size_t erased = foo.remove(value);
+            const std::size_t expected = bar.erase_if([value](T el) { return el == value; });
+
+            MATCH_FLAG = MATCH_FLAG && erased == expected && foo == bar && foo.count(value) == 0;
+        }
+    }
+
+    return MATCH_FLAG;
+}
+
+TEST_CASE("COMPACTION", "[OPERATIONS]")
+{
+    SECTION("ERASE RANGE")
+    {
+        dynamic_array<std::string> foo = {"a", "b", "c", "d", "e"};
+
+        foo.erase(1, 3);
+        REQUIRE(foo == dynamic_array<std::string>({"a", "d", "e"}));
+
+        foo.erase(2, 2);
+        REQUIRE(foo.size() == 3);
+
+        foo.erase(0, 3);
+        REQUIRE(foo.empty());
+        REQUIRE_THROWS_AS(foo.erase(0, 1), std::invalid_argument);
+
+        dynamic_array<int> bar = {1, 2, 3, 4, 5, 6};
+        bar.erase(3, 6);
+        REQUIRE(bar == dynamic_array<int>({1, 2, 3}));
+        REQUIRE_THROWS_AS(bar.erase(2, 1), std::invalid_argument);
+    }
+
+    SECTION("ERASE IF KEEPS THE ORDER")
+    {
+        dynamic_array<int> foo;
+        for (int i = 0; i < 1000; i++)
+            foo.push_back(i);
+
+        REQUIRE(foo.erase_if([](int el) { return el % 3 == 0; }) == 334);
+        REQUIRE(foo.size() == 666);
+        REQUIRE(foo[0] == 1);
+        REQUIRE(foo[1] == 2);
+        REQUIRE(foo[2] == 4);
+        REQUIRE(foo.back() == 998);
+        REQUIRE(foo.erase_if([](int el) { return el < 0; }) == 0);
+
+        dynamic_array<std::string> bar = {"keep", "", "also", "", ""};
+        REQUIRE(bar.erase_if([](const std::string &str) { return str.empty(); }) == 3);
+        REQUIRE(bar == dynamic_array<std::string>({"keep", "also"}));
+    }
+
+    SECTION("THROWING PREDICATE LEAVES A VALID ARRAY")
+    {
+        dynamic_array<std::string> foo = {"x", "a", "x", "b", "stop", "x", "c"};
+
+        REQUIRE_THROWS(foo.erase_if([](const std::string &str) {
+            if (str == "stop")
+                throw std::runtime_error("stop");
+            return str == "x";
+        }));
+
+        // The erased elements before the throw are gone, the rest is untouched
+        REQUIRE(foo == dynamic_array<std::string>({"a", "b", "stop", "x", "c"}));
+    }
+
+    SECTION("REMOVE")
+    {
+        REQUIRE(removeMatchesScalar<int8_t>());
+        REQUIRE(removeMatchesScalar<uint16_t>());
+        REQUIRE(removeMatchesScalar<int32_t>());
+        REQUIRE(removeMatchesScalar<uint64_t>());
+        REQUIRE(removeMatchesScalar<float>());
+        REQUIRE(removeMatchesScalar<double>());
+
+        dynamic_array<std::string> foo = {"a", "b", "a", "c", "a"};
+        REQUIRE(foo.remove(foo[0]) == 3); // The value may be one of the elements
+        REQUIRE(foo == dynamic_array<std::string>({"b", "c"}));
+
+        dynamic_array<double> bar = {std::numeric_limits<double>::quiet_NaN(), 1.0, -0.0};
+        REQUIRE(bar.remove(std::numeric_limits<double>::quiet_NaN()) == 0);
+        REQUIRE(bar.remove(0.0) == 1);
+        REQUIRE(bar.size() == 2);
+    }
+}
+
+TEST_CASE("ALIGNMENT", "[STORAGE]")
+{
+    SECTION("ARITHMETIC ELEMENTS ARE CACHE LINE ALIGNED")
+    {
+        dynamic_array<float> foo(3);
+        REQUIRE(dynamic_array<float>::alignment == DS_ARITHMETIC_ALIGNMENT);
+
+        bool ALIGNED_FLAG = true;
+        for (int i = 0; i < 1000; i++)
+        {
+            foo.push_back(static_cast<float>(i));
+            ALIGNED_FLAG = ALIGNED_FLAG && reinterpret_cast<std::uintptr_t>(foo.data()) % DS_ARITHMETIC_ALIGNMENT == 0;
+        }
+        REQUIRE(ALIGNED_FLAG);
+
+        foo.shrink_to_fit();
+        REQUIRE(reinterpret_cast<std::uintptr_t>(foo.data()) % DS_ARITHMETIC_ALIGNMENT == 0);
+
+        dynamic_array<float> bar(foo);
+        REQUIRE(reinterpret_cast<std::uintptr_t>(bar.data()) % DS_ARITHMETIC_ALIGNMENT == 0);
+    }
+
+    SECTION("ALIGNED DATA")
+    {
+        dynamic_array<double> foo = {1.0, 2.0, 3.0};
+        const dynamic_array<double> &cfoo = foo;
+
+        REQUIRE(foo.aligned_data() == foo.data());
+        REQUIRE(cfoo.aligned_data()[2] == 3.0);
+    }
+
+    SECTION("OTHER ELEMENTS AND ALLOCATORS")
+    {
+        REQUIRE(dynamic_array<std::string>::alignment == alignof(std::string));
+        REQUIRE(std::is_same_v<dynamic_array<std::string>::allocator_type, std::allocator<std::string>>);
+        REQUIRE(dynamic_array<int, std::allocator<int>>::alignment == alignof(int));
+
+        dynamic_array<char, aligned_allocator<char, 4096>> page;
+        REQUIRE(decltype(page)::alignment == 4096);
+        for (char c = 'a'; c <= 'z'; c++)
+            page.push_back(c);
+        REQUIRE(reinterpret_cast<std::uintptr_t>(page.data()) % 4096 == 0);
+        REQUIRE(page[25] == 'z');
+    }
 }
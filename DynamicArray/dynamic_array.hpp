@@ -6,8 +6,24 @@
  *  that can automatically handle its size when needed.
 */
 
+#include <algorithm>        // std::move, std::move_backward, std::rotate
+#include <cassert>          // Allocator preconditions, bounds checking
+#include <cstddef>          // std::size_t, std::ptrdiff_t
+#include <cstring>          // Bulk copies of trivially copyable types
 #include <iostream>         // Debugging
 #include <initializer_list> // C++ 11
+#include <iterator>         // Iterator categories
+#include <limits>           // Size limits
+#include <memory>           // std::allocator, std::allocator_traits
+#include <memory_resource>  // std::pmr::polymorphic_allocator
+#include <new>              // Placement new
+#include <stdexcept>        // Exception handling
+#include <type_traits>      // Move strategy selection
+#include <utility>          // std::move_if_noexcept
+
+#include "aligned_allocator.hpp" // Default allocator of arithmetic elements
+#include "array_stats.hpp"       // Opt-in allocation statistics (DS_ARRAY_STATS)
+#include "simd_scan.hpp"         // Vectorized find / count / remove
 
 namespace ds
 {
@@ -15,26 +31,561 @@ namespace ds
 #define INIT_CAPACITY 16
 #define GROWTH_RATE 2
 
-    template <class T>
+// Buffer alignment of arrays of arithmetic elements with the default allocator
+// (a cache line; covers AVX-512 vectors). Define before the include to override.
+#ifndef DS_ARITHMETIC_ALIGNMENT
+#define DS_ARITHMETIC_ALIGNMENT 64
+#endif
+
+// Bounds checking policy of operator[] - at() is always checked.
+// Define DS_BOUNDS_CHECK before the include (consistently in every translation unit)
+// to override the default: unchecked with NDEBUG, assert otherwise.
+#define DS_BOUNDS_CHECK_NONE 0   // No check - indexing loops can be unrolled and vectorized
+#define DS_BOUNDS_CHECK_ASSERT 1 // assert() on an invalid index
+#define DS_BOUNDS_CHECK_THROW 2  // Throws std::out_of_range like at()
+
+#ifndef DS_BOUNDS_CHECK
+#ifdef NDEBUG
+#define DS_BOUNDS_CHECK DS_BOUNDS_CHECK_NONE
+#else
+#define DS_BOUNDS_CHECK DS_BOUNDS_CHECK_ASSERT
+#endif
+#endif
+
+    namespace detail
+    {
+        // The element helpers construct and destroy through the allocator so that
+        // allocator-aware elements (e.g. std::pmr::string) receive it as well.
+        // Trivially copyable types cannot make use of an allocator, they are
+        // copied and shifted with bulk memcpy/memmove instead.
+
+        // Destroys the objects in [first, last) without releasing their storage
+        template <class Alloc, class T>
+        inline void destroy_range(Alloc &alloc, T *first, T *last) noexcept
+        {
+            if constexpr (!std::is_trivially_destructible_v<T>)
+            {
+                for (; first != last; ++first)
+                    std::allocator_traits<Alloc>::destroy(alloc, first);
+            }
+        }
+
+        // Constructs copies of [first, last) into the uninitialized storage at dest.
+        // Moves the elements instead when T's move constructor cannot throw
+        // (or when T is not copyable at all), so the source stays intact on failure.
+        // On exception the already constructed copies are destroyed.
+        // Returns the end of the constructed range.
+        template <class Alloc, class T>
+        inline T *uninitialized_move_if_noexcept(Alloc &alloc, T *first, T *last, T *dest)
+        {
+            if constexpr (std::is_trivially_copyable_v<T>)
+            {
+                if (first != last)
+                    std::memcpy(dest, first, (last - first) * sizeof(T));
+
+                return dest + (last - first);
+            }
+
+            T *current = dest;
+            try
+            {
+                for (; first != last; ++first, ++current)
+                    std::allocator_traits<Alloc>::construct(alloc, current, std::move_if_noexcept(*first));
+            }
+            catch (...)
+            {
+                destroy_range(alloc, dest, current);
+                throw;
+            }
+
+            return current;
+        }
+
+        template <class T, class Container>
+        class array_iterator;
+
+        struct array_io; // Binary loading (serialization.hpp)
+
+        // Contiguous iterators whose elements can be copied bytewise into T storage
+        template <class It, class T>
+        inline constexpr bool is_contiguous_of = false;
+
+        template <class T>
+        inline constexpr bool is_contiguous_of<T *, T> = true;
+
+        template <class T>
+        inline constexpr bool is_contiguous_of<const T *, T> = true;
+
+        template <class U, class Container, class T>
+        inline constexpr bool is_contiguous_of<array_iterator<U, Container>, T> = std::is_same_v<std::remove_const_t<U>, T>;
+
+        // Address of the element it refers to
+        template <class It>
+        inline auto iterator_address(It it)
+        {
+            if constexpr (std::is_pointer_v<It>)
+                return it;
+            else
+                return it.operator->();
+        }
+
+        // Constructs copies of [first, last) into the uninitialized storage at dest.
+        // On exception the already constructed copies are destroyed.
+        template <class Alloc, class InputIt, class T>
+        inline T *uninitialized_copy(Alloc &alloc, InputIt first, InputIt last, T *dest)
+        {
+            // Bulk copy only from a contiguous range of the same type
+            if constexpr (std::is_trivially_copyable_v<T> && is_contiguous_of<InputIt, T>)
+            {
+                if (first != last)
+                    std::memcpy(dest, detail::iterator_address(first), (last - first) * sizeof(T));
+
+                return dest + (last - first);
+            }
+
+            T *current = dest;
+            try
+            {
+                for (; first != last; ++first, ++current)
+                    std::allocator_traits<Alloc>::construct(alloc, current, *first);
+            }
+            catch (...)
+            {
+                destroy_range(alloc, dest, current);
+                throw;
+            }
+
+            return current;
+        }
+
+        // Constructs count copies of value into the uninitialized storage at dest.
+        // On exception the already constructed copies are destroyed.
+        template <class Alloc, class T>
+        inline T *uninitialized_fill_n(Alloc &alloc, T *dest, std::size_t count, const T &value)
+        {
+            T *current = dest;
+            try
+            {
+                for (; count > 0; --count, ++current)
+                    std::allocator_traits<Alloc>::construct(alloc, current, value);
+            }
+            catch (...)
+            {
+                destroy_range(alloc, dest, current);
+                throw;
+            }
+
+            return current;
+        }
+
+        // Shifts [data + position, data + size) one slot to the right.
+        // data[size] must be uninitialized storage; data[position] is left moved-from.
+        template <class Alloc, class T>
+        inline void shift_right(Alloc &alloc, T *data, std::size_t size, std::size_t position)
+        {
+            if constexpr (std::is_trivially_copyable_v<T>)
+            {
+                std::memmove(data + position + 1, data + position, (size - position) * sizeof(T));
+            }
+            else
+            {
+                // The last element is moved into the uninitialized slot,
+                // the rest of the tail is shifted over already constructed objects
+                std::allocator_traits<Alloc>::construct(alloc, data + size, std::move(data[size - 1]));
+                std::move_backward(data + position, data + size - 1, data + size);
+            }
+        }
+
+        // Shifts [data + position + 1, data + size) one slot to the left
+        // over data[position] and destroys the vacated last element.
+        template <class Alloc, class T>
+        inline void shift_left(Alloc &alloc, T *data, std::size_t size, std::size_t position)
+        {
+            if constexpr (std::is_trivially_copyable_v<T>)
+            {
+                std::memmove(data + position, data + position + 1, (size - position - 1) * sizeof(T));
+            }
+            else
+            {
+                std::move(data + position + 1, data + size, data + position);
+                std::allocator_traits<Alloc>::destroy(alloc, data + size - 1);
+            }
+        }
+
+        // Detects allocators which can resize a block in place (see mmap_allocator)
+        template <class Alloc, class T, class = void>
+        struct has_reallocate : std::false_type
+        {
+        };
+
+        template <class Alloc, class T>
+        struct has_reallocate<Alloc, T, std::void_t<decltype(std::declval<Alloc &>().reallocate(std::declval<T *>(), std::size_t(), std::size_t()))>>
+            : std::true_type
+        {
+        };
+
+        // Enables an overload only for iterator types (at least input iterators)
+        template <class It>
+        using require_input_iterator = std::enable_if_t<
+            std::is_convertible_v<typename std::iterator_traits<It>::iterator_category, std::input_iterator_tag>>;
+
+        // Forward iterator over count repetitions of a single value
+        template <class T>
+        class repeat_iterator
+        {
+        public:
+            using iterator_category = std::forward_iterator_tag;
+            using value_type = T;
+            using difference_type = std::ptrdiff_t;
+            using pointer = const T *;
+            using reference = const T &;
+
+            repeat_iterator(const T &value, std::size_t index) : m_value(&value), m_index(index) {}
+
+            reference operator*() const { return *m_value; }
+            pointer operator->() const { return m_value; }
+
+            repeat_iterator &operator++() // prefix
+            {
+                ++m_index;
+                return *this;
+            }
+
+            repeat_iterator operator++(int) // postfix
+            {
+                repeat_iterator copy(*this);
+                ++(*this);
+                return copy;
+            }
+
+            bool operator==(const repeat_iterator &other) const { return m_index == other.m_index; }
+            bool operator!=(const repeat_iterator &other) const { return !(*this == other); }
+
+        private:
+            const T *m_value;
+            std::size_t m_index;
+        };
+
+        // Subscript check according to DS_BOUNDS_CHECK
+        inline void check_subscript([[maybe_unused]] std::size_t index, [[maybe_unused]] std::size_t size)
+        {
+#if DS_BOUNDS_CHECK == DS_BOUNDS_CHECK_THROW
+            if (index >= size)
+                throw std::out_of_range("Invalid index!");
+#elif DS_BOUNDS_CHECK == DS_BOUNDS_CHECK_ASSERT
+            assert(index < size && "Invalid index!");
+#endif
+        }
+
+        // Next capacity on growth - chosen by GrowthPolicy (INIT_CAPACITY if empty)
+        // Throws std::length_error if the capacity cannot grow any more
+        template <class GrowthPolicy>
+        inline std::size_t next_capacity(std::size_t capacity, std::size_t max_size, std::size_t element_size)
+        {
+            if (capacity >= max_size)
+                throw std::length_error("Maximum capacity reached!");
+
+            if (capacity == 0)
+                return INIT_CAPACITY < max_size ? INIT_CAPACITY : max_size;
+
+            return GrowthPolicy::grow(capacity, max_size, element_size);
+        }
+
+        // Element-wise comparison of two ranges with equal length
+        template <class T>
+        inline bool equal(const T *lhs, const T *rhs, std::size_t count)
+        {
+            // Equal values share a single bit pattern - compare the raw bytes
+            if constexpr (std::has_unique_object_representations_v<T>)
+            {
+                return count == 0 || std::memcmp(lhs, rhs, count * sizeof(T)) == 0;
+            }
+            else
+            {
+                for (std::size_t i = 0; i < count; i++)
+                {
+                    if (lhs[i] != rhs[i])
+                        return false;
+                }
+
+                return true;
+            }
+        }
+
+        ///
+        // Iterator - pointer behaviour (contiguous, random access)
+        // Shared by the contiguous containers; only Container may create one from a pointer.
+        // T is const-qualified for the const_iterator, an iterator converts to it implicitly.
+        template <class T, class Container>
+        class array_iterator
+        {
+            friend Container;
+            template <class, class>
+            friend class array_iterator;
+
+        public:
+            using iterator_category = std::random_access_iterator_tag;
+#if __cplusplus > 201703L
+            using iterator_concept = std::contiguous_iterator_tag;
+#endif
+            using value_type = std::remove_const_t<T>;
+            using difference_type = std::ptrdiff_t;
+            using pointer = T *;
+            using reference = T &;
+
+            array_iterator() = default;
+
+            // iterator -> const_iterator
+            template <class U, class = std::enable_if_t<std::is_same_v<const U, T> && !std::is_same_v<U, T>>>
+            array_iterator(const array_iterator<U, Container> &other) : m_ptr(other.m_ptr) {}
+
+            array_iterator &operator++() // prefix
+            {
+                ++m_ptr;
+                return *this;
+            }
+
+            array_iterator operator++(int) // postfix
+            {
+                array_iterator copy(*this);
+                ++(*this);
+                return copy;
+            }
+
+            array_iterator &operator--() // prefix
+            {
+                --m_ptr;
+                return *this;
+            }
+
+            array_iterator operator--(int) // postfix
+            {
+                array_iterator copy(*this);
+                --(*this);
+                return copy;
+            }
+
+            array_iterator &operator+=(difference_type offset)
+            {
+                m_ptr += offset;
+                return *this;
+            }
+
+            array_iterator &operator-=(difference_type offset)
+            {
+                m_ptr -= offset;
+                return *this;
+            }
+
+            friend array_iterator operator+(array_iterator it, difference_type offset) { return it += offset; }
+            friend array_iterator operator+(difference_type offset, array_iterator it) { return it += offset; }
+            friend array_iterator operator-(array_iterator it, difference_type offset) { return it -= offset; }
+
+            friend difference_type operator-(const array_iterator &lhs, const array_iterator &rhs)
+            {
+                return lhs.m_ptr - rhs.m_ptr;
+            }
+
+            // Element access - the constness comes from T, not from the iterator
+            reference operator*() const
+            {
+                return *m_ptr;
+            }
+
+            pointer operator->() const
+            {
+                return m_ptr;
+            }
+
+            reference operator[](difference_type offset) const
+            {
+                return m_ptr[offset];
+            }
+
+            // Comparison operators - friends, so an iterator compares with a const_iterator
+            friend bool operator==(const array_iterator &lhs, const array_iterator &rhs)
+            {
+                return lhs.m_ptr == rhs.m_ptr;
+            }
+
+            friend bool operator!=(const array_iterator &lhs, const array_iterator &rhs)
+            {
+                return !(lhs == rhs);
+            }
+
+            friend bool operator<(const array_iterator &lhs, const array_iterator &rhs)
+            {
+                return lhs.m_ptr < rhs.m_ptr;
+            }
+
+            friend bool operator>(const array_iterator &lhs, const array_iterator &rhs)
+            {
+                return rhs < lhs;
+            }
+
+            friend bool operator>=(const array_iterator &lhs, const array_iterator &rhs)
+            {
+                return !(lhs < rhs);
+            }
+
+            friend bool operator<=(const array_iterator &lhs, const array_iterator &rhs)
+            {
+                return !(lhs > rhs);
+            }
+
+        private:
+            // Private ctor - Forbid user to create iterator from a pointer
+            // The parent class is responsible for the above-mentioned action
+
+            explicit array_iterator(T *m_ptr) : m_ptr(m_ptr) {}
+
+            //Default copy ctor and operator are available implicitly
+
+            T *m_ptr = nullptr;
+        };
+    } // namespace detail
+
+    // Growth policies - how much the capacity of a full array grows.
+    // grow(capacity, max_size, element_size) returns the new capacity in (capacity, max_size],
+    // for 0 < capacity < max_size.
+    namespace growth
+    {
+        // capacity + increment, saturated at max_size
+        inline std::size_t saturating_add(std::size_t capacity, std::size_t increment, std::size_t max_size)
+        {
+            return increment > max_size - capacity ? max_size : capacity + increment;
+        }
+
+        // Multiplies the capacity by GROWTH_RATE - the fewest reallocations
+        struct doubling
+        {
+            static std::size_t grow(std::size_t capacity, std::size_t max_size, std::size_t)
+            {
+                return capacity > max_size / GROWTH_RATE ? max_size : capacity * GROWTH_RATE;
+            }
+        };
+
+        // Multiplies the capacity by 1.5 - less unused memory, the freed blocks can be reused
+        struct one_and_half
+        {
+            static std::size_t grow(std::size_t capacity, std::size_t max_size, std::size_t)
+            {
+                return saturating_add(capacity, capacity > 1 ? capacity / 2 : 1, max_size);
+            }
+        };
+
+        // Adds Step elements - bounded unused memory, linear count of reallocations
+        template <std::size_t Step>
+        struct fixed_step
+        {
+            static_assert(Step > 0, "Growth step must be positive");
+
+            static std::size_t grow(std::size_t capacity, std::size_t max_size, std::size_t)
+            {
+                return saturating_add(capacity, Step, max_size);
+            }
+        };
+
+        // Rounds the capacity of Base up so the buffer fills whole pages
+        template <class Base = doubling, std::size_t PageSize = 4096>
+        struct page_rounded
+        {
+            static_assert(PageSize > 0, "Page size must be positive");
+
+            static std::size_t grow(std::size_t capacity, std::size_t max_size, std::size_t element_size)
+            {
+                const std::size_t grown = Base::grow(capacity, max_size, element_size);
+                if (grown > (std::size_t(-1) - PageSize) / element_size)
+                    return grown;
+
+                const std::size_t bytes = (grown * element_size + PageSize - 1) / PageSize * PageSize;
+                const std::size_t rounded = bytes / element_size;
+
+                return rounded < max_size ? rounded : max_size;
+            }
+        };
+    } // namespace growth
+
+    namespace detail
+    {
+        // Arithmetic elements get over-aligned buffers, everything else the plain std::allocator
+        template <class T>
+        using default_allocator = std::conditional_t<std::is_arithmetic_v<T>, aligned_allocator<T, DS_ARITHMETIC_ALIGNMENT>, std::allocator<T>>;
+
+        // Guaranteed alignment of the blocks of Alloc - its alignment member if it has one
+        template <class Alloc, class T, class = void>
+        inline constexpr std::size_t allocation_alignment = alignof(T);
+
+        template <class Alloc, class T>
+        inline constexpr std::size_t allocation_alignment<Alloc, T, std::void_t<decltype(Alloc::alignment)>> = Alloc::alignment;
+
+        // ptr with the promise to the optimizer that it is a multiple of Alignment
+        template <std::size_t Alignment, class T>
+        inline T *assume_aligned(T *ptr) noexcept
+        {
+#if defined(__GNUC__) || defined(__clang__)
+            return static_cast<T *>(__builtin_assume_aligned(ptr, Alignment));
+#else
+            return ptr;
+#endif
+        }
+    } // namespace detail
+
+    template <class T, class Allocator = detail::default_allocator<T>, class GrowthPolicy = growth::doubling>
     class dynamic_array
     {
+        using alloc_traits = std::allocator_traits<Allocator>;
+
+        // Trivially copyable elements may be relocated bytewise by the allocator itself
+        static constexpr bool uses_reallocate = std::is_trivially_copyable_v<T> && detail::has_reallocate<Allocator, T>::value;
+
     public:
+        using value_type = T;
+        using allocator_type = Allocator;
+        using size_type = std::size_t;
+        using difference_type = std::ptrdiff_t;
+        using reference = T &;
+        using const_reference = const T &;
+        using pointer = T *;
+        using const_pointer = const T *;
+
+        using iterator = detail::array_iterator<T, dynamic_array>;
+        using const_iterator = detail::array_iterator<const T, dynamic_array>;
+        using reverse_iterator = std::reverse_iterator<iterator>;
+        using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
         // Constructors, Destructors; Gang of Four
 
         // Default - Constructs an empty container with selected or default initial m_capacity
-        explicit dynamic_array(unsigned int m_capacity = INIT_CAPACITY);
+        explicit dynamic_array(size_type m_capacity = INIT_CAPACITY, const Allocator &alloc = Allocator());
+
+        // Constructs an empty container with default initial m_capacity which allocates from alloc
+        explicit dynamic_array(const Allocator &alloc);
 
         // Fill Constructor
-        explicit dynamic_array(unsigned int m_capacity, const T &element);
+        explicit dynamic_array(size_type m_capacity, const T &element, const Allocator &alloc = Allocator());
 
         // Constructs a container with a copy of each of the elements in il, in the same order.
-        dynamic_array(const std::initializer_list<T> &i_list);
+        dynamic_array(const std::initializer_list<T> &i_list, const Allocator &alloc = Allocator());
 
         // Constructs a container with a copy of each of the elements and keep the original order
-        dynamic_array(const dynamic_array<T> &other);
+        // The allocator is obtained by select_on_container_copy_construction
+        dynamic_array(const dynamic_array &other);
+
+        // Allocator-extended copy constructor
+        dynamic_array(const dynamic_array &other, const Allocator &alloc);
+
+        // Move constructor - takes over the buffer and the allocator, other is left empty with no storage
+        dynamic_array(dynamic_array &&other) noexcept;
 
         // Copy assignment operator (copy-and-swap idiom)
-        dynamic_array<T> &operator=(dynamic_array<T> other);
+        // The allocator is replaced only if it propagates on copy assignment
+        dynamic_array &operator=(const dynamic_array &other);
+
+        // Move assignment operator - takes over the buffer if the allocator propagates on move assignment
+        // or the allocators compare equal, otherwise the elements are moved one by one
+        dynamic_array &operator=(dynamic_array &&other) noexcept(alloc_traits::propagate_on_container_move_assignment::value ||
+                                                                 alloc_traits::is_always_equal::value);
 
         // Destructor
         ~dynamic_array();
@@ -44,16 +595,41 @@ namespace ds
 
         // Add one element to the back
         void push_back(const T &el);
+        void push_back(T &&el);
+
+        // Constructs an element in place at the back from args
+        template <class... Args>
+        T &emplace_back(Args &&...args);
 
         // Insert an element
-        void insert(unsigned int position, const T &val);
+        void insert(size_type position, const T &val);
+        void insert(size_type position, T &&val);
+
+        // Constructs an element from args and inserts it before position
+        template <class... Args>
+        void emplace(size_type position, Args &&...args);
+
+        // Range insertion - grows at most once and shifts the tail once
+        // The inserted range must not refer to elements of this array
+
+        // Insert copies of [first, last) before position
+        template <class InputIt, class = detail::require_input_iterator<InputIt>>
+        void insert(size_type position, InputIt first, InputIt last);
+
+        // Insert count copies of value before position
+        void insert(size_type position, size_type count, const T &value);
+
+        // Add copies of [first, last) to the back
+        template <class InputIt, class = detail::require_input_iterator<InputIt>>
+        void append(InputIt first, InputIt last);
 
         // Access operators
-        const T &operator[](unsigned int index) const;
-        T &operator[](unsigned int index);
+        // operator[] is checked according to DS_BOUNDS_CHECK, at() always throws std::out_of_range
+        const T &operator[](size_type index) const;
+        T &operator[](size_type index);
 
-        const T &at(unsigned int index) const;
-        T &at(unsigned int index);
+        const T &at(size_type index) const;
+        T &at(size_type index);
 
         // Access first element
         const T &front() const;
@@ -63,439 +639,1158 @@ namespace ds
         const T &back() const;
         T &back();
 
+        // Underlying contiguous storage - [data(), data() + size()) are the elements
+        T *data() noexcept { return m_data; }
+        const T *data() const noexcept { return m_data; }
+
+        // Alignment of the storage in bytes (see aligned_allocator)
+        static constexpr size_type alignment = detail::allocation_alignment<Allocator, T>;
+
+        // data() with its alignment known to the optimizer - aligned vector loads, no peeling loops
+        T *aligned_data() noexcept { return detail::assume_aligned<alignment>(m_data); }
+        const T *aligned_data() const noexcept { return detail::assume_aligned<alignment>(m_data); }
+
         ///
         // Remove operations
         void pop_back();
 
         // Erease an element from selected position
-        void erase(unsigned int position);
+        void erase(size_type position);
+
+        // Erase the elements in [first, last) - the tail is shifted once
+        void erase(size_type first, size_type last);
+
+        // Single pass compaction - the kept elements keep their order, returns the number of erased elements
 
+        // Erase every element satisfying pred
+        template <class Predicate>
+        size_type erase_if(Predicate pred);
+
+        // Erase every element equal to value (vectorized for integral and floating-point elements)
+        size_type remove(const T &value);
+
+        // Destroys all elements, the capacity is kept for reuse
         void clear();
 
+        ///
+        // Capacity operations
+
+        // Grows the capacity to at least new_capacity, never shrinks it
+        void reserve(size_type new_capacity);
+
+        // Releases the unused capacity
+        void shrink_to_fit();
+
         ///
         // Information methods
-        unsigned int size() const;
+        size_type size() const;
+
+        size_type capacity() const;
 
-        unsigned int capacity() const;
+        // The largest number of elements the array can hold
+        size_type max_size() const;
 
         bool empty() const;
 
-        // int find() const; TODO
+        allocator_type get_allocator() const;
+
+        ///
+        // Search operations - vectorized for integral and floating-point elements
+
+        // Position returned when no element is found
+        static constexpr size_type npos = static_cast<size_type>(-1);
+
+        // Index of the first element equal to value, npos if there is none
+        size_type find(const T &value) const;
+
+        // Index of the first element satisfying pred, npos if there is none
+        template <class Predicate>
+        size_type find_if(Predicate pred) const;
+
+        // Number of elements equal to value
+        size_type count(const T &value) const;
+
+        // Checks whether an element equal to value is stored
+        bool contains(const T &value) const;
 
         // Comparison operators
         bool operator==(const dynamic_array &other) const;
 
         ///
         // Iterator - pointer behaviour
-        class Iterator
-        {
-            friend class dynamic_array;
+        using Iterator = iterator;
+        using Const_Iterator = const_iterator;
+
+        iterator begin() noexcept { return iterator(m_data); }
+        iterator end() noexcept { return iterator(m_data + m_size); }
+        const_iterator begin() const noexcept { return const_iterator(m_data); }
+        const_iterator end() const noexcept { return const_iterator(m_data + m_size); }
+        const_iterator cbegin() const noexcept { return begin(); }
+        const_iterator cend() const noexcept { return end(); }
+
+        reverse_iterator rbegin() noexcept { return reverse_iterator(end()); }
+        reverse_iterator rend() noexcept { return reverse_iterator(begin()); }
+        const_reverse_iterator rbegin() const noexcept { return const_reverse_iterator(end()); }
+        const_reverse_iterator rend() const noexcept { return const_reverse_iterator(begin()); }
+        const_reverse_iterator crbegin() const noexcept { return rbegin(); }
+        const_reverse_iterator crend() const noexcept { return rend(); }
 
-        public:
-            Iterator &operator++() // prefix
-            {
-                ++m_ptr;
-                return *this;
-            }
+        // Debug info methods
+    public:
+        void printInfo(std::ostream &os) const;
 
-            Iterator operator++(int) // postfix
-            {
-                Iterator copy(*this);
-                ++(*this);
-                return copy;
-            }
+        // Allocation and copy counters - all zero unless DS_ARRAY_STATS is enabled
+        array_stats stats() const;
 
-            Iterator &operator--() // prefix
-            {
-                --m_ptr;
-                return *this;
-            }
+        // The counters are added to site when the array is destroyed (site must outlive the array)
+        void attach_stats(stats_site *site) noexcept;
 
-            Iterator operator--(int) // postfix
-            {
-                Iterator copy(*this);
-                --(*this);
-                return copy;
-            }
+    private:
+        friend struct detail::array_io; // Reads elements straight into the storage
+
+        Allocator m_alloc;
+        T *m_data; // Raw storage - only [0, m_size) holds constructed objects
+        size_type m_size, m_capacity;
+
+#if DS_ARRAY_STATS
+        array_stats m_stats;
+        stats_site *m_stats_site = nullptr;
+#endif
+
+        ///
+        // Helpers
+    private:
+        T *allocate(size_type count);
+        void deallocate(T *ptr, size_type count) noexcept;
 
-            // Operator[] is consciously omitted
+        void copyFrom(const dynamic_array &src);
 
-            const T &operator*() const
+        // Takes over the buffer of src, which is left empty with no storage
+        void steal(dynamic_array &src) noexcept;
+
+        // Statistics hooks - empty unless DS_ARRAY_STATS is enabled
+        void stats_allocated(size_type count) noexcept;
+        void stats_reallocated(size_type relocated) noexcept;
+        void stats_copied(size_type count) noexcept;
+
+        // The allocators are exchanged only if they propagate on swap,
+        // otherwise they must compare equal.
+        friend void swap(dynamic_array &first, dynamic_array &second) noexcept
+        {
+            using std::swap;
+            if constexpr (alloc_traits::propagate_on_container_swap::value)
             {
-                return *m_ptr;
+                swap(first.m_alloc, second.m_alloc); // Swaps allocators
             }
-
-            T &operator*()
+            else
             {
-                return *m_ptr;
+                assert(first.m_alloc == second.m_alloc);
             }
 
-            const T *operator->() const
+            swap(first.m_data, second.m_data);         // Swaps data pointers
+            swap(first.m_capacity, second.m_capacity); // Swaps m_capacity
+            swap(first.m_size, second.m_size);         // Swaps m_size
+        }
+        void reserve_size();
+        void reallocate(size_type new_capacity);
+        void release() noexcept;
+        template <class... Args>
+        void realloc_emplace_back(Args &&...args);
+
+        template <class InputIt>
+        void insert_range(size_type position, InputIt first, InputIt last);
+        template <class ForwardIt>
+        void insert_forward(size_type position, ForwardIt first, ForwardIt last, size_type count);
+        template <class ForwardIt>
+        void realloc_insert(size_type position, ForwardIt first, ForwardIt last, size_type count);
+    };
+
+    /* one-definition rule (ODR) <=> inline */
+    /* std::allocator <=> throws bad_alloc if allocation functions report failure to allocate storage.*/
+
+
+    template <class T, class Allocator, class GrowthPolicy>
+    inline dynamic_array<T, Allocator, GrowthPolicy>::dynamic_array(size_type m_capacity, const Allocator &alloc)
+        : m_alloc(alloc), m_size(0), m_capacity(m_capacity)
+    {
+        if (m_capacity == 0)
+            throw std::invalid_argument("Invalid initial m_capacity!");
+
+        m_data = allocate(m_capacity);
+    }
+
+    template <class T, class Allocator, class GrowthPolicy>
+    inline dynamic_array<T, Allocator, GrowthPolicy>::dynamic_array(const Allocator &alloc)
+        : dynamic_array(INIT_CAPACITY, alloc)
+    {
+    }
+
+    template <class T, class Allocator, class GrowthPolicy>
+    inline dynamic_array<T, Allocator, GrowthPolicy>::dynamic_array(size_type m_capacity, const T &element, const Allocator &alloc)
+        : m_alloc(alloc), m_size(m_capacity), m_capacity(m_capacity)
+    {
+        if (m_capacity == 0)
+            throw std::invalid_argument("Invalid initial m_capacity!");
+
+        m_data = allocate(m_capacity);
+        // T's copy ctor might fail and throw exception.
+        // detail::uninitialized_fill_n destroys the already constructed copies.
+        try
+        {
+            detail::uninitialized_fill_n(m_alloc, m_data, m_size, element);
+        }
+        catch (...)
+        {
+            deallocate(m_data, m_capacity);
+            std::cerr << "Invalid object copy operation!" << std::endl;
+            throw; // Rethrow the exception
+        }
+    }
+
+    template <class T, class Allocator, class GrowthPolicy>
+    inline dynamic_array<T, Allocator, GrowthPolicy>::dynamic_array(const std::initializer_list<T> &i_list, const Allocator &alloc)
+        : dynamic_array(i_list.size(), alloc)
+    {
+        // T's copy ctor might fail and throw exception.
+        // The m_size would track the successfully constructed data.
+        for (const T &el : i_list)
+        {
+            alloc_traits::construct(m_alloc, m_data + m_size, el);
+            ++m_size;
+        }
+    }
+
+    template <class T, class Allocator, class GrowthPolicy>
+    inline dynamic_array<T, Allocator, GrowthPolicy>::dynamic_array(const dynamic_array &other)
+        : m_alloc(alloc_traits::select_on_container_copy_construction(other.m_alloc))
+    {
+        this->copyFrom(other);
+    }
+
+    template <class T, class Allocator, class GrowthPolicy>
+    inline dynamic_array<T, Allocator, GrowthPolicy>::dynamic_array(const dynamic_array &other, const Allocator &alloc)
+        : m_alloc(alloc)
+    {
+        this->copyFrom(other);
+    }
+
+    // O(1) - Constant time
+    template <class T, class Allocator, class GrowthPolicy>
+    inline dynamic_array<T, Allocator, GrowthPolicy>::dynamic_array(dynamic_array &&other) noexcept
+        : m_alloc(std::move(other.m_alloc)), m_data(nullptr), m_size(0), m_capacity(0)
+    {
+        this->steal(other);
+    }
+
+    // Copy-And-Swap idiom
+    // The copy-swap idiom provides exception-safe copying.
+    // It requires that a correct copy ctor and swap are implemented.
+    // https://stackoverflow.com/questions/3279543/what-is-the-copy-and-swap-idiom
+    // The copy is made with the allocator *this should end up with, so the
+    // following swap never has to exchange unequal allocators.
+    template <class T, class Allocator, class GrowthPolicy>
+    inline dynamic_array<T, Allocator, GrowthPolicy> &dynamic_array<T, Allocator, GrowthPolicy>::operator=(const dynamic_array &other)
+    {
+        if (this == &other)
+            return *this;
+
+        if constexpr (alloc_traits::propagate_on_container_copy_assignment::value)
+        {
+            dynamic_array copy(other, other.m_alloc);
+            this->release(); // Releases the buffer with the allocator that owns it
+            m_alloc = other.m_alloc;
+            swap(*this, copy);
+#if DS_ARRAY_STATS
+            m_stats += copy.m_stats; // The swap leaves the counters in place
+#endif
+        }
+        else
+        {
+            dynamic_array copy(other, m_alloc);
+            swap(*this, copy);
+#if DS_ARRAY_STATS
+            m_stats += copy.m_stats;
+#endif
+        }
+
+        return *this;
+    }
+
+    // O(1) - Constant time, O(n) if the allocators differ and do not propagate
+    template <class T, class Allocator, class GrowthPolicy>
+    inline dynamic_array<T, Allocator, GrowthPolicy> &dynamic_array<T, Allocator, GrowthPolicy>::operator=(dynamic_array &&other) noexcept(
+        alloc_traits::propagate_on_container_move_assignment::value || alloc_traits::is_always_equal::value)
+    {
+        if (this == &other)
+            return *this;
+
+        if constexpr (alloc_traits::propagate_on_container_move_assignment::value)
+        {
+            this->release(); // Releases the buffer with the allocator that owns it
+            m_alloc = std::move(other.m_alloc);
+            this->steal(other);
+        }
+        else
+        {
+            if (alloc_traits::is_always_equal::value || m_alloc == other.m_alloc)
             {
-                return m_ptr;
+                this->release();
+                this->steal(other);
             }
-
-            T *operator->()
+            else
             {
-                return m_ptr;
+                // The buffer of other can not be freed by m_alloc - move the elements into storage of our own
+                dynamic_array moved(std::max<size_type>(other.m_capacity, 1), m_alloc);
+                detail::uninitialized_move_if_noexcept(m_alloc, other.m_data, other.m_data + other.m_size, moved.m_data);
+                moved.m_size = other.m_size;
+                swap(*this, moved);
+#if DS_ARRAY_STATS
+                m_stats += moved.m_stats;
+#endif
+                other.clear();
             }
+        }
+
+        return *this;
+    }
+
+    template <class T, class Allocator, class GrowthPolicy>
+    inline dynamic_array<T, Allocator, GrowthPolicy>::~dynamic_array()
+    {
+#if DS_ARRAY_STATS
+        if (m_stats_site)
+            m_stats_site->record(stats());
+#endif
+        this->release();
+    }
+
+    // Default Dynamic Array Operations
+
+    // Amortized constant complexity O(1)
+    template <class T, class Allocator, class GrowthPolicy>
+    inline void dynamic_array<T, Allocator, GrowthPolicy>::push_back(const T &el)
+    {
+        emplace_back(el);
+    }
+
+    // Amortized constant complexity O(1)
+    template <class T, class Allocator, class GrowthPolicy>
+    inline void dynamic_array<T, Allocator, GrowthPolicy>::push_back(T &&el)
+    {
+        emplace_back(std::move(el));
+    }
+
+    // Amortized constant complexity O(1)
+    template <class T, class Allocator, class GrowthPolicy>
+    template <class... Args>
+    inline T &dynamic_array<T, Allocator, GrowthPolicy>::emplace_back(Args &&...args)
+    {
+        if (m_size >= m_capacity)
+        {
+            realloc_emplace_back(std::forward<Args>(args)...);
+        }
+        else
+        {
+            alloc_traits::construct(m_alloc, m_data + m_size, std::forward<Args>(args)...);
+            ++m_size;
+        }
+
+        return m_data[m_size - 1];
+    }
+
+    // O(n) - Linear time
+    template <class T, class Allocator, class GrowthPolicy>
+    inline void dynamic_array<T, Allocator, GrowthPolicy>::insert(size_type position, const T &val)
+    {
+        emplace(position, val);
+    }
+
+    // O(n) - Linear time
+    template <class T, class Allocator, class GrowthPolicy>
+    inline void dynamic_array<T, Allocator, GrowthPolicy>::insert(size_type position, T &&val)
+    {
+        emplace(position, std::move(val));
+    }
+
+    // O(n) - Linear time
+    template <class T, class Allocator, class GrowthPolicy>
+    template <class... Args>
+    inline void dynamic_array<T, Allocator, GrowthPolicy>::emplace(size_type position, Args &&...args)
+    {
+        if (position >= m_size)
+        {
+            throw std::invalid_argument("Invalid insert position!");
+        }
+
+        // Built before shifting - args might refer to an element which is about to be moved
+        T copy(std::forward<Args>(args)...);
+
+        if (m_size >= m_capacity)
+        {
+            reserve_size(); // Guarantee enough capacity
+        }
+
+        detail::shift_right(m_alloc, m_data, m_size, position);
+        ++m_size;
+
+        m_data[position] = std::move(copy);
+    }
+
+    // O(n + k) - Linear time, k = std::distance(first, last)
+    template <class T, class Allocator, class GrowthPolicy>
+    template <class InputIt, class>
+    inline void dynamic_array<T, Allocator, GrowthPolicy>::insert(size_type position, InputIt first, InputIt last)
+    {
+        if (position >= m_size)
+        {
+            throw std::invalid_argument("Invalid insert position!");
+        }
+
+        insert_range(position, first, last);
+    }
+
+    // O(n + count) - Linear time
+    template <class T, class Allocator, class GrowthPolicy>
+    inline void dynamic_array<T, Allocator, GrowthPolicy>::insert(size_type position, size_type count, const T &value)
+    {
+        if (position >= m_size)
+        {
+            throw std::invalid_argument("Invalid insert position!");
+        }
+
+        T copy(value); // value might refer to an element which is about to be shifted
+        insert_forward(position, detail::repeat_iterator<T>(copy, 0), detail::repeat_iterator<T>(copy, count), count);
+    }
+
+    // Amortized O(k) - Linear in the length of the range
+    template <class T, class Allocator, class GrowthPolicy>
+    template <class InputIt, class>
+    inline void dynamic_array<T, Allocator, GrowthPolicy>::append(InputIt first, InputIt last)
+    {
+        insert_range(m_size, first, last);
+    }
+
+    // O(n) - Linear time
+    template <class T, class Allocator, class GrowthPolicy>
+    inline void dynamic_array<T, Allocator, GrowthPolicy>::erase(size_type position)
+    {
+        if (position >= m_size)
+        {
+            throw std::invalid_argument("Invalid insert position!");
+        }
+
+        detail::shift_left(m_alloc, m_data, m_size, position);
+        --m_size;
+    }
+
+    // O(n) - Linear time
+    template <class T, class Allocator, class GrowthPolicy>
+    inline void dynamic_array<T, Allocator, GrowthPolicy>::erase(size_type first, size_type last)
+    {
+        if (first > last || last > m_size)
+            throw std::invalid_argument("Invalid erase range!");
+
+        const size_type count = last - first;
+        if (count == 0)
+            return;
+
+        if constexpr (std::is_trivially_copyable_v<T>)
+        {
+            std::memmove(m_data + first, m_data + last, (m_size - last) * sizeof(T));
+        }
+        else
+        {
+            std::move(m_data + last, m_data + m_size, m_data + first);
+            detail::destroy_range(m_alloc, m_data + m_size - count, m_data + m_size);
+        }
+
+        m_size -= count;
+    }
 
-            // Comparison operators
-            bool operator==(const Iterator &other) const
-            {
-                return this->m_ptr == other.m_ptr;
-            }
+    // O(n) - Linear time
+    template <class T, class Allocator, class GrowthPolicy>
+    template <class Predicate>
+    inline typename dynamic_array<T, Allocator, GrowthPolicy>::size_type dynamic_array<T, Allocator, GrowthPolicy>::erase_if(Predicate pred)
+    {
+        // The elements in front of the first match stay where they are
+        size_type kept = find_if(pred);
+        if (kept == npos)
+            return 0;
 
-            bool operator!=(const Iterator &other) const
+        size_type i = kept + 1;
+        try
+        {
+            if constexpr (std::is_trivially_copyable_v<T> && std::is_trivially_copy_assignable_v<T>)
             {
-                return !(*this == other);
+                // Branchless: every element is copied, the output position only advances for the kept ones
+                for (; i < m_size; i++)
+                {
+                    const bool keep = !pred(m_data[i]);
+                    m_data[kept] = m_data[i];
+                    kept += keep;
+                }
             }
-
-            bool operator<(const Iterator &other) const
+            else
             {
-                return m_ptr < other.m_ptr;
+                for (; i < m_size; i++)
+                {
+                    if (!pred(m_data[i]))
+                        m_data[kept++] = std::move(m_data[i]);
+                }
             }
+        }
+        catch (...)
+        {
+            // Close the gap over the erased elements, the unvisited ones are kept
+            std::move(m_data + i, m_data + m_size, m_data + kept);
+            kept += m_size - i;
+            detail::destroy_range(m_alloc, m_data + kept, m_data + m_size);
+            m_size = kept;
+            throw;
+        }
 
-            bool operator>(const Iterator &other) const
-            {
-                return other < *this;
-            }
+        const size_type erased = m_size - kept;
+        detail::destroy_range(m_alloc, m_data + kept, m_data + m_size);
+        m_size = kept;
 
-            bool operator>=(const Iterator &other) const
-            {
-                return !(*this < other);
-            }
-            bool operator<=(const Iterator &other) const
-            {
-                return !(*this > other);
-            }
+        return erased;
+    }
 
-        private:
-            // Private ctor - Forbid user to create iterator
-            // The parent class is responsible for the above-mentioned action
+    // O(n) - Linear time
+    template <class T, class Allocator, class GrowthPolicy>
+    inline typename dynamic_array<T, Allocator, GrowthPolicy>::size_type dynamic_array<T, Allocator, GrowthPolicy>::remove(const T &value)
+    {
+        if constexpr (detail::simd::is_vectorizable<T>)
+        {
+            const size_type kept = detail::simd::remove(m_data, m_size, value);
+            const size_type erased = m_size - kept;
+            m_size = kept;
 
-            Iterator(T *m_ptr = nullptr) : m_ptr(m_ptr) {}
+            return erased;
+        }
+        else
+        {
+            // value may be one of the elements - compare against a copy which is not moved over
+            const T needle = value;
+            return erase_if([&needle](const T &el)
+                            { return el == needle; });
+        }
+    }
 
-            //Default copy ctor and operator are available implicitly
+    // O(1) - Constant time
+    template <class T, class Allocator, class GrowthPolicy>
+    inline void dynamic_array<T, Allocator, GrowthPolicy>::pop_back()
+    {
+        if (m_size == 0)
+            throw std::logic_error("Invalid opration: Cannot pop from empty array!");
 
-            T *m_ptr;
-        };
+        --m_size;
+        alloc_traits::destroy(m_alloc, m_data + m_size);
+    }
 
-        Iterator begin() { return Iterator(data); }
-        Iterator end() { return Iterator(data + m_size); }
+    // O(n) - Linear time (destructors of the stored elements)
+    template <class T, class Allocator, class GrowthPolicy>
+    inline void dynamic_array<T, Allocator, GrowthPolicy>::clear()
+    {
+        detail::destroy_range(m_alloc, m_data, m_data + m_size);
+        m_size = 0;
+    }
 
-        // TODO - Const_Iterator
+    // O(n) - Linear time, if the capacity grows
+    template <class T, class Allocator, class GrowthPolicy>
+    inline void dynamic_array<T, Allocator, GrowthPolicy>::reserve(size_type new_capacity)
+    {
+        if (new_capacity <= m_capacity)
+            return;
 
-        // Debug info methods
-    public:
-        void printInfo(std::ostream &os) const;
+        if (new_capacity > max_size())
+            throw std::length_error("Requested capacity exceeds max_size()!");
 
-    private:
-        T *data;
-        unsigned int m_size, m_capacity;
+        reallocate(new_capacity);
+    }
 
-        ///
-        // Helpers
-    private:
-        void copyFrom(const dynamic_array<T> &src);
-        friend void swap(dynamic_array &first, dynamic_array &second)
+    // O(n) - Linear time
+    template <class T, class Allocator, class GrowthPolicy>
+    inline void dynamic_array<T, Allocator, GrowthPolicy>::shrink_to_fit()
+    {
+        if (m_capacity == m_size)
+            return;
+
+        if (m_size == 0)
         {
-            using std::swap;
-            swap(first.data, second.data);             // Swaps data pointers
-            swap(first.m_capacity, second.m_capacity); // Swaps m_capacity
-            swap(first.m_size, second.m_size);         // Swaps m_size
+            release();
+            return;
         }
-        void reserve_size();
-    };
 
-    /* one-definition rule (ODR) <=> inline */
-    /* new T <=> throws bad_alloc if allocation functions report failure to allocate storage.*/
+        reallocate(m_size);
+    }
+
+    // Helpers
 
-    template <class T>
-    inline dynamic_array<T>::dynamic_array(unsigned int m_capacity)
-        : m_capacity(m_capacity), m_size(0)
+    // Destroys the elements and frees the buffer
+    template <class T, class Allocator, class GrowthPolicy>
+    inline void dynamic_array<T, Allocator, GrowthPolicy>::release() noexcept
     {
-        if (m_capacity == 0)
-            throw std::invalid_argument("Invalid initial m_capacity!");
+        detail::destroy_range(m_alloc, m_data, m_data + m_size);
+        deallocate(m_data, m_capacity);
+        m_data = nullptr;
+        m_size = 0;
+        m_capacity = 0;
+    }
+
+    // Raw storage for count objects, no constructors are called
+    template <class T, class Allocator, class GrowthPolicy>
+    inline T *dynamic_array<T, Allocator, GrowthPolicy>::allocate(size_type count)
+    {
+        if (count > max_size())
+            throw std::length_error("Requested capacity exceeds max_size()!");
+
+        T *ptr = alloc_traits::allocate(m_alloc, count); // Might throw bad_alloc
+        stats_allocated(count);
 
-        data = new T[m_capacity];
+        return ptr;
     }
 
-    template <class T>
-    inline dynamic_array<T>::dynamic_array(unsigned int m_capacity, const T &element)
-        : m_capacity(m_capacity), m_size(m_capacity)
+    template <class T, class Allocator, class GrowthPolicy>
+    inline void dynamic_array<T, Allocator, GrowthPolicy>::deallocate(T *ptr, size_type count) noexcept
     {
-        if (m_capacity == 0)
-            throw std::invalid_argument("Invalid initial m_capacity!");
+        if (ptr)
+            alloc_traits::deallocate(m_alloc, ptr, count);
+    }
 
-        data = new T[m_capacity];
-        // T::operator= might fail to copy and throw exception
+    // O(n) - Linear time
+    template <class T, class Allocator, class GrowthPolicy>
+    inline void dynamic_array<T, Allocator, GrowthPolicy>::copyFrom(const dynamic_array &src)
+    {
+        m_capacity = src.m_capacity;
+        m_data = m_capacity > 0 ? allocate(m_capacity) : nullptr; // A moved-from source has no storage
         try
         {
-            for (unsigned int i = 0; i < m_size; i++)
-                data[i] = element;
+            detail::uninitialized_copy(m_alloc, src.m_data, src.m_data + src.m_size, m_data);
         }
         catch (...)
         {
-            std::cerr << "Invalid object copy operation!" << std::endl;
-            throw; // Rethrow the exception
+            deallocate(m_data, m_capacity);
+            throw;
         }
-    }
 
-    template <class T>
-    inline dynamic_array<T>::dynamic_array(const std::initializer_list<T> &i_list)
-        : dynamic_array(i_list.size())
-    {
-        // T::operator= might fail to copy and throw exception.
-        // The m_size would track the successfully copied data.
-        for (const T &el : i_list)
-        {
-            data[m_size] = el;
-            ++m_size;
-        }
-    }
+        stats_copied(src.m_size);
 
-    template <class T>
-    inline dynamic_array<T>::dynamic_array(const dynamic_array<T> &other)
-    {
-        this->copyFrom(other);
+        // Sets m_size after successfully construction of the data
+        m_size = src.m_size;
     }
 
-    // Copy-And-Swap idiom
-    // The copy-swap idiom provides exception-safe copying.
-    // It requires that a correct copy ctor and swap are implemented.
-    // https://stackoverflow.com/questions/3279543/what-is-the-copy-and-swap-idiom
-    template <class T>
-    inline dynamic_array<T> &dynamic_array<T>::operator=(dynamic_array<T> other)
+    // O(1) - Constant time
+    // The counters stay with each object, like in swap()
+    template <class T, class Allocator, class GrowthPolicy>
+    inline void dynamic_array<T, Allocator, GrowthPolicy>::steal(dynamic_array &src) noexcept
     {
-        swap(*this, other);
+        m_data = src.m_data;
+        m_size = src.m_size;
+        m_capacity = src.m_capacity;
 
-        return *this;
+        src.m_data = nullptr;
+        src.m_size = 0;
+        src.m_capacity = 0;
     }
 
-    template <class T>
-    inline dynamic_array<T>::~dynamic_array()
+    // O(n) - Linear time
+    // Elements are move-constructed into the new buffer when T's move ctor is noexcept,
+    // otherwise they are copied so the old buffer stays valid if a copy throws (strong guarantee).
+    template <class T, class Allocator, class GrowthPolicy>
+    inline void dynamic_array<T, Allocator, GrowthPolicy>::reserve_size()
     {
-        this->clear();
+        reallocate(detail::next_capacity<GrowthPolicy>(m_capacity, max_size(), sizeof(T)));
     }
 
-    // Default Dynamic Array Operations
-
-    // Amortized constant complexity O(1)
-    template <class T>
-    inline void dynamic_array<T>::push_back(const T &el)
+    // O(n) - Linear time (page remapping with a reallocating allocator)
+    // Moves the elements into storage for new_capacity >= m_size elements
+    template <class T, class Allocator, class GrowthPolicy>
+    inline void dynamic_array<T, Allocator, GrowthPolicy>::reallocate(size_type new_capacity)
     {
-        if (m_size >= m_capacity)
+        if constexpr (uses_reallocate)
         {
-            reserve_size();
+            if (m_data)
+            {
+                m_data = m_alloc.reallocate(m_data, m_capacity, new_capacity); // Pages are remapped, nothing is copied
+                stats_allocated(new_capacity);
+                stats_reallocated(0);
+            }
+            else
+            {
+                m_data = allocate(new_capacity);
+            }
+
+            m_capacity = new_capacity;
+            return;
         }
 
-        data[m_size] = el;
-        ++m_size;
+        T *temp = allocate(new_capacity);
+
+        try
+        {
+            detail::uninitialized_move_if_noexcept(m_alloc, m_data, m_data + m_size, temp);
+        }
+        catch (...)
+        {
+            deallocate(temp, new_capacity);
+            throw;
+        }
+
+        stats_reallocated(m_size);
+
+        detail::destroy_range(m_alloc, m_data, m_data + m_size);
+        deallocate(m_data, m_capacity);
+        m_data = temp;
+
+        m_capacity = new_capacity;
     }
 
-    // O(n) - Linear time
-    template <class T>
-    inline void dynamic_array<T>::insert(unsigned int position, const T &val)
+    // Grows the buffer and appends an element constructed from args.
+    // The new element is constructed before the old ones are relocated,
+    // so args may safely refer to an element of this array.
+    template <class T, class Allocator, class GrowthPolicy>
+    template <class... Args>
+    inline void dynamic_array<T, Allocator, GrowthPolicy>::realloc_emplace_back(Args &&...args)
     {
-        if (position >= m_size)
+        size_type new_capacity = detail::next_capacity<GrowthPolicy>(m_capacity, max_size(), sizeof(T));
+
+        if constexpr (uses_reallocate)
         {
-            throw std::invalid_argument("Invalid insert position!");
+            T copy(std::forward<Args>(args)...); // The old buffer might be gone after reallocate()
+            reallocate(new_capacity);
+            alloc_traits::construct(m_alloc, m_data + m_size, copy);
+            ++m_size;
+            return;
+        }
+
+        T *temp = allocate(new_capacity);
+
+        try
+        {
+            alloc_traits::construct(m_alloc, temp + m_size, std::forward<Args>(args)...);
+        }
+        catch (...)
+        {
+            deallocate(temp, new_capacity);
+            throw;
         }
 
-        this->push_back(val); // Guarantee enough capacity
-        for (int i = m_size - 1; i > position; i--)
+        try
+        {
+            detail::uninitialized_move_if_noexcept(m_alloc, m_data, m_data + m_size, temp);
+        }
+        catch (...)
         {
-            data[i] = data[i - 1];
+            alloc_traits::destroy(m_alloc, temp + m_size);
+            deallocate(temp, new_capacity);
+            throw;
         }
 
-        data[position] = val;
+        stats_reallocated(m_size);
+
+        detail::destroy_range(m_alloc, m_data, m_data + m_size);
+        deallocate(m_data, m_capacity);
+        m_data = temp;
+
+        m_capacity = new_capacity;
+        ++m_size;
     }
 
-    // O(n) - Linear time
-    template <class T>
-    inline void dynamic_array<T>::erase(unsigned int position)
+    // Single pass ranges have no known length - they are appended one by one
+    // and rotated into place, every other range is inserted with a single shift.
+    template <class T, class Allocator, class GrowthPolicy>
+    template <class InputIt>
+    inline void dynamic_array<T, Allocator, GrowthPolicy>::insert_range(size_type position, InputIt first, InputIt last)
     {
-        if (position >= m_size)
+        using category = typename std::iterator_traits<InputIt>::iterator_category;
+
+        if constexpr (std::is_convertible_v<category, std::forward_iterator_tag>)
         {
-            throw std::invalid_argument("Invalid insert position!");
+            insert_forward(position, first, last, static_cast<size_type>(std::distance(first, last)));
         }
-
-        for (size_t i = position; i < m_size - 1; i++)
+        else
         {
-            data[i] = data[i + 1];
+            const size_type old_size = m_size;
+            for (; first != last; ++first)
+                emplace_back(*first);
+
+            std::rotate(m_data + position, m_data + old_size, m_data + m_size);
         }
-        --m_size;
     }
 
-    // O(1) - Constant time
-    template <class T>
-    inline void dynamic_array<T>::pop_back()
+    // Inserts the count elements of [first, last) before position.
+    // Reallocates once if the capacity is insufficient, otherwise the tail is shifted
+    // once by count slots. Basic exception guarantee for the in-place insertion.
+    template <class T, class Allocator, class GrowthPolicy>
+    template <class ForwardIt>
+    inline void dynamic_array<T, Allocator, GrowthPolicy>::insert_forward(size_type position, ForwardIt first, ForwardIt last, size_type count)
     {
-        if (m_size == 0)
-            throw std::logic_error("Invalid opration: Cannot pop from empty array!");
+        if (count == 0)
+            return;
 
-        --m_size;
+        if (count > m_capacity - m_size)
+        {
+            realloc_insert(position, first, last, count);
+            return;
+        }
+
+        T *pos = m_data + position;
+        T *old_end = m_data + m_size;
+        const size_type elems_after = m_size - position;
+
+        if constexpr (std::is_trivially_copyable_v<T>)
+        {
+            std::memmove(pos + count, pos, elems_after * sizeof(T));
+            std::copy(first, last, pos);
+            m_size += count;
+        }
+        else if (elems_after > count)
+        {
+            // The last count elements move into uninitialized storage,
+            // the rest of the tail is shifted over constructed objects
+            detail::uninitialized_move_if_noexcept(m_alloc, old_end - count, old_end, old_end);
+            m_size += count;
+            std::move_backward(pos, old_end - count, old_end);
+            std::copy(first, last, pos);
+        }
+        else
+        {
+            // The part of the range past the old end and the whole tail
+            // are constructed in uninitialized storage
+            ForwardIt mid = first;
+            std::advance(mid, elems_after);
+
+            detail::uninitialized_copy(m_alloc, mid, last, old_end);
+            m_size += count - elems_after;
+            detail::uninitialized_move_if_noexcept(m_alloc, pos, old_end, m_data + m_size);
+            m_size += elems_after;
+            std::copy(first, mid, pos);
+        }
     }
 
-    // O(1) - Constant time
-    template <class T>
-    inline void dynamic_array<T>::clear()
+    // Grows the buffer once to fit count more elements and builds
+    // prefix, inserted range and tail directly at their final place (strong guarantee).
+    template <class T, class Allocator, class GrowthPolicy>
+    template <class ForwardIt>
+    inline void dynamic_array<T, Allocator, GrowthPolicy>::realloc_insert(size_type position, ForwardIt first, ForwardIt last, size_type count)
     {
-        delete[] data;
-        data = nullptr;
-        m_size = 0;
-        m_capacity = 0;
-    }
+        if (count > max_size() - m_size)
+            throw std::length_error("Requested size exceeds max_size()!");
 
-    // Helpers
+        // Keeps the amortized growth if the range is small
+        size_type new_capacity = detail::next_capacity<GrowthPolicy>(m_capacity, max_size(), sizeof(T));
+        if (new_capacity < m_size + count)
+            new_capacity = m_size + count;
 
-    // O(n) - Linear time
-    template <class T>
-    inline void dynamic_array<T>::copyFrom(const dynamic_array<T> &src)
-    {
-        m_capacity = src.m_capacity;
-        data = new T[m_capacity]; // Might throw bad_alloc
-        for (unsigned int i = 0; i < src.m_size; i++)
+        if constexpr (uses_reallocate)
         {
-            data[i] = src.data[i];
+            reallocate(new_capacity);
+            insert_forward(position, first, last, count); // Fits in place now
+            return;
         }
 
-        // Sets m_size after successfully assignment of the data
-        m_size = src.m_size;
-    }
+        T *temp = allocate(new_capacity);
+        T *gap = temp + position;
 
-    template <class T>
-    inline void dynamic_array<T>::reserve_size()
-    {
-        unsigned int new_capacity = m_capacity ? m_capacity * GROWTH_RATE : INIT_CAPACITY;
-        T *temp = new T[new_capacity];
+        try
+        {
+            detail::uninitialized_copy(m_alloc, first, last, gap);
+        }
+        catch (...)
+        {
+            deallocate(temp, new_capacity);
+            throw;
+        }
+
+        try
+        {
+            detail::uninitialized_move_if_noexcept(m_alloc, m_data, m_data + position, temp);
+            try
+            {
+                detail::uninitialized_move_if_noexcept(m_alloc, m_data + position, m_data + m_size, gap + count);
+            }
+            catch (...)
+            {
+                detail::destroy_range(m_alloc, temp, gap);
+                throw;
+            }
+        }
+        catch (...)
+        {
+            detail::destroy_range(m_alloc, gap, gap + count);
+            deallocate(temp, new_capacity);
+            throw;
+        }
 
-        for (unsigned int i = 0; i < m_size; i++)
-            temp[i] = data[i];
+        stats_reallocated(m_size);
 
-        delete[] data;
-        data = temp;
+        detail::destroy_range(m_alloc, m_data, m_data + m_size);
+        deallocate(m_data, m_capacity);
+        m_data = temp;
 
         m_capacity = new_capacity;
+        m_size += count;
     }
 
     // Random access operations (operator [], front, back, at)
 
     // O(1) - Constant time
-    template <class T>
-    inline const T &dynamic_array<T>::operator[](unsigned int index) const
+    template <class T, class Allocator, class GrowthPolicy>
+    inline const T &dynamic_array<T, Allocator, GrowthPolicy>::operator[](size_type index) const
     {
-        if (index >= m_size)
-            throw std::out_of_range("Invalid index!");
+        detail::check_subscript(index, m_size); // Policy selected by DS_BOUNDS_CHECK
 
-        return data[index];
+        return m_data[index];
     }
 
     // O(1) - Constant time
-    template <class T>
-    inline T &dynamic_array<T>::operator[](unsigned int index)
+    template <class T, class Allocator, class GrowthPolicy>
+    inline T &dynamic_array<T, Allocator, GrowthPolicy>::operator[](size_type index)
     {
-        if (index >= m_size)
-            throw std::out_of_range("Invalid index!");
+        detail::check_subscript(index, m_size); // Policy selected by DS_BOUNDS_CHECK
 
-        return data[index];
+        return m_data[index];
     }
 
     // O(1) - Constant time
-    template <class T>
-    inline const T &dynamic_array<T>::at(unsigned int index) const
+    template <class T, class Allocator, class GrowthPolicy>
+    inline const T &dynamic_array<T, Allocator, GrowthPolicy>::at(size_type index) const
     {
-        return this->operator[](index);
+        if (index >= m_size)
+            throw std::out_of_range("Invalid index!");
+
+        return m_data[index];
     }
 
     // O(1) - Constant time
-    template <class T>
-    inline T &dynamic_array<T>::at(unsigned int index)
+    template <class T, class Allocator, class GrowthPolicy>
+    inline T &dynamic_array<T, Allocator, GrowthPolicy>::at(size_type index)
     {
-        return this->operator[](index);
+        if (index >= m_size)
+            throw std::out_of_range("Invalid index!");
+
+        return m_data[index];
     }
 
     // O(1) - Constant time
-    template <class T>
-    inline T &dynamic_array<T>::front()
+    template <class T, class Allocator, class GrowthPolicy>
+    inline T &dynamic_array<T, Allocator, GrowthPolicy>::front()
     {
         if (m_size == 0)
             throw std::logic_error("Invalid opration: empty array!");
 
-        return data[0];
+        return m_data[0];
     }
 
     // O(1) - Constant time
-    template <class T>
-    inline const T &dynamic_array<T>::front() const
+    template <class T, class Allocator, class GrowthPolicy>
+    inline const T &dynamic_array<T, Allocator, GrowthPolicy>::front() const
     {
         if (m_size == 0)
             throw std::logic_error("Invalid opration: empty array!");
 
-        return data[0];
+        return m_data[0];
     }
 
     // O(1) - Constant time
-    template <class T>
-    inline T &dynamic_array<T>::back()
+    template <class T, class Allocator, class GrowthPolicy>
+    inline T &dynamic_array<T, Allocator, GrowthPolicy>::back()
     {
         if (m_size == 0)
             throw std::logic_error("Invalid opration: empty array!");
 
-        return data[m_size - 1];
+        return m_data[m_size - 1];
     }
 
     // O(1) - Constant time
-    template <class T>
-    inline const T &dynamic_array<T>::back() const
+    template <class T, class Allocator, class GrowthPolicy>
+    inline const T &dynamic_array<T, Allocator, GrowthPolicy>::back() const
     {
         if (m_size == 0)
             throw std::logic_error("Invalid opration: empty array!");
 
-        return data[m_size - 1];
+        return m_data[m_size - 1];
     }
 
-    template <class T>
-    inline bool dynamic_array<T>::operator==(const dynamic_array &other) const
+    template <class T, class Allocator, class GrowthPolicy>
+    inline bool dynamic_array<T, Allocator, GrowthPolicy>::operator==(const dynamic_array &other) const
     {
         if (this->m_size != other.m_size)
             return false;
 
-        for (size_t i = 0; i < other.m_size; i++)
-        {
-            if (data[i] != other.data[i])
-                return false;
-        }
-
-        return true;
+        return detail::equal(m_data, other.m_data, m_size);
     }
 
-    template <class T>
-    inline unsigned int dynamic_array<T>::size() const
+    template <class T, class Allocator, class GrowthPolicy>
+    inline typename dynamic_array<T, Allocator, GrowthPolicy>::size_type dynamic_array<T, Allocator, GrowthPolicy>::size() const
     {
         return m_size;
     }
 
-    template <class T>
-    inline unsigned int dynamic_array<T>::capacity() const
+    template <class T, class Allocator, class GrowthPolicy>
+    inline typename dynamic_array<T, Allocator, GrowthPolicy>::size_type dynamic_array<T, Allocator, GrowthPolicy>::capacity() const
     {
         return m_capacity;
     }
 
-    template <class T>
-    inline bool dynamic_array<T>::empty() const
+    template <class T, class Allocator, class GrowthPolicy>
+    inline typename dynamic_array<T, Allocator, GrowthPolicy>::size_type dynamic_array<T, Allocator, GrowthPolicy>::max_size() const
+    {
+        // Pointer differences over the buffer must fit in std::ptrdiff_t
+        const size_type max_elements = std::numeric_limits<std::ptrdiff_t>::max() / sizeof(T);
+        const size_type alloc_max = alloc_traits::max_size(m_alloc);
+
+        return alloc_max < max_elements ? alloc_max : max_elements;
+    }
+
+    template <class T, class Allocator, class GrowthPolicy>
+    inline bool dynamic_array<T, Allocator, GrowthPolicy>::empty() const
     {
         return m_size == 0;
     }
 
+    template <class T, class Allocator, class GrowthPolicy>
+    inline typename dynamic_array<T, Allocator, GrowthPolicy>::allocator_type dynamic_array<T, Allocator, GrowthPolicy>::get_allocator() const
+    {
+        return m_alloc;
+    }
+
+    // Search operations
+
+    // O(n) - Linear time
+    template <class T, class Allocator, class GrowthPolicy>
+    inline typename dynamic_array<T, Allocator, GrowthPolicy>::size_type dynamic_array<T, Allocator, GrowthPolicy>::find(const T &value) const
+    {
+        size_type index;
+        if constexpr (detail::simd::is_vectorizable<T>)
+        {
+            index = detail::simd::find(m_data, m_size, value);
+        }
+        else
+        {
+            for (index = 0; index < m_size && !(m_data[index] == value); index++)
+                ;
+        }
+
+        return index < m_size ? index : npos;
+    }
+
+    // O(n) - Linear time
+    template <class T, class Allocator, class GrowthPolicy>
+    template <class Predicate>
+    inline typename dynamic_array<T, Allocator, GrowthPolicy>::size_type dynamic_array<T, Allocator, GrowthPolicy>::find_if(Predicate pred) const
+    {
+        for (size_type i = 0; i < m_size; i++)
+        {
+            if (pred(m_data[i]))
+                return i;
+        }
+
+        return npos;
+    }
+
+    // O(n) - Linear time
+    template <class T, class Allocator, class GrowthPolicy>
+    inline typename dynamic_array<T, Allocator, GrowthPolicy>::size_type dynamic_array<T, Allocator, GrowthPolicy>::count(const T &value) const
+    {
+        if constexpr (detail::simd::is_vectorizable<T>)
+        {
+            return detail::simd::count(m_data, m_size, value);
+        }
+        else
+        {
+            size_type matches = 0;
+            for (size_type i = 0; i < m_size; i++)
+            {
+                if (m_data[i] == value)
+                    ++matches;
+            }
+
+            return matches;
+        }
+    }
+
+    // O(n) - Linear time
+    template <class T, class Allocator, class GrowthPolicy>
+    inline bool dynamic_array<T, Allocator, GrowthPolicy>::contains(const T &value) const
+    {
+        return find(value) != npos;
+    }
+
     // Debug Info
-    template <typename T>
-    inline void dynamic_array<T>::printInfo(std::ostream &os) const
+    template <class T, class Allocator, class GrowthPolicy>
+    inline void dynamic_array<T, Allocator, GrowthPolicy>::printInfo(std::ostream &os) const
+    {
+        os << "Address: 0x" << this << "\nBuffer Address 0x" << m_data << "\nm_size: " << m_size << "\nm_capacity: " << m_capacity << std::endl;
+#if DS_ARRAY_STATS
+        os << "Stats: " << stats() << std::endl;
+#endif
+    }
+
+    // Allocation statistics
+
+    template <class T, class Allocator, class GrowthPolicy>
+    inline array_stats dynamic_array<T, Allocator, GrowthPolicy>::stats() const
+    {
+#if DS_ARRAY_STATS
+        array_stats current = m_stats;
+        current.wasted_capacity = m_capacity - m_size;
+        return current;
+#else
+        return array_stats();
+#endif
+    }
+
+    template <class T, class Allocator, class GrowthPolicy>
+    inline void dynamic_array<T, Allocator, GrowthPolicy>::attach_stats([[maybe_unused]] stats_site *site) noexcept
+    {
+#if DS_ARRAY_STATS
+        m_stats_site = site;
+#endif
+    }
+
+    // A new buffer of count elements
+    template <class T, class Allocator, class GrowthPolicy>
+    inline void dynamic_array<T, Allocator, GrowthPolicy>::stats_allocated([[maybe_unused]] size_type count) noexcept
     {
-        os << "Address: 0x" << this << "\nBuffer Address 0x" << data << "\nm_size: " << m_size << "\nm_capacity: " << m_capacity << std::endl;
+#if DS_ARRAY_STATS
+        m_stats.allocations++;
+        m_stats.bytes_allocated += count * sizeof(T);
+        m_stats.peak_capacity = std::max(m_stats.peak_capacity, count);
+#endif
     }
 
+    // The buffer was replaced, relocated elements were moved or copied (see detail::uninitialized_move_if_noexcept)
+    template <class T, class Allocator, class GrowthPolicy>
+    inline void dynamic_array<T, Allocator, GrowthPolicy>::stats_reallocated([[maybe_unused]] size_type relocated) noexcept
+    {
+#if DS_ARRAY_STATS
+        m_stats.reallocations++;
+
+        if constexpr (!std::is_trivially_copyable_v<T> && (std::is_nothrow_move_constructible_v<T> || !std::is_copy_constructible_v<T>))
+            m_stats.moves += relocated;
+        else
+            m_stats.bytes_copied += relocated * sizeof(T);
+#endif
+    }
+
+    // count elements were copied from another array
+    template <class T, class Allocator, class GrowthPolicy>
+    inline void dynamic_array<T, Allocator, GrowthPolicy>::stats_copied([[maybe_unused]] size_type count) noexcept
+    {
+#if DS_ARRAY_STATS
+        m_stats.bytes_copied += count * sizeof(T);
+#endif
+    }
+
+    namespace pmr
+    {
+        // dynamic_array which allocates from a std::pmr::memory_resource (arena, pool, ...)
+        template <class T>
+        using dynamic_array = ds::dynamic_array<T, std::pmr::polymorphic_allocator<T>>;
+    } // namespace pmr
+
 } // namespace ds
 
 #endif // DYNAMIC_ARRAY_GUARD
\ No newline at end of file
@@ -0,0 +1,514 @@
+#ifndef DYNAMIC_BITSET_GUARD
+#define DYNAMIC_BITSET_GUARD
+
+/*
+ *  Resizable sequence of bits, packed 64 to a word - one eighth of the
+ *  memory of a dynamic_array<bool>.
+ *
+ *  The words are kept in a dynamic_array<std::uint64_t> (cache-line aligned
+ *  by default, see DS_ARITHMETIC_ALIGNMENT). Single bits are accessed
+ *  through a proxy reference; count, the searches and the bulk operations
+ *  work a word at a time, the bulk ones with the AVX2/SSE4.2 kernels of
+ *  simd_scan.hpp. The bits behind size() in the last word are always zero.
+*/
+
+#include "dynamic_array.hpp" // Word storage
+#include "simd_scan.hpp"     // Word kernels
+
+#include <cstddef>          // std::size_t
+#include <cstdint>          // std::uint64_t
+#include <initializer_list> // Bit lists
+#include <limits>           // max_size
+#include <stdexcept>        // Exceptions
+
+namespace ds
+{
+    namespace detail
+    {
+        // Position of the lowest set bit of word (word != 0)
+        inline unsigned int lowest_bit(std::uint64_t word)
+        {
+#if defined(__GNUC__) || defined(__clang__)
+            return static_cast<unsigned int>(__builtin_ctzll(word));
+#else
+            unsigned int bit = 0;
+            while ((word & 1) == 0)
+            {
+                word >>= 1;
+                bit++;
+            }
+            return bit;
+#endif
+        }
+    } // namespace detail
+
+    template <class Allocator = detail::default_allocator<std::uint64_t>>
+    class dynamic_bitset
+    {
+    public:
+        using word_type = std::uint64_t;
+        using storage_type = dynamic_array<word_type, Allocator>;
+        using allocator_type = Allocator;
+        using size_type = std::size_t;
+
+        static constexpr size_type bits_per_word = 64;
+        static constexpr size_type npos = static_cast<size_type>(-1);
+
+        // Proxy for one bit - behaves like a bool &
+        class reference
+        {
+            friend class dynamic_bitset;
+
+        public:
+            reference(const reference &) = default;
+
+            reference &operator=(bool value) noexcept
+            {
+                if (value)
+                    *m_word |= m_mask;
+                else
+                    *m_word &= ~m_mask;
+
+                return *this;
+            }
+
+            reference &operator=(const reference &other) noexcept { return *this = bool(other); }
+
+            operator bool() const noexcept { return (*m_word & m_mask) != 0; }
+            bool operator~() const noexcept { return (*m_word & m_mask) == 0; }
+
+            reference &flip() noexcept
+            {
+                *m_word ^= m_mask;
+                return *this;
+            }
+
+        private:
+            reference(word_type *word, word_type mask) noexcept : m_word(word), m_mask(mask) {}
+
+            word_type *m_word;
+            word_type m_mask;
+        };
+
+        // Constructors, Destructors; Gang of Four
+        // Copies are member-wise - the word array is copied
+
+        // Constructs size bits, all set to value
+        explicit dynamic_bitset(size_type size = 0, bool value = false, const Allocator &alloc = Allocator());
+
+        // Constructs a bitset with the bits of il, in the same order
+        dynamic_bitset(const std::initializer_list<bool> &i_list, const Allocator &alloc = Allocator());
+
+        ///
+        // Basic Operations
+        void push_back(bool value);
+        void pop_back();
+
+        // New bits are set to value
+        void resize(size_type size, bool value = false);
+
+        ///
+        // Access operations
+        // operator[] is checked according to DS_BOUNDS_CHECK, the named ones always throw std::out_of_range
+        bool operator[](size_type index) const;
+        reference operator[](size_type index);
+        bool test(size_type index) const;
+
+        void set(size_type index, bool value = true);
+        void reset(size_type index);
+        void flip(size_type index);
+
+        // Whole set operations
+        void set();
+        void reset();
+        void flip();
+
+        ///
+        // Word-at-a-time queries
+        size_type count() const;
+        bool all() const;
+        bool any() const;
+        bool none() const { return !any(); }
+
+        // Index of the first set bit, npos if there is none
+        size_type find_first() const { return find_from(0); }
+
+        // Index of the first set bit behind index, npos if there is none
+        size_type find_next(size_type index) const;
+
+        ///
+        // Bulk operations - both bitsets have to be of the same size
+        dynamic_bitset &operator&=(const dynamic_bitset &other);
+        dynamic_bitset &operator|=(const dynamic_bitset &other);
+        dynamic_bitset &operator^=(const dynamic_bitset &other);
+
+        // Clears the bits which are set in other (*this &= ~other without the temporary)
+        dynamic_bitset &and_not(const dynamic_bitset &other);
+
+        dynamic_bitset operator~() const;
+
+        friend dynamic_bitset operator&(dynamic_bitset lhs, const dynamic_bitset &rhs) { return lhs &= rhs; }
+        friend dynamic_bitset operator|(dynamic_bitset lhs, const dynamic_bitset &rhs) { return lhs |= rhs; }
+        friend dynamic_bitset operator^(dynamic_bitset lhs, const dynamic_bitset &rhs) { return lhs ^= rhs; }
+
+        // Comparison operators
+        bool operator==(const dynamic_bitset &other) const;
+
+        ///
+        // Remove operations
+        void clear() noexcept;
+
+        ///
+        // Capacity operations
+        void reserve(size_type new_capacity);
+        void shrink_to_fit();
+
+        size_type size() const noexcept { return m_size; }
+        size_type capacity() const { return m_words.capacity() * bits_per_word; }
+        size_type max_size() const { return m_words.max_size() < npos / bits_per_word ? m_words.max_size() * bits_per_word : npos - 1; }
+        bool empty() const noexcept { return m_size == 0; }
+        allocator_type get_allocator() const { return m_words.get_allocator(); }
+
+        // The packed words - bit i is bit (i % 64) of word i / 64
+        size_type num_words() const { return m_words.size(); }
+        const word_type *data() const noexcept { return m_words.data(); }
+
+    private:
+        storage_type m_words;
+        size_type m_size = 0;
+
+        ///
+        // Helpers
+    private:
+        static size_type words_for(size_type bits) { return bits / bits_per_word + (bits % bits_per_word != 0); }
+        static word_type mask_of(size_type index) { return word_type(1) << (index % bits_per_word); }
+
+        size_type find_from(size_type index) const;
+        void check_same_size(const dynamic_bitset &other) const;
+
+        // Clears the bits behind size() in the last word
+        void trim() noexcept;
+    };
+
+    // O(n) - Linear time
+    template <class Allocator>
+    inline dynamic_bitset<Allocator>::dynamic_bitset(size_type size, bool value, const Allocator &alloc)
+        : m_words(words_for(size) > 0 ? words_for(size) : 1, alloc)
+    {
+        resize(size, value);
+    }
+
+    // O(n) - Linear time
+    template <class Allocator>
+    inline dynamic_bitset<Allocator>::dynamic_bitset(const std::initializer_list<bool> &i_list, const Allocator &alloc)
+        : dynamic_bitset(i_list.size(), false, alloc)
+    {
+        size_type index = 0;
+        for (bool value : i_list)
+        {
+            if (value)
+                m_words.data()[index / bits_per_word] |= mask_of(index);
+            index++;
+        }
+    }
+
+    // O(1) - Amortized constant time
+    template <class Allocator>
+    inline void dynamic_bitset<Allocator>::push_back(bool value)
+    {
+        if (m_size % bits_per_word == 0)
+            m_words.push_back(0);
+
+        if (value)
+            m_words.data()[m_size / bits_per_word] |= mask_of(m_size);
+
+        m_size++;
+    }
+
+    // O(1) - Constant time
+    template <class Allocator>
+    inline void dynamic_bitset<Allocator>::pop_back()
+    {
+        if (m_size == 0)
+            throw std::logic_error("Invalid opration: Cannot pop from empty array!");
+
+        m_size--;
+        if (m_size % bits_per_word == 0)
+            m_words.pop_back();
+        else
+            trim();
+    }
+
+    // O(n) - Linear in the number of added or removed words
+    template <class Allocator>
+    inline void dynamic_bitset<Allocator>::resize(size_type size, bool value)
+    {
+        if (size > max_size())
+            throw std::length_error("Requested size exceeds max_size()!");
+
+        const size_type old_words = m_words.size();
+        const size_type new_words = words_for(size);
+
+        if (size > m_size)
+        {
+            // The rest of the last word is zero - set the part which becomes visible
+            if (value && m_size % bits_per_word != 0)
+                m_words.data()[old_words - 1] |= ~word_type(0) << (m_size % bits_per_word);
+
+            const word_type fill = value ? ~word_type(0) : 0;
+            m_words.append(detail::repeat_iterator<word_type>(fill, 0), detail::repeat_iterator<word_type>(fill, new_words - old_words));
+        }
+        else
+        {
+            m_words.erase(new_words, old_words);
+        }
+
+        m_size = size;
+        trim();
+    }
+
+    // O(1) - Constant time
+    template <class Allocator>
+    inline bool dynamic_bitset<Allocator>::operator[](size_type index) const
+    {
+        detail::check_subscript(index, m_size); // Policy selected by DS_BOUNDS_CHECK
+        return (m_words.data()[index / bits_per_word] & mask_of(index)) != 0;
+    }
+
+    // O(1) - Constant time
+    template <class Allocator>
+    inline typename dynamic_bitset<Allocator>::reference dynamic_bitset<Allocator>::operator[](size_type index)
+    {
+        detail::check_subscript(index, m_size); // Policy selected by DS_BOUNDS_CHECK
+        return reference(m_words.data() + index / bits_per_word, mask_of(index));
+    }
+
+    // O(1) - Constant time
+    template <class Allocator>
+    inline bool dynamic_bitset<Allocator>::test(size_type index) const
+    {
+        if (index >= m_size)
+            throw std::out_of_range("Invalid index!");
+
+        return (m_words.data()[index / bits_per_word] & mask_of(index)) != 0;
+    }
+
+    // O(1) - Constant time
+    template <class Allocator>
+    inline void dynamic_bitset<Allocator>::set(size_type index, bool value)
+    {
+        if (index >= m_size)
+            throw std::out_of_range("Invalid index!");
+
+        reference(m_words.data() + index / bits_per_word, mask_of(index)) = value;
+    }
+
+    // O(1) - Constant time
+    template <class Allocator>
+    inline void dynamic_bitset<Allocator>::reset(size_type index)
+    {
+        set(index, false);
+    }
+
+    // O(1) - Constant time
+    template <class Allocator>
+    inline void dynamic_bitset<Allocator>::flip(size_type index)
+    {
+        if (index >= m_size)
+            throw std::out_of_range("Invalid index!");
+
+        m_words.data()[index / bits_per_word] ^= mask_of(index);
+    }
+
+    // O(n / 64) - Linear in the number of words
+    template <class Allocator>
+    inline void dynamic_bitset<Allocator>::set()
+    {
+        word_type *words = m_words.data();
+        for (size_type i = 0; i < m_words.size(); i++)
+            words[i] = ~word_type(0);
+
+        trim();
+    }
+
+    // O(n / 64) - Linear in the number of words
+    template <class Allocator>
+    inline void dynamic_bitset<Allocator>::reset()
+    {
+        word_type *words = m_words.data();
+        for (size_type i = 0; i < m_words.size(); i++)
+            words[i] = 0;
+    }
+
+    // O(n / 64) - Linear in the number of words
+    template <class Allocator>
+    inline void dynamic_bitset<Allocator>::flip()
+    {
+        word_type *words = m_words.data();
+        for (size_type i = 0; i < m_words.size(); i++)
+            words[i] = ~words[i];
+
+        trim();
+    }
+
+    // O(n / 64) - Linear in the number of words
+    template <class Allocator>
+    inline typename dynamic_bitset<Allocator>::size_type dynamic_bitset<Allocator>::count() const
+    {
+        return detail::simd::popcount(m_words.data(), m_words.size());
+    }
+
+    // O(n / 64) - Linear in the number of words
+    template <class Allocator>
+    inline bool dynamic_bitset<Allocator>::all() const
+    {
+        const word_type *words = m_words.data();
+        const size_type full = m_size / bits_per_word;
+
+        for (size_type i = 0; i < full; i++)
+        {
+            if (words[i] != ~word_type(0))
+                return false;
+        }
+
+        return m_size % bits_per_word == 0 || words[full] == ~(~word_type(0) << (m_size % bits_per_word));
+    }
+
+    // O(n / 64) - Linear in the number of words
+    template <class Allocator>
+    inline bool dynamic_bitset<Allocator>::any() const
+    {
+        return find_from(0) != npos;
+    }
+
+    // O(n / 64) - Linear in the number of words behind index
+    template <class Allocator>
+    inline typename dynamic_bitset<Allocator>::size_type dynamic_bitset<Allocator>::find_next(size_type index) const
+    {
+        if (index >= m_size)
+            return npos;
+
+        return find_from(index + 1);
+    }
+
+    // O(n / 64) - Linear in the number of words
+    template <class Allocator>
+    inline dynamic_bitset<Allocator> &dynamic_bitset<Allocator>::operator&=(const dynamic_bitset &other)
+    {
+        check_same_size(other);
+        detail::simd::bitwise<detail::simd::bit_op::and_>(m_words.data(), other.m_words.data(), m_words.size());
+        return *this;
+    }
+
+    // O(n / 64) - Linear in the number of words
+    template <class Allocator>
+    inline dynamic_bitset<Allocator> &dynamic_bitset<Allocator>::operator|=(const dynamic_bitset &other)
+    {
+        check_same_size(other);
+        detail::simd::bitwise<detail::simd::bit_op::or_>(m_words.data(), other.m_words.data(), m_words.size());
+        return *this;
+    }
+
+    // O(n / 64) - Linear in the number of words
+    template <class Allocator>
+    inline dynamic_bitset<Allocator> &dynamic_bitset<Allocator>::operator^=(const dynamic_bitset &other)
+    {
+        check_same_size(other);
+        detail::simd::bitwise<detail::simd::bit_op::xor_>(m_words.data(), other.m_words.data(), m_words.size());
+        return *this;
+    }
+
+    // O(n / 64) - Linear in the number of words
+    template <class Allocator>
+    inline dynamic_bitset<Allocator> &dynamic_bitset<Allocator>::and_not(const dynamic_bitset &other)
+    {
+        check_same_size(other);
+        detail::simd::bitwise<detail::simd::bit_op::and_not>(m_words.data(), other.m_words.data(), m_words.size());
+        return *this;
+    }
+
+    // O(n / 64) - Linear in the number of words
+    template <class Allocator>
+    inline dynamic_bitset<Allocator> dynamic_bitset<Allocator>::operator~() const
+    {
+        dynamic_bitset copy(*this);
+        copy.flip();
+        return copy;
+    }
+
+    // O(n / 64) - Linear in the number of words
+    template <class Allocator>
+    inline bool dynamic_bitset<Allocator>::operator==(const dynamic_bitset &other) const
+    {
+        // The unused bits are zero in both - equal bits mean equal words
+        return m_size == other.m_size && m_words == other.m_words;
+    }
+
+    // O(1) - Constant time
+    template <class Allocator>
+    inline void dynamic_bitset<Allocator>::clear() noexcept
+    {
+        m_words.clear();
+        m_size = 0;
+    }
+
+    // O(n / 64) - Linear time, if the capacity grows
+    template <class Allocator>
+    inline void dynamic_bitset<Allocator>::reserve(size_type new_capacity)
+    {
+        if (new_capacity > max_size())
+            throw std::length_error("Requested capacity exceeds max_size()!");
+
+        m_words.reserve(words_for(new_capacity));
+    }
+
+    // O(n / 64) - Linear in the number of words
+    template <class Allocator>
+    inline void dynamic_bitset<Allocator>::shrink_to_fit()
+    {
+        m_words.shrink_to_fit();
+    }
+
+    ///
+    // Helpers
+
+    // First set bit at or behind index
+    template <class Allocator>
+    inline typename dynamic_bitset<Allocator>::size_type dynamic_bitset<Allocator>::find_from(size_type index) const
+    {
+        if (index >= m_size)
+            return npos;
+
+        const word_type *words = m_words.data();
+        size_type word = index / bits_per_word;
+
+        // The bits in front of index are masked off in the first word only
+        word_type bits = words[word] & (~word_type(0) << (index % bits_per_word));
+        while (bits == 0)
+        {
+            if (++word == m_words.size())
+                return npos;
+
+            bits = words[word];
+        }
+
+        return word * bits_per_word + detail::lowest_bit(bits);
+    }
+
+    template <class Allocator>
+    inline void dynamic_bitset<Allocator>::check_same_size(const dynamic_bitset &other) const
+    {
+        if (m_size != other.m_size)
+            throw std::invalid_argument("dynamic_bitset: Sizes of the operands differ!");
+    }
+
+    template <class Allocator>
+    inline void dynamic_bitset<Allocator>::trim() noexcept
+    {
+        if (m_size % bits_per_word != 0)
+            m_words.data()[m_words.size() - 1] &= ~(~word_type(0) << (m_size % bits_per_word));
+    }
+
+} // namespace ds
+
+#endif // DYNAMIC_BITSET_GUARD
@@ -0,0 +1,206 @@
+#define CATCH_CONFIG_MAIN
+#include "../Catch2/catch.hpp"
+#include "dynamic_bitset.hpp"
+
+#include <random>
+#include <vector>
+
+using namespace ds;
+
+TEST_CASE("CONSTRUCTORS", "[CONSTRUCTOR]")
+{
+    dynamic_bitset<> def;
+
+    REQUIRE(def.size() == 0);
+    REQUIRE(def.empty());
+    REQUIRE(def.num_words() == 0);
+    REQUIRE(def.none());
+    REQUIRE(def.all());
+    REQUIRE(def.find_first() == dynamic_bitset<>::npos);
+    REQUIRE_THROWS(def.test(0));
+    REQUIRE_THROWS(def.pop_back());
+
+    dynamic_bitset<> ones(130, true);
+    REQUIRE(ones.size() == 130);
+    REQUIRE(ones.num_words() == 3);
+    REQUIRE(ones.count() == 130);
+    REQUIRE(ones.all());
+    REQUIRE(ones.data()[2] == 0x3); // The bits behind size() stay zero
+
+    dynamic_bitset<> foo = {true, false, true, true};
+    REQUIRE(foo.size() == 4);
+    REQUIRE(foo[0]);
+    REQUIRE_FALSE(foo[1]);
+    REQUIRE(foo.count() == 3);
+
+    dynamic_bitset<> bar(foo);
+    REQUIRE(bar == foo);
+    bar.flip(1);
+    REQUIRE_FALSE(foo[1]);
+    REQUIRE_FALSE(bar == foo);
+
+    bar = foo;
+    REQUIRE(bar == foo);
+}
+
+TEST_CASE("DEFAULT OPERATIONS", "[OPERATIONS]")
+{
+    dynamic_bitset<> foo;
+
+    SECTION("PUSH AND POP ACROSS WORDS")
+    {
+        for (int i = 0; i < 200; i++)
+            foo.push_back(i % 3 == 0);
+
+        REQUIRE(foo.size() == 200);
+        REQUIRE(foo.num_words() == 4);
+        REQUIRE(foo.count() == 67);
+        REQUIRE(foo.test(198));
+        REQUIRE_FALSE(foo.test(199));
+
+        for (int i = 0; i < 72; i++)
+            foo.pop_back();
+
+        REQUIRE(foo.size() == 128);
+        REQUIRE(foo.num_words() == 2);
+        REQUIRE(foo.count() == 43);
+    }
+
+    SECTION("PROXY REFERENCES")
+    {
+        foo.resize(70);
+        foo[3] = true;
+        foo[69] = foo[3];
+        REQUIRE(foo.test(69));
+        REQUIRE(~foo[68]);
+
+        foo[3].flip();
+        REQUIRE_FALSE(foo[3]);
+
+        dynamic_bitset<>::reference ref = foo[10];
+        ref = true;
+        REQUIRE(foo.test(10));
+        REQUIRE(foo.count() == 2);
+
+        foo.set(11);
+        foo.reset(10);
+        foo.flip(12);
+        REQUIRE(foo.count() == 3);
+        REQUIRE_THROWS_AS(foo.set(70), std::out_of_range);
+    }
+
+    SECTION("RESIZE")
+    {
+        foo.resize(10, true);
+        foo.resize(100, false);
+        REQUIRE(foo.count() == 10);
+
+        foo.resize(150, true);
+        REQUIRE(foo.count() == 60);
+        REQUIRE_FALSE(foo[99]);
+        REQUIRE(foo[100]);
+
+        foo.resize(5);
+        REQUIRE(foo.count() == 5);
+        foo.resize(64, false);
+        REQUIRE(foo.count() == 5); // Shrinking cleared the bits it dropped
+    }
+
+    SECTION("WHOLE SET")
+    {
+        foo.resize(77);
+        foo.set();
+        REQUIRE(foo.all());
+        REQUIRE(foo.count() == 77);
+
+        foo.flip();
+        REQUIRE(foo.none());
+
+        foo.set(40);
+        foo.reset();
+        REQUIRE_FALSE(foo.any());
+    }
+}
+
+TEST_CASE("SEARCH", "[SEARCH]")
+{
+    dynamic_bitset<> foo(1000);
+    const std::vector<std::size_t> positions = {0, 5, 63, 64, 65, 300, 999};
+    for (std::size_t pos : positions)
+        foo.set(pos);
+
+    std::vector<std::size_t> found;
+    for (std::size_t pos = foo.find_first(); pos != dynamic_bitset<>::npos; pos = foo.find_next(pos))
+        found.push_back(pos);
+
+    REQUIRE(found == positions);
+    REQUIRE(foo.find_next(999) == dynamic_bitset<>::npos);
+    REQUIRE(foo.find_next(5000) == dynamic_bitset<>::npos);
+
+    foo.reset(0);
+    REQUIRE(foo.find_first() == 5);
+}
+
+TEST_CASE("BULK OPERATIONS", "[OPERATIONS]")
+{
+    // Odd sizes exercise the vector loops and their scalar tails
+    std::mt19937 gen(3);
+    for (std::size_t size : {1u, 63u, 64u, 65u, 130u, 513u, 4099u})
+    {
+        dynamic_bitset<> lhs(size), rhs(size);
+        std::vector<bool> lbits(size), rbits(size);
+        for (std::size_t i = 0; i < size; i++)
+        {
+            lbits[i] = gen() % 2;
+            rbits[i] = gen() % 3 == 0;
+            lhs[i] = lbits[i];
+            rhs[i] = rbits[i];
+        }
+
+        const dynamic_bitset<> both = lhs & rhs;
+        const dynamic_bitset<> either = lhs | rhs;
+        const dynamic_bitset<> one = lhs ^ rhs;
+        const dynamic_bitset<> inverted = ~lhs;
+        dynamic_bitset<> only_left(lhs);
+        only_left.and_not(rhs);
+
+        bool matches = true;
+        std::size_t expected_count = 0;
+        for (std::size_t i = 0; i < size; i++)
+        {
+            matches = matches && both[i] == (lbits[i] && rbits[i]);
+            matches = matches && either[i] == (lbits[i] || rbits[i]);
+            matches = matches && one[i] == (lbits[i] != rbits[i]);
+            matches = matches && only_left[i] == (lbits[i] && !rbits[i]);
+            matches = matches && inverted[i] == !lbits[i];
+            expected_count += lbits[i];
+        }
+
+        REQUIRE(matches);
+        REQUIRE(lhs.count() == expected_count);
+        REQUIRE(inverted.count() == size - expected_count);
+        REQUIRE((lhs ^ lhs).none());
+    }
+
+    dynamic_bitset<> small(10), large(11);
+    REQUIRE_THROWS_AS(small &= large, std::invalid_argument);
+    REQUIRE_THROWS_AS(small.and_not(large), std::invalid_argument);
+}
+
+TEST_CASE("STORAGE", "[STORAGE]")
+{
+    dynamic_bitset<> foo(1 << 20);
+    REQUIRE(foo.num_words() == (1 << 20) / 64);
+    REQUIRE(foo.capacity() >= foo.size());
+    REQUIRE(reinterpret_cast<std::uintptr_t>(foo.data()) % 64 == 0);
+
+    foo.reserve(foo.size() + 1000);
+    REQUIRE(foo.capacity() >= foo.size() + 1000);
+
+    foo.clear();
+    foo.shrink_to_fit();
+    REQUIRE(foo.capacity() == 0);
+
+    foo.push_back(true);
+    REQUIRE(foo.count() == 1);
+}
@@ -0,0 +1,394 @@
+#ifndef FLAT_MAP_GUARD
+#define FLAT_MAP_GUARD
+
+/*
+ *  Sorted map with unique keys. Keys and values are kept in two parallel
+ *  dynamic_arrays, so a lookup binary-searches densely packed keys without
+ *  pulling the values through the cache; the value is touched once, at the
+ *  index found.
+ *
+ *  As in flat_set, single inserts and erases shift the tail (O(n)) and
+ *  batches go through insert(first, last), which sorts the batch and merges
+ *  it with the map once. Positions are indices - key_at(i) / value_at(i) -
+ *  and npos means "not found".
+*/
+
+#include "dynamic_array.hpp" // Key and value storage
+#include "flat_set.hpp"      // Branchless searches
+
+#include <algorithm>        // std::stable_sort
+#include <cstddef>          // std::size_t
+#include <functional>       // std::less
+#include <initializer_list> // Pair lists
+#include <stdexcept>        // std::out_of_range
+#include <type_traits>      // Pair move strategy selection
+#include <utility>          // std::pair
+
+namespace ds
+{
+    template <class Key, class T, class Compare = std::less<Key>,
+              class KeyAllocator = detail::default_allocator<Key>, class MappedAllocator = detail::default_allocator<T>>
+    class flat_map
+    {
+    public:
+        using key_storage = dynamic_array<Key, KeyAllocator>;
+        using mapped_storage = dynamic_array<T, MappedAllocator>;
+
+        using key_type = Key;
+        using mapped_type = T;
+        using value_type = std::pair<Key, T>;
+        using key_compare = Compare;
+        using size_type = std::size_t;
+
+        static constexpr size_type npos = key_storage::npos;
+
+        // Constructors, Destructors; Gang of Four
+        // Copies are member-wise - both arrays are copied
+
+        // Constructs an empty map
+        explicit flat_map(const Compare &comp = Compare(), const KeyAllocator &key_alloc = KeyAllocator(),
+                          const MappedAllocator &mapped_alloc = MappedAllocator());
+
+        // Constructs a map of the pairs in il - the first of equivalent keys wins
+        flat_map(const std::initializer_list<value_type> &i_list, const Compare &comp = Compare());
+
+        // Constructs a map of the pairs in [first, last) - the first of equivalent keys wins
+        template <class InputIt>
+        flat_map(InputIt first, InputIt last, const Compare &comp = Compare());
+
+        ///
+        // Modifiers
+
+        // Constructs the value from args unless key is present - returns its index and whether it was inserted
+        template <class K, class... Args>
+        std::pair<size_type, bool> try_emplace(K &&key, Args &&...args);
+
+        std::pair<size_type, bool> insert(const value_type &pair) { return try_emplace(pair.first, pair.second); }
+        std::pair<size_type, bool> insert(value_type &&pair) { return try_emplace(std::move(pair.first), std::move(pair.second)); }
+
+        // Inserts, or assigns to the value of a present key
+        template <class V>
+        std::pair<size_type, bool> insert_or_assign(const Key &key, V &&value);
+
+        // Bulk insert - sorts the batch and merges it with the map once, O(n + k log k).
+        // Keys already present keep their values, the first of equivalent keys in the batch wins.
+        template <class InputIt>
+        void insert(InputIt first, InputIt last);
+        void insert(const std::initializer_list<value_type> &i_list) { insert(i_list.begin(), i_list.end()); }
+
+        // Removes key and its value - returns the number of removed pairs (0 or 1)
+        size_type erase(const Key &key);
+
+        // Removes the pairs at index, or in [first, last)
+        void erase_at(size_type index);
+        void erase_at(size_type first, size_type last);
+
+        void clear();
+
+        ///
+        // Lookup - O(log n)
+        size_type find(const Key &key) const;
+        size_type count(const Key &key) const { return find(key) != npos; }
+        bool contains(const Key &key) const { return find(key) != npos; }
+
+        // Index of the first key not less than (lower_bound) or greater than (upper_bound) key
+        size_type lower_bound(const Key &key) const { return detail::lower_bound_index(m_keys.data(), m_keys.size(), key, m_comp); }
+        size_type upper_bound(const Key &key) const { return detail::upper_bound_index(m_keys.data(), m_keys.size(), key, m_comp); }
+
+        // Indices [first, last) of the keys in [low, high)
+        std::pair<size_type, size_type> range(const Key &low, const Key &high) const;
+
+        ///
+        // Access operations
+
+        // Value of key, default constructed and inserted if key is not present
+        T &operator[](const Key &key) { return m_values[try_emplace(key).first]; }
+
+        // Value of key, throws std::out_of_range if key is not present
+        const T &at(const Key &key) const;
+        T &at(const Key &key);
+
+        // The pair at index, in key order
+        const Key &key_at(size_type index) const { return m_keys[index]; }
+        const T &value_at(size_type index) const { return m_values[index]; }
+        T &value_at(size_type index) { return m_values[index]; }
+
+        // The sorted keys and their values at the same indices
+        const key_storage &keys() const noexcept { return m_keys; }
+        const mapped_storage &values() const noexcept { return m_values; }
+
+        ///
+        // Capacity operations
+        void reserve(size_type new_capacity);
+        void shrink_to_fit();
+
+        size_type size() const { return m_keys.size(); }
+        size_type capacity() const { return m_keys.capacity(); }
+        bool empty() const { return m_keys.empty(); }
+        key_compare key_comp() const { return m_comp; }
+
+        // Comparison operators
+        bool operator==(const flat_map &other) const { return m_keys == other.m_keys && m_values == other.m_values; }
+
+    private:
+        key_storage m_keys;
+        mapped_storage m_values;
+        Compare m_comp;
+
+        ///
+        // Helpers
+    private:
+        // dynamic_array::emplace only accepts positions in front of an element
+        template <class Array, class... Args>
+        static void emplace_at(Array &array, size_type index, Args &&...args);
+
+        // A pair is moved out of the map only if neither half can throw on the move - moving the key
+        // and then failing to copy its value would leave a moved-from key behind
+        static constexpr bool nothrow_pair_move = std::is_nothrow_move_constructible_v<Key> && std::is_nothrow_move_constructible_v<T>;
+
+        // el as an rvalue if the pairs move (or it can only be moved), as an lvalue to be copied otherwise
+        template <class U>
+        static decltype(auto) relocated(U &el) noexcept;
+    };
+
+    // O(1) - Constant time
+    template <class Key, class T, class Compare, class KeyAllocator, class MappedAllocator>
+    inline flat_map<Key, T, Compare, KeyAllocator, MappedAllocator>::flat_map(const Compare &comp, const KeyAllocator &key_alloc,
+                                                                               const MappedAllocator &mapped_alloc)
+        : m_keys(key_alloc), m_values(mapped_alloc), m_comp(comp)
+    {
+    }
+
+    // O(n log n) - Linearithmic time
+    template <class Key, class T, class Compare, class KeyAllocator, class MappedAllocator>
+    inline flat_map<Key, T, Compare, KeyAllocator, MappedAllocator>::flat_map(const std::initializer_list<value_type> &i_list, const Compare &comp)
+        : flat_map(i_list.begin(), i_list.end(), comp)
+    {
+    }
+
+    // O(n log n) - Linearithmic time
+    template <class Key, class T, class Compare, class KeyAllocator, class MappedAllocator>
+    template <class InputIt>
+    inline flat_map<Key, T, Compare, KeyAllocator, MappedAllocator>::flat_map(InputIt first, InputIt last, const Compare &comp)
+        : flat_map(comp)
+    {
+        insert(first, last);
+    }
+
+    // O(n) - Linear time (the pairs behind it are shifted)
+    template <class Key, class T, class Compare, class KeyAllocator, class MappedAllocator>
+    template <class K, class... Args>
+    inline std::pair<typename flat_map<Key, T, Compare, KeyAllocator, MappedAllocator>::size_type, bool>
+    flat_map<Key, T, Compare, KeyAllocator, MappedAllocator>::try_emplace(K &&key, Args &&...args)
+    {
+        const size_type index = lower_bound(key);
+        if (index < m_keys.size() && !m_comp(key, m_keys.data()[index]))
+            return {index, false};
+
+        emplace_at(m_keys, index, std::forward<K>(key));
+        try
+        {
+            emplace_at(m_values, index, std::forward<Args>(args)...);
+        }
+        catch (...)
+        {
+            m_keys.erase(index); // Keep both arrays of the same length
+            throw;
+        }
+
+        return {index, true};
+    }
+
+    // O(n) - Linear time, O(log n) if key is present
+    template <class Key, class T, class Compare, class KeyAllocator, class MappedAllocator>
+    template <class V>
+    inline std::pair<typename flat_map<Key, T, Compare, KeyAllocator, MappedAllocator>::size_type, bool>
+    flat_map<Key, T, Compare, KeyAllocator, MappedAllocator>::insert_or_assign(const Key &key, V &&value)
+    {
+        const size_type index = find(key);
+        if (index != npos)
+        {
+            m_values[index] = std::forward<V>(value);
+            return {index, false};
+        }
+
+        return try_emplace(key, std::forward<V>(value));
+    }
+
+    // O(n + k log k) - Linear in the pairs, linearithmic in the batch
+    template <class Key, class T, class Compare, class KeyAllocator, class MappedAllocator>
+    template <class InputIt>
+    inline void flat_map<Key, T, Compare, KeyAllocator, MappedAllocator>::insert(InputIt first, InputIt last)
+    {
+        dynamic_array<value_type> batch;
+        batch.append(first, last);
+
+        const size_type count = batch.size();
+        if (count == 0)
+            return;
+
+        // Stable - the first of equivalent keys stays in front and is the one merged
+        value_type *pairs = batch.data();
+        std::stable_sort(pairs, pairs + count, [this](const value_type &lhs, const value_type &rhs)
+                         { return m_comp(lhs.first, rhs.first); });
+
+        // Merged into new arrays in one pass - the old ones stay intact until the swap (strong guarantee
+        // as long as the pairs are nothrow movable, they are copied otherwise)
+        const size_type old_size = m_keys.size();
+        key_storage keys(old_size + count, m_keys.get_allocator());
+        mapped_storage values(old_size + count, m_values.get_allocator());
+
+        Key *old_keys = m_keys.data();
+        T *old_values = m_values.data();
+        size_type i = 0, j = 0;
+
+        while (i < old_size || j < count)
+        {
+            // A present key is taken first on ties - it wins over the batch
+            if (j == count || (i < old_size && !m_comp(pairs[j].first, old_keys[i])))
+            {
+                keys.push_back(relocated(old_keys[i]));
+                values.push_back(relocated(old_values[i]));
+                i++;
+            }
+            else
+            {
+                keys.push_back(std::move(pairs[j].first));
+                values.push_back(std::move(pairs[j].second));
+                j++;
+            }
+
+            // Skip the batch keys equivalent to the one just taken
+            while (j < count && !m_comp(keys.back(), pairs[j].first))
+                j++;
+        }
+
+        swap(m_keys, keys);
+        swap(m_values, values);
+    }
+
+    // O(n) - Linear time (the pairs behind it are shifted)
+    template <class Key, class T, class Compare, class KeyAllocator, class MappedAllocator>
+    inline typename flat_map<Key, T, Compare, KeyAllocator, MappedAllocator>::size_type
+    flat_map<Key, T, Compare, KeyAllocator, MappedAllocator>::erase(const Key &key)
+    {
+        const size_type index = find(key);
+        if (index == npos)
+            return 0;
+
+        erase_at(index);
+        return 1;
+    }
+
+    // O(n) - Linear time
+    template <class Key, class T, class Compare, class KeyAllocator, class MappedAllocator>
+    inline void flat_map<Key, T, Compare, KeyAllocator, MappedAllocator>::erase_at(size_type index)
+    {
+        m_keys.erase(index);
+        m_values.erase(index);
+    }
+
+    // O(n) - Linear time
+    template <class Key, class T, class Compare, class KeyAllocator, class MappedAllocator>
+    inline void flat_map<Key, T, Compare, KeyAllocator, MappedAllocator>::erase_at(size_type first, size_type last)
+    {
+        m_keys.erase(first, last);
+        m_values.erase(first, last);
+    }
+
+    // O(n) - Linear time (destructors of the stored pairs)
+    template <class Key, class T, class Compare, class KeyAllocator, class MappedAllocator>
+    inline void flat_map<Key, T, Compare, KeyAllocator, MappedAllocator>::clear()
+    {
+        m_keys.clear();
+        m_values.clear();
+    }
+
+    // O(log n) - Logarithmic time
+    template <class Key, class T, class Compare, class KeyAllocator, class MappedAllocator>
+    inline typename flat_map<Key, T, Compare, KeyAllocator, MappedAllocator>::size_type
+    flat_map<Key, T, Compare, KeyAllocator, MappedAllocator>::find(const Key &key) const
+    {
+        const size_type index = lower_bound(key);
+        if (index == m_keys.size() || m_comp(key, m_keys.data()[index]))
+            return npos;
+
+        return index;
+    }
+
+    // O(log n) - Logarithmic time
+    template <class Key, class T, class Compare, class KeyAllocator, class MappedAllocator>
+    inline std::pair<typename flat_map<Key, T, Compare, KeyAllocator, MappedAllocator>::size_type,
+                     typename flat_map<Key, T, Compare, KeyAllocator, MappedAllocator>::size_type>
+    flat_map<Key, T, Compare, KeyAllocator, MappedAllocator>::range(const Key &low, const Key &high) const
+    {
+        const size_type first = lower_bound(low);
+        const size_type last = m_comp(low, high) ? lower_bound(high) : first;
+
+        return {first, last};
+    }
+
+    // O(log n) - Logarithmic time
+    template <class Key, class T, class Compare, class KeyAllocator, class MappedAllocator>
+    inline const T &flat_map<Key, T, Compare, KeyAllocator, MappedAllocator>::at(const Key &key) const
+    {
+        const size_type index = find(key);
+        if (index == npos)
+            throw std::out_of_range("flat_map: Key not found!");
+
+        return m_values[index];
+    }
+
+    // O(log n) - Logarithmic time
+    template <class Key, class T, class Compare, class KeyAllocator, class MappedAllocator>
+    inline T &flat_map<Key, T, Compare, KeyAllocator, MappedAllocator>::at(const Key &key)
+    {
+        const size_type index = find(key);
+        if (index == npos)
+            throw std::out_of_range("flat_map: Key not found!");
+
+        return m_values[index];
+    }
+
+    // O(n) - Linear time, if the capacity grows
+    template <class Key, class T, class Compare, class KeyAllocator, class MappedAllocator>
+    inline void flat_map<Key, T, Compare, KeyAllocator, MappedAllocator>::reserve(size_type new_capacity)
+    {
+        m_keys.reserve(new_capacity);
+        m_values.reserve(new_capacity);
+    }
+
+    // O(n) - Linear time
+    template <class Key, class T, class Compare, class KeyAllocator, class MappedAllocator>
+    inline void flat_map<Key, T, Compare, KeyAllocator, MappedAllocator>::shrink_to_fit()
+    {
+        m_keys.shrink_to_fit();
+        m_values.shrink_to_fit();
+    }
+
+    ///
+    // Helpers
+
+    template <class Key, class T, class Compare, class KeyAllocator, class MappedAllocator>
+    template <class Array, class... Args>
+    inline void flat_map<Key, T, Compare, KeyAllocator, MappedAllocator>::emplace_at(Array &array, size_type index, Args &&...args)
+    {
+        if (index == array.size())
+            array.emplace_back(std::forward<Args>(args)...);
+        else
+            array.emplace(index, std::forward<Args>(args)...);
+    }
+
+    template <class Key, class T, class Compare, class KeyAllocator, class MappedAllocator>
+    template <class U>
+    inline decltype(auto) flat_map<Key, T, Compare, KeyAllocator, MappedAllocator>::relocated(U &el) noexcept
+    {
+        if constexpr (nothrow_pair_move || !std::is_copy_constructible_v<U>)
+            return std::move(el);
+        else
+            return static_cast<const U &>(el);
+    }
+
+} // namespace ds
+
+#endif // FLAT_MAP_GUARD
@@ -0,0 +1,193 @@
+#define CATCH_CONFIG_MAIN
+#include "../Catch2/catch.hpp"
+#include "flat_map.hpp"
+
+#include <map>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace ds;
+
+TEST_CASE("CONSTRUCTORS", "[CONSTRUCTOR]")
+{
+    flat_map<int, std::string> def;
+
+    REQUIRE(def.size() == 0);
+    REQUIRE(def.empty());
+    REQUIRE(def.find(1) == flat_map<int, std::string>::npos);
+    REQUIRE_THROWS_AS(def.at(1), std::out_of_range);
+
+    flat_map<int, std::string> foo = {{3, "c"}, {1, "a"}, {2, "b"}, {1, "z"}};
+    REQUIRE(foo.size() == 3);
+    REQUIRE(foo.keys() == dynamic_array<int>{1, 2, 3});
+    REQUIRE(foo.at(1) == "a"); // The first of equivalent keys wins
+
+    flat_map<int, std::string> copy(foo);
+    REQUIRE(copy == foo);
+    copy[2] = "x";
+    REQUIRE(foo.at(2) == "b");
+    REQUIRE_FALSE(copy == foo);
+}
+
+TEST_CASE("DEFAULT OPERATIONS", "[OPERATIONS]")
+{
+    flat_map<std::string, int> foo = {{"b", 2}, {"d", 4}};
+
+    SECTION("INSERT")
+    {
+        REQUIRE(foo.insert({"c", 3}) == std::make_pair(std::size_t(1), true));
+        REQUIRE(foo.insert({"c", 30}) == std::make_pair(std::size_t(1), false));
+        REQUIRE(foo.at("c") == 3);
+
+        REQUIRE(foo.try_emplace("a", 1).first == 0);
+        REQUIRE(foo.insert_or_assign("c", 33) == std::make_pair(std::size_t(2), false));
+        REQUIRE(foo.insert_or_assign("e", 5) == std::make_pair(std::size_t(4), true));
+
+        REQUIRE(foo.keys() == dynamic_array<std::string>{"a", "b", "c", "d", "e"});
+        REQUIRE(foo.values() == dynamic_array<int>{1, 2, 33, 4, 5});
+    }
+
+    SECTION("SUBSCRIPT")
+    {
+        foo["a"] += 10;
+        foo["d"] += 10;
+        REQUIRE(foo.size() == 3);
+        REQUIRE(foo.at("a") == 10);
+        REQUIRE(foo.at("d") == 14);
+
+        for (std::size_t i = 0; i < foo.size(); i++)
+            foo.value_at(i) *= 2;
+        REQUIRE(foo.values() == dynamic_array<int>{20, 4, 28});
+        REQUIRE(foo.key_at(1) == "b");
+    }
+
+    SECTION("ERASE")
+    {
+        REQUIRE(foo.erase("b") == 1);
+        REQUIRE(foo.erase("b") == 0);
+        REQUIRE(foo.size() == 1);
+        REQUIRE(foo.values().size() == 1);
+
+        foo.insert({{"x", 1}, {"y", 2}, {"z", 3}});
+        foo.erase_at(1, 3);
+        REQUIRE(foo.keys() == dynamic_array<std::string>{"d", "z"});
+        REQUIRE(foo.values() == dynamic_array<int>{4, 3});
+
+        foo.clear();
+        REQUIRE(foo.empty());
+        REQUIRE(foo.values().empty());
+    }
+
+    SECTION("RANGE QUERIES")
+    {
+        foo.insert({{"a", 1}, {"c", 3}, {"e", 5}});
+
+        const auto range = foo.range("b", "e");
+        REQUIRE(range == std::make_pair(std::size_t(1), std::size_t(4)));
+        REQUIRE(foo.lower_bound("bb") == 2);
+        REQUIRE(foo.upper_bound("e") == 5);
+
+        int sum = 0;
+        for (std::size_t i = range.first; i < range.second; i++)
+            sum += foo.value_at(i);
+        REQUIRE(sum == 2 + 3 + 4);
+    }
+}
+
+// Copies and moves throw once the budget runs out (a negative budget never runs out)
+struct Fragile
+{
+    static int budget;
+
+    Fragile(int value) : value(value) {}
+    Fragile(const Fragile &other) : value(other.value) { spend(); }
+    Fragile(Fragile &&other) : value(other.value) { spend(); }
+    Fragile &operator=(const Fragile &other) = default;
+
+    static void spend()
+    {
+        if (budget-- == 0)
+            throw std::runtime_error("copy");
+    }
+
+    int value;
+};
+
+int Fragile::budget = -1;
+
+TEST_CASE("BULK INSERT", "[OPERATIONS]")
+{
+    flat_map<int, int> foo = {{10, 1}, {20, 2}};
+
+    SECTION("PRESENT KEYS KEEP THEIR VALUES")
+    {
+        foo.insert({{20, 200}, {5, 50}, {15, 150}, {5, 51}, {30, 300}});
+        REQUIRE(foo.keys() == dynamic_array<int>{5, 10, 15, 20, 30});
+        REQUIRE(foo.values() == dynamic_array<int>{50, 1, 150, 2, 300});
+    }
+
+    SECTION("AGAINST STD::MAP")
+    {
+        std::mt19937 gen(5);
+        std::map<int, int> expected = {{10, 1}, {20, 2}};
+
+        for (int round = 0; round < 20; round++)
+        {
+            std::vector<std::pair<int, int>> batch(gen() % 300);
+            for (auto &pair : batch)
+                pair = {static_cast<int>(gen() % 2000), static_cast<int>(gen())};
+
+            foo.insert(batch.begin(), batch.end());
+            expected.insert(batch.begin(), batch.end()); // Also keeps the first of equivalent keys
+        }
+
+        REQUIRE(foo.size() == expected.size());
+
+        bool same = true;
+        std::size_t index = 0;
+        for (const auto &[key, value] : expected)
+        {
+            same = same && foo.key_at(index) == key && foo.value_at(index) == value && foo.find(key) == index;
+            index++;
+        }
+        REQUIRE(same);
+    }
+
+    SECTION("THROWING VALUES LEAVE THE MAP INTACT")
+    {
+        // Nothrow movable keys next to values which can throw on a move
+        flat_map<std::string, Fragile> bar;
+        for (int i = 0; i < 8; i++)
+            bar.insert_or_assign(std::string(20, static_cast<char>('a' + 2 * i)), Fragile(i));
+
+        const dynamic_array<std::string> keys = bar.keys();
+        const std::vector<std::pair<std::string, Fragile>> batch = {{"b", 10}, {"zz", 11}, {"aa", 12}};
+
+        // Fails at every possible point until the budget is large enough
+        bool intact = true;
+        int budget = 0;
+        for (;; budget++)
+        {
+            Fragile::budget = budget;
+            try
+            {
+                bar.insert(batch.begin(), batch.end());
+                break;
+            }
+            catch (const std::runtime_error &)
+            {
+                intact = intact && bar.keys() == keys;
+                for (int i = 0; i < 8; i++)
+                    intact = intact && bar.value_at(i).value == i;
+            }
+        }
+        Fragile::budget = -1;
+
+        REQUIRE(budget > 0);
+        REQUIRE(intact);
+        REQUIRE(bar.size() == 11);
+        REQUIRE(bar.key_at(0) == "aa");
+    }
+}
@@ -0,0 +1,332 @@
+#ifndef FLAT_SET_GUARD
+#define FLAT_SET_GUARD
+
+/*
+ *  Sorted set of unique keys in one dynamic_array.
+ *
+ *  Lookups are binary searches over contiguous keys - no node per key, no
+ *  pointer chasing. Single inserts and erases shift the tail (O(n)), so
+ *  batches go through insert(first, last): the batch is appended, sorted
+ *  and merged with the existing keys once.
+ *
+ *  Positions are indices into the sorted keys, like dynamic_array::find;
+ *  npos means "not found".
+*/
+
+#include "dynamic_array.hpp" // Key storage
+
+#include <algorithm>        // std::stable_sort, std::inplace_merge, std::unique
+#include <cstddef>          // std::size_t
+#include <functional>       // std::less
+#include <initializer_list> // Key lists
+#include <utility>          // std::pair
+
+namespace ds
+{
+    namespace detail
+    {
+        // Index of the first element of the sorted range [data, data + size) which is not less than key.
+        // Branchless: the halving step compiles to a conditional move, so the loop runs exactly
+        // log2(size) times and never mispredicts - only the memory latency of the probes is left.
+        template <class T, class Key, class Compare>
+        inline std::size_t lower_bound_index(const T *data, std::size_t size, const Key &key, Compare &comp)
+        {
+            if (size == 0)
+                return 0;
+
+            const T *base = data;
+            while (size > 1)
+            {
+                const std::size_t half = size / 2;
+                base = comp(base[half], key) ? base + half : base;
+                size -= half;
+            }
+
+            return static_cast<std::size_t>(base - data) + comp(*base, key);
+        }
+
+        // Index of the first element of the sorted range which is greater than key
+        template <class T, class Key, class Compare>
+        inline std::size_t upper_bound_index(const T *data, std::size_t size, const Key &key, Compare &comp)
+        {
+            if (size == 0)
+                return 0;
+
+            const T *base = data;
+            while (size > 1)
+            {
+                const std::size_t half = size / 2;
+                base = comp(key, base[half]) ? base : base + half;
+                size -= half;
+            }
+
+            return static_cast<std::size_t>(base - data) + !comp(key, *base);
+        }
+    } // namespace detail
+
+    template <class Key, class Compare = std::less<Key>, class Allocator = detail::default_allocator<Key>>
+    class flat_set
+    {
+    public:
+        using storage_type = dynamic_array<Key, Allocator>;
+
+        using key_type = Key;
+        using value_type = Key;
+        using key_compare = Compare;
+        using allocator_type = Allocator;
+        using size_type = std::size_t;
+        using const_reference = const Key &;
+
+        // Keys cannot be modified in place - both iterators are constant
+        using iterator = typename storage_type::const_iterator;
+        using const_iterator = typename storage_type::const_iterator;
+
+        static constexpr size_type npos = storage_type::npos;
+
+        // Constructors, Destructors; Gang of Four
+        // Copies are member-wise - the key array is copied
+
+        // Constructs an empty set
+        explicit flat_set(const Compare &comp = Compare(), const Allocator &alloc = Allocator());
+
+        // Constructs a set of the keys in il, duplicates are dropped
+        flat_set(const std::initializer_list<Key> &i_list, const Compare &comp = Compare(), const Allocator &alloc = Allocator());
+
+        // Constructs a set of the keys in [first, last), duplicates are dropped
+        template <class InputIt>
+        flat_set(InputIt first, InputIt last, const Compare &comp = Compare(), const Allocator &alloc = Allocator());
+
+        ///
+        // Modifiers
+
+        // Inserts key unless an equivalent one is present - returns its index and whether it was inserted
+        std::pair<size_type, bool> insert(const Key &key);
+        std::pair<size_type, bool> insert(Key &&key);
+
+        // Bulk insert - sorts the batch and merges it with the keys once, O(n + k log k).
+        // Keys already present win over equivalent ones in the batch.
+        template <class InputIt>
+        void insert(InputIt first, InputIt last);
+        void insert(const std::initializer_list<Key> &i_list) { insert(i_list.begin(), i_list.end()); }
+
+        // Removes key - returns the number of removed keys (0 or 1)
+        size_type erase(const Key &key);
+
+        // Removes the keys at index, or in [first, last)
+        void erase_at(size_type index);
+        void erase_at(size_type first, size_type last);
+
+        void clear() { m_keys.clear(); }
+
+        ///
+        // Lookup - O(log n)
+        size_type find(const Key &key) const;
+        size_type count(const Key &key) const { return find(key) != npos; }
+        bool contains(const Key &key) const { return find(key) != npos; }
+
+        // Index of the first key not less than (lower_bound) or greater than (upper_bound) key
+        size_type lower_bound(const Key &key) const { return detail::lower_bound_index(m_keys.data(), m_keys.size(), key, m_comp); }
+        size_type upper_bound(const Key &key) const { return detail::upper_bound_index(m_keys.data(), m_keys.size(), key, m_comp); }
+
+        // Indices [first, last) of the keys in [low, high)
+        std::pair<size_type, size_type> range(const Key &low, const Key &high) const;
+
+        ///
+        // Access operations
+        const Key &operator[](size_type index) const { return m_keys[index]; }
+        const Key &at(size_type index) const { return m_keys.at(index); }
+        const Key &front() const { return m_keys.front(); }
+        const Key &back() const { return m_keys.back(); }
+
+        // The sorted keys
+        const storage_type &keys() const noexcept { return m_keys; }
+
+        ///
+        // Capacity operations
+        void reserve(size_type new_capacity) { m_keys.reserve(new_capacity); }
+        void shrink_to_fit() { m_keys.shrink_to_fit(); }
+
+        size_type size() const { return m_keys.size(); }
+        size_type capacity() const { return m_keys.capacity(); }
+        bool empty() const { return m_keys.empty(); }
+        key_compare key_comp() const { return m_comp; }
+        allocator_type get_allocator() const { return m_keys.get_allocator(); }
+
+        // Comparison operators
+        bool operator==(const flat_set &other) const { return m_keys == other.m_keys; }
+
+        ///
+        // Iterator - the keys in ascending order
+        const_iterator begin() const noexcept { return m_keys.begin(); }
+        const_iterator end() const noexcept { return m_keys.end(); }
+        const_iterator cbegin() const noexcept { return m_keys.cbegin(); }
+        const_iterator cend() const noexcept { return m_keys.cend(); }
+
+    private:
+        storage_type m_keys;
+        Compare m_comp;
+
+        ///
+        // Helpers
+    private:
+        template <class K>
+        std::pair<size_type, bool> insert_unique(K &&key);
+    };
+
+    // O(1) - Constant time
+    template <class Key, class Compare, class Allocator>
+    inline flat_set<Key, Compare, Allocator>::flat_set(const Compare &comp, const Allocator &alloc)
+        : m_keys(alloc), m_comp(comp)
+    {
+    }
+
+    // O(n log n) - Linearithmic time
+    template <class Key, class Compare, class Allocator>
+    inline flat_set<Key, Compare, Allocator>::flat_set(const std::initializer_list<Key> &i_list, const Compare &comp, const Allocator &alloc)
+        : flat_set(i_list.begin(), i_list.end(), comp, alloc)
+    {
+    }
+
+    // O(n log n) - Linearithmic time
+    template <class Key, class Compare, class Allocator>
+    template <class InputIt>
+    inline flat_set<Key, Compare, Allocator>::flat_set(InputIt first, InputIt last, const Compare &comp, const Allocator &alloc)
+        : flat_set(comp, alloc)
+    {
+        insert(first, last);
+    }
+
+    // O(n) - Linear time (the keys behind it are shifted)
+    template <class Key, class Compare, class Allocator>
+    inline std::pair<typename flat_set<Key, Compare, Allocator>::size_type, bool> flat_set<Key, Compare, Allocator>::insert(const Key &key)
+    {
+        return insert_unique(key);
+    }
+
+    // O(n) - Linear time (the keys behind it are shifted)
+    template <class Key, class Compare, class Allocator>
+    inline std::pair<typename flat_set<Key, Compare, Allocator>::size_type, bool> flat_set<Key, Compare, Allocator>::insert(Key &&key)
+    {
+        return insert_unique(std::move(key));
+    }
+
+    // O(n + k log k) - Linear in the keys, linearithmic in the batch
+    template <class Key, class Compare, class Allocator>
+    template <class InputIt>
+    inline void flat_set<Key, Compare, Allocator>::insert(InputIt first, InputIt last)
+    {
+        const size_type old_size = m_keys.size();
+        m_keys.append(first, last);
+
+        if (m_keys.size() == old_size)
+            return;
+
+        Key *keys = m_keys.data();
+        Key *middle = keys + old_size;
+        Key *end = keys + m_keys.size();
+
+        // A stable sort keeps the first of equivalent batch keys in front, std::unique keeps that one
+        try
+        {
+            std::stable_sort(middle, end, m_comp);
+        }
+        catch (...)
+        {
+            m_keys.erase(old_size, m_keys.size()); // The keys are untouched
+            throw;
+        }
+
+        // A batch behind the last key (e.g. loading sorted data) needs no merge
+        const bool merge = old_size > 0 && m_comp(*middle, middle[-1]);
+        if (merge)
+        {
+            try
+            {
+                std::inplace_merge(keys, middle, end, m_comp);
+            }
+            catch (...)
+            {
+                m_keys.clear(); // Half merged keys are out of order - leave a valid (empty) set
+                throw;
+            }
+        }
+
+        // Both halves were sorted - duplicates can only start at the seam, or anywhere after a merge
+        Key *unique_from = merge || old_size == 0 ? keys : middle - 1;
+        Key *unique_end = std::unique(unique_from, end, [this](const Key &lhs, const Key &rhs)
+                                      { return !m_comp(lhs, rhs); });
+
+        m_keys.erase(static_cast<size_type>(unique_end - keys), m_keys.size());
+    }
+
+    // O(n) - Linear time (the keys behind it are shifted)
+    template <class Key, class Compare, class Allocator>
+    inline typename flat_set<Key, Compare, Allocator>::size_type flat_set<Key, Compare, Allocator>::erase(const Key &key)
+    {
+        const size_type index = find(key);
+        if (index == npos)
+            return 0;
+
+        m_keys.erase(index);
+        return 1;
+    }
+
+    // O(n) - Linear time
+    template <class Key, class Compare, class Allocator>
+    inline void flat_set<Key, Compare, Allocator>::erase_at(size_type index)
+    {
+        m_keys.erase(index);
+    }
+
+    // O(n) - Linear time
+    template <class Key, class Compare, class Allocator>
+    inline void flat_set<Key, Compare, Allocator>::erase_at(size_type first, size_type last)
+    {
+        m_keys.erase(first, last);
+    }
+
+    // O(log n) - Logarithmic time
+    template <class Key, class Compare, class Allocator>
+    inline typename flat_set<Key, Compare, Allocator>::size_type flat_set<Key, Compare, Allocator>::find(const Key &key) const
+    {
+        const size_type index = lower_bound(key);
+        if (index == m_keys.size() || m_comp(key, m_keys.data()[index]))
+            return npos;
+
+        return index;
+    }
+
+    // O(log n) - Logarithmic time
+    template <class Key, class Compare, class Allocator>
+    inline std::pair<typename flat_set<Key, Compare, Allocator>::size_type, typename flat_set<Key, Compare, Allocator>::size_type>
+    flat_set<Key, Compare, Allocator>::range(const Key &low, const Key &high) const
+    {
+        const size_type first = lower_bound(low);
+        const size_type last = m_comp(low, high) ? lower_bound(high) : first;
+
+        return {first, last};
+    }
+
+    ///
+    // Helpers
+
+    template <class Key, class Compare, class Allocator>
+    template <class K>
+    inline std::pair<typename flat_set<Key, Compare, Allocator>::size_type, bool> flat_set<Key, Compare, Allocator>::insert_unique(K &&key)
+    {
+        const size_type index = lower_bound(key);
+        if (index < m_keys.size() && !m_comp(key, m_keys.data()[index]))
+            return {index, false};
+
+        // dynamic_array::insert only accepts positions in front of an element
+        if (index == m_keys.size())
+            m_keys.push_back(std::forward<K>(key));
+        else
+            m_keys.insert(index, std::forward<K>(key));
+
+        return {index, true};
+    }
+
+} // namespace ds
+
+#endif // FLAT_SET_GUARD
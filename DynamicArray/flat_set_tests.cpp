@@ -0,0 +1,135 @@
+#define CATCH_CONFIG_MAIN
+#include "../Catch2/catch.hpp"
+#include "flat_set.hpp"
+
+#include <algorithm>
+#include <functional>
+#include <random>
+#include <set>
+#include <string>
+#include <vector>
+
+using namespace ds;
+
+TEST_CASE("CONSTRUCTORS", "[CONSTRUCTOR]")
+{
+    flat_set<int> def;
+
+    REQUIRE(def.size() == 0);
+    REQUIRE(def.empty());
+    REQUIRE(def.find(1) == flat_set<int>::npos);
+    REQUIRE(def.lower_bound(1) == 0);
+    REQUIRE(def.upper_bound(1) == 0);
+
+    flat_set<int> foo = {5, 1, 4, 1, 3, 5, 2};
+    REQUIRE(foo.size() == 5);
+    REQUIRE(std::is_sorted(foo.begin(), foo.end()));
+    REQUIRE(foo.front() == 1);
+    REQUIRE(foo.back() == 5);
+
+    const std::vector<std::string> words = {"pear", "apple", "fig", "apple"};
+    flat_set<std::string, std::greater<std::string>> bar(words.begin(), words.end());
+    REQUIRE(bar.size() == 3);
+    REQUIRE(bar[0] == "pear");
+    REQUIRE(bar[2] == "apple");
+
+    flat_set<int> copy(foo);
+    REQUIRE(copy == foo);
+    copy.erase(3);
+    REQUIRE_FALSE(copy == foo);
+}
+
+TEST_CASE("DEFAULT OPERATIONS", "[OPERATIONS]")
+{
+    flat_set<int> foo = {10, 20, 30, 40};
+
+    SECTION("SINGLE INSERT AND ERASE")
+    {
+        REQUIRE(foo.insert(25) == std::make_pair(std::size_t(2), true));
+        REQUIRE(foo.insert(25) == std::make_pair(std::size_t(2), false));
+        REQUIRE(foo.insert(5).first == 0);
+        REQUIRE(foo.insert(50).first == 6);
+        REQUIRE(foo.size() == 7);
+        REQUIRE(std::is_sorted(foo.begin(), foo.end()));
+
+        REQUIRE(foo.erase(25) == 1);
+        REQUIRE(foo.erase(25) == 0);
+        foo.erase_at(0);
+        foo.erase_at(0, 2);
+        REQUIRE(foo.keys() == dynamic_array<int>{30, 40, 50});
+    }
+
+    SECTION("LOOKUP")
+    {
+        REQUIRE(foo.find(30) == 2);
+        REQUIRE(foo.find(35) == flat_set<int>::npos);
+        REQUIRE(foo.contains(10));
+        REQUIRE(foo.count(11) == 0);
+
+        REQUIRE(foo.lower_bound(20) == 1);
+        REQUIRE(foo.upper_bound(20) == 2);
+        REQUIRE(foo.lower_bound(21) == 2);
+        REQUIRE(foo.lower_bound(0) == 0);
+        REQUIRE(foo.lower_bound(99) == 4);
+        REQUIRE(foo.upper_bound(40) == 4);
+    }
+
+    SECTION("RANGE QUERIES")
+    {
+        REQUIRE(foo.range(15, 35) == std::make_pair(std::size_t(1), std::size_t(3)));
+        REQUIRE(foo.range(20, 40) == std::make_pair(std::size_t(1), std::size_t(3))); // [low, high)
+        REQUIRE(foo.range(0, 100) == std::make_pair(std::size_t(0), std::size_t(4)));
+
+        const auto empty = foo.range(35, 15);
+        REQUIRE(empty.first == empty.second);
+    }
+}
+
+TEST_CASE("BULK INSERT", "[OPERATIONS]")
+{
+    flat_set<int> foo = {10, 20, 30};
+
+    SECTION("BATCH BEHIND THE KEYS")
+    {
+        const std::vector<int> batch = {60, 40, 50, 40, 30};
+        foo.insert(batch.begin(), batch.end());
+        REQUIRE(foo.keys() == dynamic_array<int>{10, 20, 30, 40, 50, 60});
+    }
+
+    SECTION("INTERLEAVED BATCH")
+    {
+        foo.insert({25, 5, 20, 35, 5});
+        REQUIRE(foo.keys() == dynamic_array<int>{5, 10, 20, 25, 30, 35});
+
+        foo.insert({});
+        REQUIRE(foo.size() == 6);
+    }
+
+    SECTION("AGAINST STD::SET")
+    {
+        std::mt19937 gen(11);
+        std::set<int> expected(foo.begin(), foo.end());
+
+        for (int round = 0; round < 20; round++)
+        {
+            std::vector<int> batch(gen() % 300);
+            for (int &key : batch)
+                key = static_cast<int>(gen() % 2000);
+
+            foo.insert(batch.begin(), batch.end());
+            expected.insert(batch.begin(), batch.end());
+        }
+
+        REQUIRE(foo.size() == expected.size());
+        REQUIRE(std::equal(foo.begin(), foo.end(), expected.begin()));
+
+        bool bounds_match = true;
+        for (int key = -1; key <= 2001; key++)
+        {
+            const auto lower = std::distance(expected.begin(), expected.lower_bound(key));
+            const auto upper = std::distance(expected.begin(), expected.upper_bound(key));
+            bounds_match = bounds_match && foo.lower_bound(key) == std::size_t(lower) && foo.upper_bound(key) == std::size_t(upper);
+        }
+        REQUIRE(bounds_match);
+    }
+}
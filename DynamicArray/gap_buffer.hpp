@@ -0,0 +1,1006 @@
+#ifndef GAP_BUFFER_GUARD
+#define GAP_BUFFER_GUARD
+
+/*
+ *  Sequence container with the dynamic_array interface for edits clustered
+ *  around a cursor.
+ *
+ *  The free capacity is kept as one gap inside the buffer instead of behind
+ *  the last element: [elements before the gap | gap | elements after it].
+ *  An insert or erase moves the gap to its position first - only the
+ *  elements between the old and the new position are relocated - and then
+ *  fills or widens it in O(1). A run of edits at or next to the same place
+ *  therefore costs O(1) amortized each, where dynamic_array shifts the whole
+ *  tail every time.
+ *
+ *  The elements are stored in two contiguous runs (before_gap, after_gap);
+ *  data() closes the gap to hand out a single one.
+ *  Every edit may relocate elements - pointers, references and iterators
+ *  into the buffer are invalidated by insert, erase, data() and growth.
+*/
+
+#include "dynamic_array.hpp"   // Shared element helpers, growth policies
+#include "segmented_array.hpp" // detail::indexed_iterator
+
+#include <algorithm>   // std::min, std::move_backward
+#include <cstddef>     // std::size_t
+#include <cstring>     // std::memmove
+#include <iterator>    // Reverse iterators, iterator categories
+#include <limits>      // max_size
+#include <memory>      // std::allocator_traits
+#include <stdexcept>   // Exceptions
+#include <type_traits> // Trivially copyable fast path
+#include <utility>     // std::pair
+
+namespace ds
+{
+    template <class T, class Allocator = detail::default_allocator<T>, class GrowthPolicy = growth::doubling>
+    class gap_buffer
+    {
+        using alloc_traits = std::allocator_traits<Allocator>;
+
+        template <class, class>
+        friend class detail::indexed_iterator;
+
+    public:
+        using value_type = T;
+        using allocator_type = Allocator;
+        using size_type = std::size_t;
+        using difference_type = std::ptrdiff_t;
+        using reference = T &;
+        using const_reference = const T &;
+
+        using iterator = detail::indexed_iterator<T, gap_buffer>;
+        using const_iterator = detail::indexed_iterator<const T, const gap_buffer>;
+        using reverse_iterator = std::reverse_iterator<iterator>;
+        using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+        // A contiguous run of elements
+        using run = std::pair<const T *, size_type>;
+
+        static constexpr size_type npos = static_cast<size_type>(-1);
+
+        // Constructors, Destructors; Gang of Four
+
+        // Constructs an empty container with selected or default initial capacity
+        explicit gap_buffer(size_type capacity = INIT_CAPACITY, const Allocator &alloc = Allocator());
+
+        // Constructs a container with a copy of each of the elements in il, in the same order.
+        gap_buffer(const std::initializer_list<T> &i_list, const Allocator &alloc = Allocator());
+
+        // Constructs a container with a copy of each of the elements and keep the original order
+        // The allocator is obtained by select_on_container_copy_construction
+        gap_buffer(const gap_buffer &other);
+
+        // Allocator-extended copy constructor
+        gap_buffer(const gap_buffer &other, const Allocator &alloc);
+
+        // Move constructor - takes over the buffer and the allocator, other is left empty with no storage
+        gap_buffer(gap_buffer &&other) noexcept;
+
+        // Copy assignment operator (copy-and-swap idiom)
+        // The allocator is replaced only if it propagates on copy assignment
+        gap_buffer &operator=(const gap_buffer &other);
+
+        // Move assignment operator - takes over the buffer if the allocator propagates on move assignment
+        // or the allocators compare equal, otherwise the elements are moved one by one
+        gap_buffer &operator=(gap_buffer &&other) noexcept(alloc_traits::propagate_on_container_move_assignment::value ||
+                                                           alloc_traits::is_always_equal::value);
+
+        // Destructor
+        ~gap_buffer();
+
+        ///
+        // Basic Operations
+        void push_back(const T &el);
+        void push_back(T &&el);
+
+        // Constructs an element in place at the back from args
+        template <class... Args>
+        T &emplace_back(Args &&...args);
+
+        // Inserts before position (position == size() appends) - the gap is left behind the new element
+        void insert(size_type position, const T &val);
+        void insert(size_type position, T &&val);
+
+        // Constructs an element in place before position from args
+        template <class... Args>
+        T &emplace(size_type position, Args &&...args);
+
+        // Range insertion - moves the gap once, grows at most once and fills the gap in order
+        // The inserted range must not refer to elements of this buffer
+
+        // Insert copies of [first, last) before position
+        template <class InputIt, class = detail::require_input_iterator<InputIt>>
+        void insert(size_type position, InputIt first, InputIt last);
+
+        // Insert count copies of value before position
+        void insert(size_type position, size_type count, const T &value);
+
+        // Add copies of [first, last) to the back
+        template <class InputIt, class = detail::require_input_iterator<InputIt>>
+        void append(InputIt first, InputIt last);
+
+        ///
+        // Access operations
+        // operator[] is checked according to DS_BOUNDS_CHECK, at() always throws std::out_of_range
+        const T &operator[](size_type index) const;
+        T &operator[](size_type index);
+        const T &at(size_type index) const;
+        T &at(size_type index);
+        const T &front() const;
+        T &front();
+        const T &back() const;
+        T &back();
+
+        // Closes the gap (moves it behind the last element) - the elements are then contiguous
+        T *data();
+
+        // The elements in front of and behind the gap
+        run before_gap() const noexcept { return run(m_data, m_gap_begin); }
+        run after_gap() const noexcept { return run(m_data + m_gap_end, m_capacity - m_gap_end); }
+
+        // Index of the first element behind the gap - the position of the last edit
+        size_type gap_position() const noexcept { return m_gap_begin; }
+
+        // Moves the gap in front of position, e.g. to the cursor before a run of edits
+        void move_gap(size_type position);
+
+        ///
+        // Remove operations
+        void pop_back();
+
+        // The gap is left where the erased elements were
+        void erase(size_type position);
+        void erase(size_type first, size_type last);
+
+        // Single pass compaction of both runs towards the gap - the gap keeps its position,
+        // the kept elements their order. pred is called once per element.
+        // Returns the number of erased elements
+
+        // Erase every element satisfying pred
+        template <class Predicate>
+        size_type erase_if(Predicate pred);
+
+        // Erase every element equal to value
+        size_type remove(const T &value);
+
+        // Destroys all elements, the buffer is kept for reuse
+        void clear();
+
+        ///
+        // Capacity operations
+        void reserve(size_type new_capacity);
+        void shrink_to_fit();
+
+        size_type size() const noexcept { return m_capacity - gap_size(); }
+        size_type capacity() const noexcept { return m_capacity; }
+        size_type max_size() const noexcept;
+        bool empty() const noexcept { return size() == 0; }
+        allocator_type get_allocator() const { return m_alloc; }
+
+        ///
+        // Lookup operations - both runs are scanned directly
+        size_type find(const T &value) const;
+        template <class Predicate>
+        size_type find_if(Predicate pred) const;
+        size_type count(const T &value) const;
+        bool contains(const T &value) const { return find(value) != npos; }
+
+        // Comparison operators
+        bool operator==(const gap_buffer &other) const;
+
+        ///
+        // Iterator - random access, every dereference skips the gap
+        iterator begin() noexcept { return iterator(this, 0); }
+        iterator end() noexcept { return iterator(this, size()); }
+        const_iterator begin() const noexcept { return const_iterator(this, 0); }
+        const_iterator end() const noexcept { return const_iterator(this, size()); }
+        const_iterator cbegin() const noexcept { return begin(); }
+        const_iterator cend() const noexcept { return end(); }
+
+        reverse_iterator rbegin() noexcept { return reverse_iterator(end()); }
+        reverse_iterator rend() noexcept { return reverse_iterator(begin()); }
+        const_reverse_iterator rbegin() const noexcept { return const_reverse_iterator(end()); }
+        const_reverse_iterator rend() const noexcept { return const_reverse_iterator(begin()); }
+        const_reverse_iterator crbegin() const noexcept { return rbegin(); }
+        const_reverse_iterator crend() const noexcept { return rend(); }
+
+        // The allocators are exchanged only if they propagate on swap,
+        // otherwise they must compare equal.
+        friend void swap(gap_buffer &lhs, gap_buffer &rhs) noexcept
+        {
+            using std::swap;
+            if constexpr (alloc_traits::propagate_on_container_swap::value)
+            {
+                swap(lhs.m_alloc, rhs.m_alloc);
+            }
+            else
+            {
+                assert(lhs.m_alloc == rhs.m_alloc);
+            }
+
+            swap(lhs.m_data, rhs.m_data);
+            swap(lhs.m_capacity, rhs.m_capacity);
+            swap(lhs.m_gap_begin, rhs.m_gap_begin);
+            swap(lhs.m_gap_end, rhs.m_gap_end);
+        }
+
+    private:
+        Allocator m_alloc;
+        T *m_data = nullptr;
+        size_type m_capacity = 0;
+        size_type m_gap_begin = 0; // [m_gap_begin, m_gap_end) is uninitialized storage,
+        size_type m_gap_end = 0;   // everything else holds elements
+
+        ///
+        // Helpers
+    private:
+        size_type gap_size() const noexcept { return m_gap_end - m_gap_begin; }
+
+        // O(1) - Address of the element at index
+        T *locate(size_type index) const noexcept { return m_data + (index < m_gap_begin ? index : index + gap_size()); }
+
+        // Moves count elements from first to the uninitialized storage at dest (the ranges may overlap)
+        void relocate_left(T *first, size_type count, T *dest);
+        void relocate_right(T *first, size_type count, T *dest);
+
+        // Inserts the count elements of [first, last) before position
+        template <class ForwardIt>
+        void insert_forward(size_type position, ForwardIt first, ForwardIt last, size_type count);
+
+        // Makes room for one more element in the gap
+        void grow();
+        void reallocate(size_type new_capacity);
+        void release() noexcept;
+        void steal(gap_buffer &src) noexcept;
+    };
+
+    // O(1) - Constant time
+    template <class T, class Allocator, class GrowthPolicy>
+    inline gap_buffer<T, Allocator, GrowthPolicy>::gap_buffer(size_type capacity, const Allocator &alloc)
+        : m_alloc(alloc)
+    {
+        if (capacity == 0)
+            throw std::invalid_argument("Invalid initial capacity!");
+
+        if (capacity > max_size())
+            throw std::length_error("Requested capacity exceeds max_size()!");
+
+        m_data = alloc_traits::allocate(m_alloc, capacity);
+        m_capacity = capacity;
+        m_gap_end = capacity;
+    }
+
+    // O(n) - Linear time
+    template <class T, class Allocator, class GrowthPolicy>
+    inline gap_buffer<T, Allocator, GrowthPolicy>::gap_buffer(const std::initializer_list<T> &i_list, const Allocator &alloc)
+        : gap_buffer(i_list.size() > 0 ? i_list.size() : INIT_CAPACITY, alloc)
+    {
+        // The object is already constructed - on failure the destructor frees the buffer,
+        // uninitialized_copy destroys whatever it managed to build
+        detail::uninitialized_copy(m_alloc, i_list.begin(), i_list.end(), m_data);
+        m_gap_begin = i_list.size();
+    }
+
+    // O(n) - Linear time
+    template <class T, class Allocator, class GrowthPolicy>
+    inline gap_buffer<T, Allocator, GrowthPolicy>::gap_buffer(const gap_buffer &other)
+        : gap_buffer(other, alloc_traits::select_on_container_copy_construction(other.m_alloc))
+    {
+    }
+
+    // O(n) - Linear time
+    template <class T, class Allocator, class GrowthPolicy>
+    inline gap_buffer<T, Allocator, GrowthPolicy>::gap_buffer(const gap_buffer &other, const Allocator &alloc)
+        : gap_buffer(other.size() > 0 ? other.size() : INIT_CAPACITY, alloc)
+    {
+        // The copy is compact - both runs of other end up in front of the gap
+        const run front = other.before_gap();
+        const run back = other.after_gap();
+
+        // m_gap_begin tracks the constructed prefix - the destructor cleans up if a copy throws
+        detail::uninitialized_copy(m_alloc, front.first, front.first + front.second, m_data);
+        m_gap_begin = front.second;
+
+        detail::uninitialized_copy(m_alloc, back.first, back.first + back.second, m_data + m_gap_begin);
+        m_gap_begin += back.second;
+    }
+
+    // O(1) - Constant time
+    template <class T, class Allocator, class GrowthPolicy>
+    inline gap_buffer<T, Allocator, GrowthPolicy>::gap_buffer(gap_buffer &&other) noexcept
+        : m_alloc(std::move(other.m_alloc))
+    {
+        steal(other);
+    }
+
+    // O(n) - Linear time
+    // The copy is made with the allocator *this should end up with, so the
+    // following swap never has to exchange unequal allocators.
+    template <class T, class Allocator, class GrowthPolicy>
+    inline gap_buffer<T, Allocator, GrowthPolicy> &gap_buffer<T, Allocator, GrowthPolicy>::operator=(const gap_buffer &other)
+    {
+        if (this == &other)
+            return *this;
+
+        if constexpr (alloc_traits::propagate_on_container_copy_assignment::value)
+        {
+            gap_buffer copy(other, other.m_alloc);
+            release(); // Releases the buffer with the allocator that owns it
+            m_alloc = other.m_alloc;
+            swap(*this, copy);
+        }
+        else
+        {
+            gap_buffer copy(other, m_alloc);
+            swap(*this, copy);
+        }
+
+        return *this;
+    }
+
+    // O(1) - Constant time, O(n) if the allocators differ and do not propagate
+    template <class T, class Allocator, class GrowthPolicy>
+    inline gap_buffer<T, Allocator, GrowthPolicy> &gap_buffer<T, Allocator, GrowthPolicy>::operator=(gap_buffer &&other) noexcept(
+        alloc_traits::propagate_on_container_move_assignment::value || alloc_traits::is_always_equal::value)
+    {
+        if (this == &other)
+            return *this;
+
+        if constexpr (alloc_traits::propagate_on_container_move_assignment::value)
+        {
+            release(); // Releases the buffer with the allocator that owns it
+            m_alloc = std::move(other.m_alloc);
+            steal(other);
+        }
+        else
+        {
+            if (alloc_traits::is_always_equal::value || m_alloc == other.m_alloc)
+            {
+                release();
+                steal(other);
+            }
+            else
+            {
+                // The buffer of other can not be freed by m_alloc - move the elements into storage of our own
+                const run front = other.before_gap();
+                const run back = other.after_gap();
+                gap_buffer moved(other.size() > 0 ? other.size() : INIT_CAPACITY, m_alloc);
+
+                T *front_first = const_cast<T *>(front.first);
+                T *back_first = const_cast<T *>(back.first);
+                detail::uninitialized_move_if_noexcept(m_alloc, front_first, front_first + front.second, moved.m_data);
+                moved.m_gap_begin = front.second;
+
+                detail::uninitialized_move_if_noexcept(m_alloc, back_first, back_first + back.second, moved.m_data + moved.m_gap_begin);
+                moved.m_gap_begin += back.second;
+
+                swap(*this, moved);
+                other.clear();
+            }
+        }
+
+        return *this;
+    }
+
+    // O(n) - Linear time
+    template <class T, class Allocator, class GrowthPolicy>
+    inline gap_buffer<T, Allocator, GrowthPolicy>::~gap_buffer()
+    {
+        release();
+    }
+
+    // O(1) - Amortized constant time, O(n) if the gap is elsewhere
+    template <class T, class Allocator, class GrowthPolicy>
+    inline void gap_buffer<T, Allocator, GrowthPolicy>::push_back(const T &el)
+    {
+        emplace(size(), el);
+    }
+
+    // O(1) - Amortized constant time, O(n) if the gap is elsewhere
+    template <class T, class Allocator, class GrowthPolicy>
+    inline void gap_buffer<T, Allocator, GrowthPolicy>::push_back(T &&el)
+    {
+        emplace(size(), std::move(el));
+    }
+
+    // O(1) - Amortized constant time, O(n) if the gap is elsewhere
+    template <class T, class Allocator, class GrowthPolicy>
+    template <class... Args>
+    inline T &gap_buffer<T, Allocator, GrowthPolicy>::emplace_back(Args &&...args)
+    {
+        return emplace(size(), std::forward<Args>(args)...);
+    }
+
+    // O(1) - Amortized constant time next to the last edit, O(distance to the gap) otherwise
+    template <class T, class Allocator, class GrowthPolicy>
+    inline void gap_buffer<T, Allocator, GrowthPolicy>::insert(size_type position, const T &val)
+    {
+        emplace(position, val);
+    }
+
+    // O(1) - Amortized constant time next to the last edit, O(distance to the gap) otherwise
+    template <class T, class Allocator, class GrowthPolicy>
+    inline void gap_buffer<T, Allocator, GrowthPolicy>::insert(size_type position, T &&val)
+    {
+        emplace(position, std::move(val));
+    }
+
+    // O(1) - Amortized constant time next to the last edit, O(distance to the gap) otherwise
+    template <class T, class Allocator, class GrowthPolicy>
+    template <class... Args>
+    inline T &gap_buffer<T, Allocator, GrowthPolicy>::emplace(size_type position, Args &&...args)
+    {
+        if (position > size())
+            throw std::invalid_argument("Invalid insert position!");
+
+        if (position == m_gap_begin && m_gap_begin != m_gap_end)
+        {
+            // Nothing moves - args may refer to any element
+            alloc_traits::construct(m_alloc, m_data + m_gap_begin, std::forward<Args>(args)...);
+        }
+        else
+        {
+            // Built before relocating - args might refer to an element which is about to be moved
+            T copy(std::forward<Args>(args)...);
+
+            if (m_gap_begin == m_gap_end)
+                grow();
+
+            move_gap(position);
+            alloc_traits::construct(m_alloc, m_data + m_gap_begin, std::move(copy));
+        }
+
+        return m_data[m_gap_begin++];
+    }
+
+    // O(k) - Linear in the length of the range, plus the distance to the gap
+    // Single pass ranges have no known length - each element is constructed in the gap, which grows as needed
+    template <class T, class Allocator, class GrowthPolicy>
+    template <class InputIt, class>
+    inline void gap_buffer<T, Allocator, GrowthPolicy>::insert(size_type position, InputIt first, InputIt last)
+    {
+        using category = typename std::iterator_traits<InputIt>::iterator_category;
+
+        if (position > size())
+            throw std::invalid_argument("Invalid insert position!");
+
+        if constexpr (std::is_convertible_v<category, std::forward_iterator_tag>)
+        {
+            insert_forward(position, first, last, static_cast<size_type>(std::distance(first, last)));
+        }
+        else
+        {
+            move_gap(position);
+            for (; first != last; ++first)
+                emplace(m_gap_begin, *first); // At the gap - nothing is relocated but on growth
+        }
+    }
+
+    // O(count) - Linear in count, plus the distance to the gap
+    template <class T, class Allocator, class GrowthPolicy>
+    inline void gap_buffer<T, Allocator, GrowthPolicy>::insert(size_type position, size_type count, const T &value)
+    {
+        if (position > size())
+            throw std::invalid_argument("Invalid insert position!");
+
+        T copy(value); // value might refer to an element which is about to be relocated
+        insert_forward(position, detail::repeat_iterator<T>(copy, 0), detail::repeat_iterator<T>(copy, count), count);
+    }
+
+    // O(k) - Linear in the length of the range, plus the distance to the gap
+    template <class T, class Allocator, class GrowthPolicy>
+    template <class InputIt, class>
+    inline void gap_buffer<T, Allocator, GrowthPolicy>::append(InputIt first, InputIt last)
+    {
+        insert(size(), first, last);
+    }
+
+    // O(1) - Constant time
+    template <class T, class Allocator, class GrowthPolicy>
+    inline const T &gap_buffer<T, Allocator, GrowthPolicy>::operator[](size_type index) const
+    {
+        detail::check_subscript(index, size()); // Policy selected by DS_BOUNDS_CHECK
+        return *locate(index);
+    }
+
+    // O(1) - Constant time
+    template <class T, class Allocator, class GrowthPolicy>
+    inline T &gap_buffer<T, Allocator, GrowthPolicy>::operator[](size_type index)
+    {
+        detail::check_subscript(index, size()); // Policy selected by DS_BOUNDS_CHECK
+        return *locate(index);
+    }
+
+    // O(1) - Constant time
+    template <class T, class Allocator, class GrowthPolicy>
+    inline const T &gap_buffer<T, Allocator, GrowthPolicy>::at(size_type index) const
+    {
+        if (index >= size())
+            throw std::out_of_range("Invalid index!");
+
+        return *locate(index);
+    }
+
+    // O(1) - Constant time
+    template <class T, class Allocator, class GrowthPolicy>
+    inline T &gap_buffer<T, Allocator, GrowthPolicy>::at(size_type index)
+    {
+        if (index >= size())
+            throw std::out_of_range("Invalid index!");
+
+        return *locate(index);
+    }
+
+    // O(1) - Constant time
+    template <class T, class Allocator, class GrowthPolicy>
+    inline const T &gap_buffer<T, Allocator, GrowthPolicy>::front() const
+    {
+        if (empty())
+            throw std::logic_error("Invalid opration: empty array!");
+
+        return *locate(0);
+    }
+
+    // O(1) - Constant time
+    template <class T, class Allocator, class GrowthPolicy>
+    inline T &gap_buffer<T, Allocator, GrowthPolicy>::front()
+    {
+        if (empty())
+            throw std::logic_error("Invalid opration: empty array!");
+
+        return *locate(0);
+    }
+
+    // O(1) - Constant time
+    template <class T, class Allocator, class GrowthPolicy>
+    inline const T &gap_buffer<T, Allocator, GrowthPolicy>::back() const
+    {
+        if (empty())
+            throw std::logic_error("Invalid opration: empty array!");
+
+        return *locate(size() - 1);
+    }
+
+    // O(1) - Constant time
+    template <class T, class Allocator, class GrowthPolicy>
+    inline T &gap_buffer<T, Allocator, GrowthPolicy>::back()
+    {
+        if (empty())
+            throw std::logic_error("Invalid opration: empty array!");
+
+        return *locate(size() - 1);
+    }
+
+    // O(1) - Constant time if the gap is closed, O(n) otherwise
+    template <class T, class Allocator, class GrowthPolicy>
+    inline T *gap_buffer<T, Allocator, GrowthPolicy>::data()
+    {
+        move_gap(size());
+        return m_data;
+    }
+
+    // O(|position - gap_position()|) - Linear in the distance the gap travels
+    template <class T, class Allocator, class GrowthPolicy>
+    inline void gap_buffer<T, Allocator, GrowthPolicy>::move_gap(size_type position)
+    {
+        if (position > size())
+            throw std::invalid_argument("Invalid gap position!");
+
+        if (m_gap_begin == m_gap_end)
+        {
+            // A full buffer has no gap to travel - nothing is relocated
+            m_gap_begin = m_gap_end = position;
+            return;
+        }
+
+        if (position < m_gap_begin)
+        {
+            // The elements in [position, gap) move behind the gap
+            const size_type count = m_gap_begin - position;
+            relocate_right(m_data + position, count, m_data + m_gap_end - count);
+        }
+        else if (position > m_gap_begin)
+        {
+            // The first elements behind the gap move in front of it
+            relocate_left(m_data + m_gap_end, position - m_gap_begin, m_data + m_gap_begin);
+        }
+    }
+
+    // O(1) - Constant time if the gap is at the back, O(n) otherwise
+    template <class T, class Allocator, class GrowthPolicy>
+    inline void gap_buffer<T, Allocator, GrowthPolicy>::pop_back()
+    {
+        if (empty())
+            throw std::logic_error("Invalid opration: Cannot pop from empty array!");
+
+        erase(size() - 1);
+    }
+
+    // O(1) - Constant time next to the last edit, O(distance to the gap) otherwise
+    template <class T, class Allocator, class GrowthPolicy>
+    inline void gap_buffer<T, Allocator, GrowthPolicy>::erase(size_type position)
+    {
+        if (position >= size())
+            throw std::invalid_argument("Invalid erase position!");
+
+        erase(position, position + 1);
+    }
+
+    // O(last - first) - Linear in the erased elements, plus the distance to the gap
+    template <class T, class Allocator, class GrowthPolicy>
+    inline void gap_buffer<T, Allocator, GrowthPolicy>::erase(size_type first, size_type last)
+    {
+        if (first > last || last > size())
+            throw std::invalid_argument("Invalid erase range!");
+
+        if (first == last)
+            return;
+
+        // The gap swallows the erased elements - behind it if it is closer to last, in front of it otherwise
+        const size_type count = last - first;
+        if (m_gap_begin >= last)
+        {
+            move_gap(last);
+            detail::destroy_range(m_alloc, m_data + first, m_data + last);
+            m_gap_begin = first;
+        }
+        else
+        {
+            move_gap(first);
+            detail::destroy_range(m_alloc, m_data + m_gap_end, m_data + m_gap_end + count);
+            m_gap_end += count;
+        }
+    }
+
+    // O(n) - Linear time
+    template <class T, class Allocator, class GrowthPolicy>
+    template <class Predicate>
+    inline typename gap_buffer<T, Allocator, GrowthPolicy>::size_type gap_buffer<T, Allocator, GrowthPolicy>::erase_if(Predicate pred)
+    {
+        const size_type old_size = size();
+
+        // Front run - the kept elements move down, the gap begins behind the last of them
+        size_type kept = 0;
+        while (kept < m_gap_begin && !pred(m_data[kept]))
+            kept++;
+
+        if (kept < m_gap_begin)
+        {
+            size_type i = kept + 1;
+            try
+            {
+                for (; i < m_gap_begin; i++)
+                {
+                    if (!pred(m_data[i]))
+                        m_data[kept++] = std::move(m_data[i]);
+                }
+            }
+            catch (...)
+            {
+                // Close the hole over the erased elements, the unvisited ones are kept
+                std::move(m_data + i, m_data + m_gap_begin, m_data + kept);
+                kept += m_gap_begin - i;
+                detail::destroy_range(m_alloc, m_data + kept, m_data + m_gap_begin);
+                m_gap_begin = kept;
+                throw;
+            }
+
+            detail::destroy_range(m_alloc, m_data + kept, m_data + m_gap_begin);
+            m_gap_begin = kept;
+        }
+
+        // Back run, last to first - the kept elements move up, the gap ends in front of the first of them
+        size_type i = m_capacity;
+        while (i > m_gap_end && !pred(m_data[i - 1]))
+            i--;
+
+        if (i > m_gap_end)
+        {
+            size_type write = i--; // m_data[i] is erased
+            try
+            {
+                for (; i > m_gap_end; i--)
+                {
+                    if (!pred(m_data[i - 1]))
+                        m_data[--write] = std::move(m_data[i - 1]);
+                }
+            }
+            catch (...)
+            {
+                std::move_backward(m_data + m_gap_end, m_data + i, m_data + write);
+                write -= i - m_gap_end;
+                detail::destroy_range(m_alloc, m_data + m_gap_end, m_data + write);
+                m_gap_end = write;
+                throw;
+            }
+
+            detail::destroy_range(m_alloc, m_data + m_gap_end, m_data + write);
+            m_gap_end = write;
+        }
+
+        return old_size - size();
+    }
+
+    // O(n) - Linear time
+    template <class T, class Allocator, class GrowthPolicy>
+    inline typename gap_buffer<T, Allocator, GrowthPolicy>::size_type gap_buffer<T, Allocator, GrowthPolicy>::remove(const T &value)
+    {
+        // value may be one of the elements - compare against a copy which is not moved over
+        const T needle = value;
+        return erase_if([&needle](const T &el)
+                        { return el == needle; });
+    }
+
+    // O(n) - Linear time (destructors of the stored elements)
+    template <class T, class Allocator, class GrowthPolicy>
+    inline void gap_buffer<T, Allocator, GrowthPolicy>::clear()
+    {
+        detail::destroy_range(m_alloc, m_data, m_data + m_gap_begin);
+        detail::destroy_range(m_alloc, m_data + m_gap_end, m_data + m_capacity);
+        m_gap_begin = 0;
+        m_gap_end = m_capacity;
+    }
+
+    // O(n) - Linear time, if the capacity grows
+    template <class T, class Allocator, class GrowthPolicy>
+    inline void gap_buffer<T, Allocator, GrowthPolicy>::reserve(size_type new_capacity)
+    {
+        if (new_capacity <= m_capacity)
+            return;
+
+        if (new_capacity > max_size())
+            throw std::length_error("Requested capacity exceeds max_size()!");
+
+        reallocate(new_capacity);
+    }
+
+    // O(n) - Linear time
+    template <class T, class Allocator, class GrowthPolicy>
+    inline void gap_buffer<T, Allocator, GrowthPolicy>::shrink_to_fit()
+    {
+        if (gap_size() == 0)
+            return;
+
+        if (empty())
+        {
+            release();
+            return;
+        }
+
+        reallocate(size());
+    }
+
+    // O(1) - Constant time
+    template <class T, class Allocator, class GrowthPolicy>
+    inline typename gap_buffer<T, Allocator, GrowthPolicy>::size_type gap_buffer<T, Allocator, GrowthPolicy>::max_size() const noexcept
+    {
+        // Iterator differences must fit in std::ptrdiff_t
+        const size_type max_elements = std::numeric_limits<std::ptrdiff_t>::max() / sizeof(T);
+        const size_type alloc_max = alloc_traits::max_size(m_alloc);
+
+        return alloc_max < max_elements ? alloc_max : max_elements;
+    }
+
+    // O(n) - Linear time
+    template <class T, class Allocator, class GrowthPolicy>
+    inline typename gap_buffer<T, Allocator, GrowthPolicy>::size_type gap_buffer<T, Allocator, GrowthPolicy>::find(const T &value) const
+    {
+        for (size_type i = 0; i < m_gap_begin; i++)
+            if (m_data[i] == value)
+                return i;
+
+        for (size_type i = m_gap_end; i < m_capacity; i++)
+            if (m_data[i] == value)
+                return i - gap_size();
+
+        return npos;
+    }
+
+    // O(n) - Linear time
+    template <class T, class Allocator, class GrowthPolicy>
+    template <class Predicate>
+    inline typename gap_buffer<T, Allocator, GrowthPolicy>::size_type gap_buffer<T, Allocator, GrowthPolicy>::find_if(Predicate pred) const
+    {
+        for (size_type i = 0; i < m_gap_begin; i++)
+            if (pred(m_data[i]))
+                return i;
+
+        for (size_type i = m_gap_end; i < m_capacity; i++)
+            if (pred(m_data[i]))
+                return i - gap_size();
+
+        return npos;
+    }
+
+    // O(n) - Linear time
+    template <class T, class Allocator, class GrowthPolicy>
+    inline typename gap_buffer<T, Allocator, GrowthPolicy>::size_type gap_buffer<T, Allocator, GrowthPolicy>::count(const T &value) const
+    {
+        size_type matches = 0;
+        for (size_type i = 0; i < m_gap_begin; i++)
+            matches += m_data[i] == value;
+
+        for (size_type i = m_gap_end; i < m_capacity; i++)
+            matches += m_data[i] == value;
+
+        return matches;
+    }
+
+    // O(n) - Linear time
+    template <class T, class Allocator, class GrowthPolicy>
+    inline bool gap_buffer<T, Allocator, GrowthPolicy>::operator==(const gap_buffer &other) const
+    {
+        if (size() != other.size())
+            return false;
+
+        // The gaps split both buffers into up to three pieces which are contiguous in both
+        size_type index = 0;
+        while (index < size())
+        {
+            const size_type own = index < m_gap_begin ? m_gap_begin - index : size() - index;
+            const size_type theirs = index < other.m_gap_begin ? other.m_gap_begin - index : other.size() - index;
+            const size_type count = std::min(own, theirs);
+
+            if (!detail::equal(locate(index), other.locate(index), count))
+                return false;
+
+            index += count;
+        }
+
+        return true;
+    }
+
+    ///
+    // Helpers
+
+    // Moves [first, first + count) down to dest (dest < first), front to back
+    template <class T, class Allocator, class GrowthPolicy>
+    inline void gap_buffer<T, Allocator, GrowthPolicy>::relocate_left(T *first, size_type count, T *dest)
+    {
+        if constexpr (std::is_trivially_copyable_v<T>)
+        {
+            std::memmove(dest, first, count * sizeof(T));
+            m_gap_begin += count;
+            m_gap_end += count;
+        }
+        else
+        {
+            // One element at a time - the gap stays valid if a move throws
+            for (size_type i = 0; i < count; i++)
+            {
+                alloc_traits::construct(m_alloc, dest + i, std::move_if_noexcept(first[i]));
+                alloc_traits::destroy(m_alloc, first + i);
+                m_gap_begin++;
+                m_gap_end++;
+            }
+        }
+    }
+
+    // Moves [first, first + count) up to dest (dest > first), back to front
+    template <class T, class Allocator, class GrowthPolicy>
+    inline void gap_buffer<T, Allocator, GrowthPolicy>::relocate_right(T *first, size_type count, T *dest)
+    {
+        if constexpr (std::is_trivially_copyable_v<T>)
+        {
+            std::memmove(dest, first, count * sizeof(T));
+            m_gap_begin -= count;
+            m_gap_end -= count;
+        }
+        else
+        {
+            for (size_type i = count; i-- > 0;)
+            {
+                alloc_traits::construct(m_alloc, dest + i, std::move_if_noexcept(first[i]));
+                alloc_traits::destroy(m_alloc, first + i);
+                m_gap_begin--;
+                m_gap_end--;
+            }
+        }
+    }
+
+    // Grows once if the gap is too small, moves it to position and constructs the range in it.
+    // If a copy throws, the elements constructed so far are destroyed and the gap is left at position.
+    template <class T, class Allocator, class GrowthPolicy>
+    template <class ForwardIt>
+    inline void gap_buffer<T, Allocator, GrowthPolicy>::insert_forward(size_type position, ForwardIt first, ForwardIt last, size_type count)
+    {
+        if (count == 0)
+            return;
+
+        if (count > gap_size())
+        {
+            if (count > max_size() - size())
+                throw std::length_error("Requested size exceeds max_size()!");
+
+            // Keeps the amortized growth if the range is small
+            size_type new_capacity = detail::next_capacity<GrowthPolicy>(m_capacity, max_size(), sizeof(T));
+            if (new_capacity < size() + count)
+                new_capacity = size() + count;
+
+            reallocate(new_capacity);
+        }
+
+        move_gap(position);
+        detail::uninitialized_copy(m_alloc, first, last, m_data + m_gap_begin);
+        m_gap_begin += count;
+    }
+
+    // O(n) - Linear time
+    template <class T, class Allocator, class GrowthPolicy>
+    inline void gap_buffer<T, Allocator, GrowthPolicy>::grow()
+    {
+        reallocate(detail::next_capacity<GrowthPolicy>(m_capacity, max_size(), sizeof(T)));
+    }
+
+    // Moves both runs into a buffer of new_capacity elements - the gap keeps its position and takes the new room.
+    // The elements are moved if that cannot throw, copied otherwise (strong guarantee).
+    template <class T, class Allocator, class GrowthPolicy>
+    inline void gap_buffer<T, Allocator, GrowthPolicy>::reallocate(size_type new_capacity)
+    {
+        const size_type tail = m_capacity - m_gap_end;
+        T *temp = alloc_traits::allocate(m_alloc, new_capacity);
+
+        try
+        {
+            detail::uninitialized_move_if_noexcept(m_alloc, m_data, m_data + m_gap_begin, temp);
+            try
+            {
+                detail::uninitialized_move_if_noexcept(m_alloc, m_data + m_gap_end, m_data + m_capacity, temp + new_capacity - tail);
+            }
+            catch (...)
+            {
+                detail::destroy_range(m_alloc, temp, temp + m_gap_begin);
+                throw;
+            }
+        }
+        catch (...)
+        {
+            alloc_traits::deallocate(m_alloc, temp, new_capacity);
+            throw;
+        }
+
+        const size_type front = m_gap_begin;
+        release();
+
+        m_data = temp;
+        m_capacity = new_capacity;
+        m_gap_begin = front;
+        m_gap_end = new_capacity - tail;
+    }
+
+    // Takes over the buffer of src, src is left empty with no storage
+    template <class T, class Allocator, class GrowthPolicy>
+    inline void gap_buffer<T, Allocator, GrowthPolicy>::steal(gap_buffer &src) noexcept
+    {
+        m_data = src.m_data;
+        m_capacity = src.m_capacity;
+        m_gap_begin = src.m_gap_begin;
+        m_gap_end = src.m_gap_end;
+
+        src.m_data = nullptr;
+        src.m_capacity = 0;
+        src.m_gap_begin = 0;
+        src.m_gap_end = 0;
+    }
+
+    // Destroys the elements and frees the buffer
+    template <class T, class Allocator, class GrowthPolicy>
+    inline void gap_buffer<T, Allocator, GrowthPolicy>::release() noexcept
+    {
+        detail::destroy_range(m_alloc, m_data, m_data + m_gap_begin);
+        detail::destroy_range(m_alloc, m_data + m_gap_end, m_data + m_capacity);
+
+        if (m_data)
+            alloc_traits::deallocate(m_alloc, m_data, m_capacity);
+
+        m_data = nullptr;
+        m_capacity = 0;
+        m_gap_begin = 0;
+        m_gap_end = 0;
+    }
+
+} // namespace ds
+
+#endif // GAP_BUFFER_GUARD
@@ -0,0 +1,376 @@
+#define CATCH_CONFIG_MAIN
+#include "../Catch2/catch.hpp"
+#include "gap_buffer.hpp"
+
+#include <algorithm>
+#include <memory_resource>
+#include <numeric>
+#include <random>
+#include <sstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+using namespace ds;
+
+template <class Buffer, class T>
+static bool same_elements(const Buffer &buffer, const std::vector<T> &expected)
+{
+    return buffer.size() == expected.size() && std::equal(buffer.begin(), buffer.end(), expected.begin());
+}
+
+// Copy ctor throws once the budget runs out, live instances are counted
+struct FragileCopy
+{
+    static int budget, alive;
+
+    explicit FragileCopy(int value) : value(value) { ++alive; }
+    FragileCopy(const FragileCopy &other) : value(other.value)
+    {
+        if (budget-- == 0)
+            throw std::runtime_error("copy");
+        ++alive;
+    }
+    ~FragileCopy() { --alive; }
+
+    int value;
+};
+
+int FragileCopy::budget = 0;
+int FragileCopy::alive = 0;
+
+TEST_CASE("CONSTRUCTORS", "[CONSTRUCTOR]")
+{
+    gap_buffer<int> def;
+
+    REQUIRE(def.size() == 0);
+    REQUIRE(def.empty());
+    REQUIRE(def.capacity() == INIT_CAPACITY);
+    REQUIRE(def.gap_position() == 0);
+    REQUIRE_THROWS(def.at(0));
+    REQUIRE_THROWS(def.front());
+    REQUIRE_THROWS(def.pop_back());
+    REQUIRE_THROWS_AS(gap_buffer<int>(0), std::invalid_argument);
+
+    gap_buffer<std::string> foo = {"a", "b", "c", "d"};
+    REQUIRE(foo.size() == 4);
+    REQUIRE(foo.front() == "a");
+    REQUIRE(foo.back() == "d");
+
+    foo.insert(1, "x"); // Gap inside the buffer
+    gap_buffer<std::string> bar(foo);
+    REQUIRE(bar == foo);
+    REQUIRE(bar.capacity() == bar.size()); // Copies are compact
+
+    bar[0] = "z";
+    REQUIRE(foo[0] == "a");
+    REQUIRE_FALSE(bar == foo);
+
+    bar = foo;
+    REQUIRE(bar == foo);
+
+    SECTION("MOVE")
+    {
+        gap_buffer<std::string> moved(std::move(bar));
+        REQUIRE(moved == foo);
+        REQUIRE(bar.empty());
+        REQUIRE(bar.capacity() == 0);
+
+        bar.push_back("q"); // The moved-from buffer is usable again
+        REQUIRE(bar.front() == "q");
+
+        bar = std::move(moved);
+        REQUIRE(bar == foo);
+        REQUIRE(moved.empty());
+    }
+
+    SECTION("ALLOCATOR PROPAGATION")
+    {
+        using pmr_buffer = gap_buffer<int, std::pmr::polymorphic_allocator<int>>;
+        std::pmr::monotonic_buffer_resource first, second;
+        pmr_buffer source({1, 2, 3, 4, 5}, &first);
+        pmr_buffer target(4, &second);
+
+        // polymorphic_allocator does not propagate - target keeps its resource
+        target = source;
+        REQUIRE(target == source);
+        REQUIRE(target.get_allocator().resource() == &second);
+
+        target = std::move(source); // Unequal resources - the elements are moved one by one
+        REQUIRE(same_elements(target, std::vector<int>{1, 2, 3, 4, 5}));
+        REQUIRE(target.get_allocator().resource() == &second);
+
+        pmr_buffer same(4, &second);
+        same = std::move(target); // Equal resources - the buffer is taken over
+        REQUIRE(same_elements(same, std::vector<int>{1, 2, 3, 4, 5}));
+        REQUIRE(target.capacity() == 0);
+    }
+
+    SECTION("THROWING COPY LEAVES NOTHING BEHIND")
+    {
+        FragileCopy::alive = 0;
+        FragileCopy::budget = 1000; // Growth copies too
+        {
+            gap_buffer<FragileCopy> src;
+            for (int i = 0; i < 4; i++)
+                src.emplace_back(i);
+            src.emplace(1, 9); // Both runs are non-empty
+
+            FragileCopy::budget = 2;
+            REQUIRE_THROWS_AS(gap_buffer<FragileCopy>(src), std::runtime_error);
+            REQUIRE(FragileCopy::alive == 5);
+
+            FragileCopy::budget = 2;
+            REQUIRE_THROWS_AS(gap_buffer<FragileCopy>({src[0], src[1], src[2], src[3]}), std::runtime_error);
+        }
+        REQUIRE(FragileCopy::alive == 0);
+    }
+}
+
+TEST_CASE("DEFAULT OPERATIONS", "[OPERATIONS]")
+{
+    gap_buffer<int> foo = {0, 1, 2, 3, 4, 5, 6, 7};
+
+    SECTION("INSERT MOVES THE GAP TO THE EDIT POINT")
+    {
+        foo.insert(3, 100);
+        REQUIRE(foo.gap_position() == 4);
+        REQUIRE(same_elements(foo, std::vector<int>{0, 1, 2, 100, 3, 4, 5, 6, 7}));
+
+        // Typing at the cursor - nothing behind the gap moves
+        foo.insert(4, 101);
+        foo.insert(5, 102);
+        REQUIRE(foo.gap_position() == 6);
+        REQUIRE(foo.before_gap().second == 6);
+        REQUIRE(foo.after_gap().second == 5);
+        REQUIRE(same_elements(foo, std::vector<int>{0, 1, 2, 100, 101, 102, 3, 4, 5, 6, 7}));
+
+        foo.insert(foo.size(), 8);
+        REQUIRE(foo.back() == 8);
+        REQUIRE_THROWS_AS(foo.insert(foo.size() + 1, 9), std::invalid_argument);
+    }
+
+    SECTION("ERASE AROUND THE GAP")
+    {
+        foo.insert(4, 100);
+        foo.erase(4); // The inserted element, in front of the gap
+        REQUIRE(same_elements(foo, std::vector<int>{0, 1, 2, 3, 4, 5, 6, 7}));
+
+        foo.erase(4); // Behind the gap
+        REQUIRE(foo.gap_position() == 4);
+        REQUIRE(same_elements(foo, std::vector<int>{0, 1, 2, 3, 5, 6, 7}));
+
+        foo.erase(1, 3);
+        REQUIRE(same_elements(foo, std::vector<int>{0, 3, 5, 6, 7}));
+
+        foo.erase(3, 5);
+        REQUIRE(same_elements(foo, std::vector<int>{0, 3, 5}));
+
+        foo.pop_back();
+        REQUIRE(foo.back() == 3);
+        REQUIRE_THROWS_AS(foo.erase(2), std::invalid_argument);
+        REQUIRE_THROWS_AS(foo.erase(1, 3), std::invalid_argument);
+    }
+
+    SECTION("GROWTH KEEPS THE GAP AT THE EDIT POINT")
+    {
+        for (int i = 0; i < 100; i++)
+            foo.insert(4 + i, 1000 + i);
+
+        REQUIRE(foo.size() == 108);
+        REQUIRE(foo.gap_position() == 104);
+        REQUIRE(foo[3] == 3);
+        REQUIRE(foo[4] == 1000);
+        REQUIRE(foo[103] == 1099);
+        REQUIRE(foo[104] == 4);
+        REQUIRE(foo.back() == 7);
+    }
+
+    SECTION("DATA CLOSES THE GAP")
+    {
+        foo.insert(2, 100);
+        const int *data = foo.data();
+
+        REQUIRE(foo.gap_position() == foo.size());
+        REQUIRE(foo.after_gap().second == 0);
+        REQUIRE(std::vector<int>(data, data + foo.size()) == std::vector<int>{0, 1, 100, 2, 3, 4, 5, 6, 7});
+    }
+
+    SECTION("FULL BUFFER HAS NO GAP TO MOVE")
+    {
+        gap_buffer<std::string> full(2);
+        full.push_back("first element, not a small string");
+        full.push_back("second element, not a small string");
+        full.insert(0, "inserted at the front of the buffer");
+        full.insert(1, "inserted right behind the first one");
+        REQUIRE(full.size() == full.capacity());
+
+        full.erase(3);
+        REQUIRE(same_elements(full, std::vector<std::string>{"inserted at the front of the buffer", "inserted right behind the first one",
+                                                             "first element, not a small string"}));
+
+        full.push_back("fills the buffer up again, no gap");
+        REQUIRE(full.size() == full.capacity());
+
+        const std::string *data = full.data();
+        REQUIRE(data[0] == "inserted at the front of the buffer");
+        REQUIRE(data[3] == "fills the buffer up again, no gap");
+
+        full.move_gap(1);
+        REQUIRE(full.gap_position() == 1);
+        REQUIRE(full[1] == "inserted right behind the first one");
+    }
+
+    SECTION("RANGE INSERT AT THE CURSOR")
+    {
+        std::vector<int> entries(1000);
+        std::iota(entries.begin(), entries.end(), 100);
+
+        foo.insert(3, entries.begin(), entries.end()); // One growth, one gap move
+        REQUIRE(foo.size() == 1008);
+        REQUIRE(foo.gap_position() == 1003);
+        REQUIRE(foo[2] == 2);
+        REQUIRE(foo[3] == 100);
+        REQUIRE(foo[1002] == 1099);
+        REQUIRE(foo[1003] == 3);
+
+        foo.insert(1003, 3, -1); // At the cursor
+        REQUIRE(foo.gap_position() == 1006);
+        REQUIRE(foo[1005] == -1);
+        REQUIRE(foo[1006] == 3);
+
+        std::istringstream input("7 8 9"); // Single pass
+        foo.insert(0, std::istream_iterator<int>(input), std::istream_iterator<int>());
+        REQUIRE(foo.front() == 7);
+        REQUIRE(foo[2] == 9);
+        REQUIRE(foo[3] == 0);
+
+        foo.append(entries.begin(), entries.begin() + 2);
+        REQUIRE(foo.size() == 1016);
+        REQUIRE(foo.back() == 101);
+        REQUIRE_THROWS_AS(foo.insert(foo.size() + 1, 1, 0), std::invalid_argument);
+    }
+
+    SECTION("ERASE IF AND REMOVE ON BOTH RUNS")
+    {
+        foo.insert(4, 100); // Gap between 100 and 4
+        REQUIRE(foo.erase_if([](int el)
+                             { return el % 2 == 1; }) == 4);
+        REQUIRE(same_elements(foo, std::vector<int>{0, 2, 100, 4, 6}));
+        REQUIRE(foo.gap_position() == 3);
+
+        foo.push_back(4);
+        REQUIRE(foo.remove(4) == 2);
+        REQUIRE(same_elements(foo, std::vector<int>{0, 2, 100, 6}));
+        REQUIRE(foo.find_if([](int el)
+                            { return el > 50; }) == 2);
+        REQUIRE(foo.find_if([](int el)
+                            { return el < 0; }) == gap_buffer<int>::npos);
+    }
+
+    SECTION("THROWING PREDICATE KEEPS THE UNVISITED ELEMENTS")
+    {
+        gap_buffer<std::string> words = {"a", "bb", "c", "dd", "e", "ff"};
+        words.insert(3, "gg"); // Both runs are non-empty
+
+        int calls = 0;
+        REQUIRE_THROWS(words.erase_if([&](const std::string &el)
+                                      {
+                                          if (++calls == 6)
+                                              throw std::runtime_error("predicate");
+                                          return el.size() == 1; }));
+
+        // The front run is compacted, the back run is visited last to first up to "e"
+        REQUIRE(same_elements(words, std::vector<std::string>{"bb", "gg", "dd", "e", "ff"}));
+    }
+
+    SECTION("SEARCH")
+    {
+        foo.insert(4, 3);
+        REQUIRE(foo.find(3) == 3);
+        REQUIRE(foo.find(6) == 7);
+        REQUIRE(foo.find(42) == gap_buffer<int>::npos);
+        REQUIRE(foo.count(3) == 2);
+        REQUIRE(foo.contains(7));
+        REQUIRE_FALSE(foo.contains(-1));
+    }
+}
+
+TEST_CASE("CLUSTERED EDITS", "[OPERATIONS]")
+{
+    // Same edits on a std::vector - a cursor that mostly stays put and sometimes jumps
+    std::mt19937 gen(7);
+    gap_buffer<std::string> buffer(4);
+    std::vector<std::string> expected;
+    std::size_t cursor = 0;
+
+    for (int i = 0; i < 2000; i++)
+    {
+        const unsigned int action = gen() % 10;
+        if (action == 0)
+            cursor = expected.empty() ? 0 : gen() % (expected.size() + 1);
+
+        if (action < 7 || expected.empty())
+        {
+            const std::string value = "entry " + std::to_string(i);
+            buffer.insert(cursor, value);
+            expected.insert(expected.begin() + cursor, value);
+            cursor++;
+        }
+        else if (cursor < expected.size())
+        {
+            buffer.erase(cursor);
+            expected.erase(expected.begin() + cursor);
+        }
+        else
+        {
+            cursor--;
+            buffer.erase(cursor);
+            expected.erase(expected.begin() + cursor);
+        }
+    }
+
+    REQUIRE(same_elements(buffer, expected));
+
+    // Self-referencing insert - the argument is relocated while the gap moves
+    buffer.insert(0, buffer.back());
+    expected.insert(expected.begin(), expected.back());
+    REQUIRE(same_elements(buffer, expected));
+
+    buffer.shrink_to_fit();
+    REQUIRE(buffer.capacity() == expected.size());
+    REQUIRE(same_elements(buffer, expected));
+
+    buffer.clear();
+    REQUIRE(buffer.empty());
+    buffer.shrink_to_fit();
+    REQUIRE(buffer.capacity() == 0);
+    buffer.push_back("again");
+    REQUIRE(buffer.capacity() == INIT_CAPACITY);
+}
+
+TEST_CASE("ITERATORS", "[ITERATOR]")
+{
+    gap_buffer<int> foo;
+    for (int i = 0; i < 50; i++)
+        foo.push_back(i);
+    foo.move_gap(20);
+
+    REQUIRE(foo.end() - foo.begin() == 50);
+    REQUIRE(std::accumulate(foo.cbegin(), foo.cend(), 0) == 49 * 50 / 2);
+    REQUIRE(std::is_sorted(foo.begin(), foo.end()));
+    REQUIRE(foo.begin()[25] == 25);
+
+    for (int &el : foo)
+        el *= 2;
+    REQUIRE(foo[19] == 38);
+    REQUIRE(foo[20] == 40);
+
+    gap_buffer<int>::const_iterator it = foo.begin();
+    REQUIRE(*(it + 49) == 98);
+    REQUIRE(std::lower_bound(foo.begin(), foo.end(), 60) - foo.begin() == 30);
+
+    REQUIRE(*foo.rbegin() == 98);
+    REQUIRE(foo.crend() - foo.crbegin() == 50);
+    REQUIRE(std::is_sorted(foo.rbegin(), foo.rend(), std::greater<>()));
+}
@@ -0,0 +1,611 @@
+#ifndef MAPPED_ARRAY_GUARD
+#define MAPPED_ARRAY_GUARD
+
+/*
+ *  Random access sequence container (array) with the dynamic_array interface
+ *  whose elements live in a memory-mapped file (MAP_SHARED).
+ *
+ *  The file starts with a 64 byte header (magic, version, element size and
+ *  element count) followed by the capacity worth of elements. Reopening an
+ *  existing file only maps it - the pages are read lazily on first access
+ *  and shared through the page cache by every process mapping the file.
+ *  The array grows with ftruncate() and mremap() (munmap() + mmap() on
+ *  other POSIX systems).
+ *
+ *  Only trivially copyable element types can be stored - the bytes in the
+ *  file are the objects. The file is bound to the layout of T on this
+ *  platform (byte order included).
+*/
+
+#include "dynamic_array.hpp" // Shared helpers, iterator and growth policies
+
+#include <cerrno>       // errno
+#include <cstdint>      // Header fields
+#include <cstring>      // std::memcmp, std::memcpy
+#include <string>       // File path
+#include <system_error> // OS failures
+
+#include <fcntl.h>    // open
+#include <sys/mman.h> // mmap, mremap, munmap, msync
+#include <sys/stat.h> // fstat
+#include <unistd.h>   // ftruncate, close
+
+namespace ds
+{
+    // How a mapped_array opens its file
+    enum class map_mode
+    {
+        read_write, // Opens the file or creates an empty array in it
+        read_only   // Opens an existing file; every modification and every non-const access throws std::logic_error
+    };
+
+    namespace detail
+    {
+        // Layout of the first bytes of a mapped_array file
+        struct mapped_header
+        {
+            char magic[8];
+            std::uint32_t version;
+            std::uint32_t element_size;
+            std::uint64_t size;
+        };
+
+        inline constexpr char mapped_magic[8] = {'D', 'S', 'M', 'A', 'P', 'A', 'R', 'R'};
+        inline constexpr std::uint32_t mapped_version = 1;
+        inline constexpr std::size_t mapped_header_bytes = 64; // The elements start here
+
+        [[noreturn]] inline void throw_system_error(const char *what)
+        {
+            throw std::system_error(errno, std::generic_category(), what);
+        }
+    } // namespace detail
+
+    template <class T, class GrowthPolicy = growth::doubling>
+    class mapped_array
+    {
+        static_assert(std::is_trivially_copyable_v<T>, "mapped_array requires a trivially copyable element type");
+        static_assert(alignof(T) <= detail::mapped_header_bytes, "mapped_array: Element alignment exceeds the header size");
+
+    public:
+        using value_type = T;
+        using size_type = std::size_t;
+        using iterator = detail::array_iterator<T, mapped_array>;
+        using const_iterator = detail::array_iterator<const T, mapped_array>;
+
+        // Constructors, Destructors
+
+        // Maps the array stored in the file at path. In read_write mode a missing or
+        // empty file is created with room for m_capacity elements.
+        // Throws std::system_error if the file cannot be opened or mapped and
+        // std::runtime_error if it does not hold an array of T.
+        explicit mapped_array(const std::string &path, map_mode mode = map_mode::read_write,
+                              size_type m_capacity = INIT_CAPACITY);
+
+        // The mapping is owned by one object - it can be moved but not copied
+        mapped_array(mapped_array &&other) noexcept;
+        mapped_array &operator=(mapped_array &&other) noexcept;
+        mapped_array(const mapped_array &) = delete;
+        mapped_array &operator=(const mapped_array &) = delete;
+
+        // Unmaps the file; the elements stay in it
+        ~mapped_array();
+
+        ///
+        // Basic Operations
+
+        // Add one element to the back
+        void push_back(const T &el);
+
+        // Constructs an element in place at the back from args
+        template <class... Args>
+        T &emplace_back(Args &&...args);
+
+        // Appends the elements of [first, first + count)
+        void append(const T *first, size_type count);
+
+        ///
+        // Access operations - the non-const ones hand out writable elements and throw on a read-only array
+        const T &operator[](size_type index) const;
+        T &operator[](size_type index);
+        const T &at(size_type index) const;
+        T &at(size_type index);
+        const T &front() const;
+        T &front();
+        const T &back() const;
+        T &back();
+
+        T *data();
+        const T *data() const noexcept { return m_data; }
+
+        ///
+        // Remove operations
+        void pop_back();
+
+        // Removes all elements, the file keeps its capacity
+        void clear();
+
+        ///
+        // Capacity operations
+
+        // Grows the file to hold at least new_capacity elements
+        void reserve(size_type new_capacity);
+
+        // Truncates the file to the current size
+        void shrink_to_fit();
+
+        size_type size() const { return m_size; }
+        size_type capacity() const { return m_capacity; }
+        bool empty() const { return m_size == 0; }
+        bool is_read_only() const { return m_mode == map_mode::read_only; }
+
+        // Largest element count the file offsets can address
+        size_type max_size() const;
+
+        // Writes the dirty pages back to the file and waits for completion
+        void sync();
+
+        ///
+        // Iterator - pointer behaviour, read-only arrays are iterated through the const overloads
+        iterator begin() { return iterator(data()); }
+        iterator end() { return iterator(data() + m_size); }
+        const_iterator begin() const noexcept { return const_iterator(m_data); }
+        const_iterator end() const noexcept { return const_iterator(m_data + m_size); }
+        const_iterator cbegin() const noexcept { return begin(); }
+        const_iterator cend() const noexcept { return end(); }
+
+    private:
+        int m_fd = -1;
+        map_mode m_mode = map_mode::read_write;
+        unsigned char *m_mapping = nullptr; // Header followed by the elements
+        std::size_t m_mapped_bytes = 0;
+        T *m_data = nullptr;
+        size_type m_size = 0, m_capacity = 0;
+
+        ///
+        // Helpers
+    private:
+        detail::mapped_header &header() { return *reinterpret_cast<detail::mapped_header *>(m_mapping); }
+
+        static std::size_t file_bytes(size_type capacity) { return detail::mapped_header_bytes + capacity * sizeof(T); }
+
+        void map(std::size_t bytes);
+        void remap(size_type new_capacity);
+        void set_size(size_type size);
+        void require_writable() const;
+        void release() noexcept;
+    };
+
+    // O(1) - Constant time (the elements are not read)
+    template <class T, class GrowthPolicy>
+    inline mapped_array<T, GrowthPolicy>::mapped_array(const std::string &path, map_mode mode, size_type m_capacity)
+        : m_mode(mode)
+    {
+        if (m_capacity == 0)
+            throw std::invalid_argument("Capacity has to be greater than zero!");
+
+        m_fd = mode == map_mode::read_only ? ::open(path.c_str(), O_RDONLY | O_CLOEXEC)
+                                           : ::open(path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+        if (m_fd < 0)
+            detail::throw_system_error("mapped_array: Cannot open the file");
+
+        try
+        {
+            struct stat info;
+            if (::fstat(m_fd, &info) != 0)
+                detail::throw_system_error("mapped_array: Cannot stat the file");
+
+            const std::size_t bytes = static_cast<std::size_t>(info.st_size);
+
+            if (bytes == 0 && mode == map_mode::read_write)
+            {
+                // New file - header and room for m_capacity elements
+                if (m_capacity > max_size())
+                    throw std::length_error("mapped_array: Requested capacity exceeds max_size()!");
+
+                if (::ftruncate(m_fd, file_bytes(m_capacity)) != 0)
+                    detail::throw_system_error("mapped_array: Cannot resize the file");
+
+                map(file_bytes(m_capacity));
+
+                detail::mapped_header &head = header();
+                std::memcpy(head.magic, detail::mapped_magic, sizeof(head.magic));
+                head.version = detail::mapped_version;
+                head.element_size = sizeof(T);
+                head.size = 0;
+
+                this->m_capacity = m_capacity;
+                return;
+            }
+
+            if (bytes < detail::mapped_header_bytes)
+                throw std::runtime_error("mapped_array: The file is not a mapped array!");
+
+            map(bytes);
+
+            const detail::mapped_header &head = header();
+            if (std::memcmp(head.magic, detail::mapped_magic, sizeof(head.magic)) != 0 || head.version != detail::mapped_version)
+                throw std::runtime_error("mapped_array: The file is not a mapped array!");
+            if (head.element_size != sizeof(T))
+                throw std::runtime_error("mapped_array: The element size does not match!");
+
+            this->m_capacity = (bytes - detail::mapped_header_bytes) / sizeof(T);
+            if (head.size > this->m_capacity)
+                throw std::runtime_error("mapped_array: The file is truncated!");
+
+            m_size = head.size;
+        }
+        catch (...)
+        {
+            release();
+            throw;
+        }
+    }
+
+    // O(1) - Constant time
+    template <class T, class GrowthPolicy>
+    inline mapped_array<T, GrowthPolicy>::mapped_array(mapped_array &&other) noexcept
+        : m_fd(other.m_fd), m_mode(other.m_mode), m_mapping(other.m_mapping), m_mapped_bytes(other.m_mapped_bytes),
+          m_data(other.m_data), m_size(other.m_size), m_capacity(other.m_capacity)
+    {
+        other.m_fd = -1;
+        other.m_mapping = nullptr;
+        other.m_mapped_bytes = 0;
+        other.m_data = nullptr;
+        other.m_size = other.m_capacity = 0;
+    }
+
+    // O(1) - Constant time
+    template <class T, class GrowthPolicy>
+    inline mapped_array<T, GrowthPolicy> &mapped_array<T, GrowthPolicy>::operator=(mapped_array &&other) noexcept
+    {
+        if (this != &other)
+        {
+            release();
+
+            std::swap(m_fd, other.m_fd);
+            std::swap(m_mode, other.m_mode);
+            std::swap(m_mapping, other.m_mapping);
+            std::swap(m_mapped_bytes, other.m_mapped_bytes);
+            std::swap(m_data, other.m_data);
+            std::swap(m_size, other.m_size);
+            std::swap(m_capacity, other.m_capacity);
+        }
+
+        return *this;
+    }
+
+    // O(1) - Constant time (dirty pages are written back by the kernel)
+    template <class T, class GrowthPolicy>
+    inline mapped_array<T, GrowthPolicy>::~mapped_array()
+    {
+        release();
+    }
+
+    // Amortized O(1) - Constant time
+    template <class T, class GrowthPolicy>
+    inline void mapped_array<T, GrowthPolicy>::push_back(const T &el)
+    {
+        emplace_back(el);
+    }
+
+    // Amortized O(1) - Constant time
+    template <class T, class GrowthPolicy>
+    template <class... Args>
+    inline T &mapped_array<T, GrowthPolicy>::emplace_back(Args &&...args)
+    {
+        require_writable();
+
+        // The element is built first - args may refer into the mapping, which moves on growth
+        T el(std::forward<Args>(args)...);
+
+        if (m_size == m_capacity)
+            remap(detail::next_capacity<GrowthPolicy>(m_capacity, max_size(), sizeof(T)));
+
+        std::memcpy(static_cast<void *>(m_data + m_size), &el, sizeof(T));
+        set_size(m_size + 1);
+
+        return m_data[m_size - 1];
+    }
+
+    // O(n) - Linear time
+    template <class T, class GrowthPolicy>
+    inline void mapped_array<T, GrowthPolicy>::append(const T *first, size_type count)
+    {
+        require_writable();
+
+        if (count > max_size() - m_size)
+            throw std::length_error("mapped_array: Requested size exceeds max_size()!");
+
+        if (m_size + count > m_capacity)
+        {
+            // The source may lie inside the mapping
+            if (first >= m_data && first < m_data + m_size)
+            {
+                const size_type offset = first - m_data;
+                reserve(std::max(m_size + count, detail::next_capacity<GrowthPolicy>(m_capacity, max_size(), sizeof(T))));
+                first = m_data + offset;
+            }
+            else
+            {
+                reserve(std::max(m_size + count, detail::next_capacity<GrowthPolicy>(m_capacity, max_size(), sizeof(T))));
+            }
+        }
+
+        if (count)
+            std::memcpy(static_cast<void *>(m_data + m_size), first, count * sizeof(T));
+        set_size(m_size + count);
+    }
+
+    // O(1) - Constant time
+    template <class T, class GrowthPolicy>
+    inline const T &mapped_array<T, GrowthPolicy>::operator[](size_type index) const
+    {
+        detail::check_subscript(index, m_size); // Policy selected by DS_BOUNDS_CHECK
+
+        return m_data[index];
+    }
+
+    // O(1) - Constant time
+    template <class T, class GrowthPolicy>
+    inline T &mapped_array<T, GrowthPolicy>::operator[](size_type index)
+    {
+        require_writable();
+
+        detail::check_subscript(index, m_size);
+
+        return m_data[index];
+    }
+
+    // O(1) - Constant time
+    template <class T, class GrowthPolicy>
+    inline const T &mapped_array<T, GrowthPolicy>::at(size_type index) const
+    {
+        if (index >= m_size)
+            throw std::out_of_range("Invalid index!");
+
+        return m_data[index];
+    }
+
+    // O(1) - Constant time
+    template <class T, class GrowthPolicy>
+    inline T &mapped_array<T, GrowthPolicy>::at(size_type index)
+    {
+        require_writable();
+
+        if (index >= m_size)
+            throw std::out_of_range("Invalid index!");
+
+        return m_data[index];
+    }
+
+    // O(1) - Constant time
+    template <class T, class GrowthPolicy>
+    inline const T &mapped_array<T, GrowthPolicy>::front() const
+    {
+        if (m_size == 0)
+            throw std::logic_error("Empty container!");
+
+        return m_data[0];
+    }
+
+    // O(1) - Constant time
+    template <class T, class GrowthPolicy>
+    inline T &mapped_array<T, GrowthPolicy>::front()
+    {
+        require_writable();
+
+        if (m_size == 0)
+            throw std::logic_error("Empty container!");
+
+        return m_data[0];
+    }
+
+    // O(1) - Constant time
+    template <class T, class GrowthPolicy>
+    inline const T &mapped_array<T, GrowthPolicy>::back() const
+    {
+        if (m_size == 0)
+            throw std::logic_error("Empty container!");
+
+        return m_data[m_size - 1];
+    }
+
+    // O(1) - Constant time
+    template <class T, class GrowthPolicy>
+    inline T &mapped_array<T, GrowthPolicy>::back()
+    {
+        require_writable();
+
+        if (m_size == 0)
+            throw std::logic_error("Empty container!");
+
+        return m_data[m_size - 1];
+    }
+
+    // O(1) - Constant time
+    template <class T, class GrowthPolicy>
+    inline T *mapped_array<T, GrowthPolicy>::data()
+    {
+        require_writable();
+
+        return m_data;
+    }
+
+    // O(1) - Constant time
+    template <class T, class GrowthPolicy>
+    inline void mapped_array<T, GrowthPolicy>::pop_back()
+    {
+        require_writable();
+
+        if (m_size == 0)
+            throw std::logic_error("Empty container!");
+
+        set_size(m_size - 1);
+    }
+
+    // O(1) - Constant time
+    template <class T, class GrowthPolicy>
+    inline void mapped_array<T, GrowthPolicy>::clear()
+    {
+        require_writable();
+
+        set_size(0);
+    }
+
+    // O(1) - Constant time (no element is copied)
+    template <class T, class GrowthPolicy>
+    inline void mapped_array<T, GrowthPolicy>::reserve(size_type new_capacity)
+    {
+        require_writable();
+
+        if (new_capacity <= m_capacity)
+            return;
+
+        if (new_capacity > max_size())
+            throw std::length_error("mapped_array: Requested capacity exceeds max_size()!");
+
+        remap(new_capacity);
+    }
+
+    // O(1) - Constant time
+    template <class T, class GrowthPolicy>
+    inline void mapped_array<T, GrowthPolicy>::shrink_to_fit()
+    {
+        require_writable();
+
+        if (m_size < m_capacity)
+            remap(m_size);
+    }
+
+    // O(1) - Constant time
+    template <class T, class GrowthPolicy>
+    inline typename mapped_array<T, GrowthPolicy>::size_type mapped_array<T, GrowthPolicy>::max_size() const
+    {
+        constexpr std::size_t limit = static_cast<std::size_t>(std::numeric_limits<off_t>::max()) < std::numeric_limits<std::size_t>::max()
+                                          ? static_cast<std::size_t>(std::numeric_limits<off_t>::max())
+                                          : std::numeric_limits<std::size_t>::max();
+
+        return (limit - detail::mapped_header_bytes) / sizeof(T);
+    }
+
+    // O(n) - Linear time in the number of dirty pages
+    template <class T, class GrowthPolicy>
+    inline void mapped_array<T, GrowthPolicy>::sync()
+    {
+        if (m_mapping && m_mode == map_mode::read_write && ::msync(m_mapping, m_mapped_bytes, MS_SYNC) != 0)
+            detail::throw_system_error("mapped_array: Cannot write the mapping back");
+    }
+
+    ///
+    // Helpers
+
+    // Maps the first bytes of the file
+    template <class T, class GrowthPolicy>
+    inline void mapped_array<T, GrowthPolicy>::map(std::size_t bytes)
+    {
+        const int protection = m_mode == map_mode::read_only ? PROT_READ : PROT_READ | PROT_WRITE;
+
+        void *ptr = ::mmap(nullptr, bytes, protection, MAP_SHARED, m_fd, 0);
+        if (ptr == MAP_FAILED)
+            detail::throw_system_error("mapped_array: Cannot map the file");
+
+        m_mapping = static_cast<unsigned char *>(ptr);
+        m_mapped_bytes = bytes;
+        m_data = reinterpret_cast<T *>(m_mapping + detail::mapped_header_bytes);
+    }
+
+    // Resizes the file and its mapping to new_capacity elements. The mapping never reaches past the end of
+    // the file: growing resizes the file first, shrinking the mapping first. On failure both keep the old size.
+    template <class T, class GrowthPolicy>
+    inline void mapped_array<T, GrowthPolicy>::remap(size_type new_capacity)
+    {
+        const std::size_t old_bytes = m_mapped_bytes;
+        const std::size_t new_bytes = file_bytes(new_capacity);
+        const bool growing = new_bytes > old_bytes;
+
+        if (growing && ::ftruncate(m_fd, new_bytes) != 0)
+            detail::throw_system_error("mapped_array: Cannot resize the file");
+
+        try
+        {
+#ifdef __linux__
+            void *ptr = ::mremap(m_mapping, old_bytes, new_bytes, MREMAP_MAYMOVE);
+            if (ptr == MAP_FAILED)
+                detail::throw_system_error("mapped_array: Cannot remap the file");
+
+            m_mapping = static_cast<unsigned char *>(ptr);
+            m_mapped_bytes = new_bytes;
+            m_data = reinterpret_cast<T *>(m_mapping + detail::mapped_header_bytes);
+#else
+            // The pages are shared with the file, so nothing is lost by unmapping first
+            ::munmap(m_mapping, old_bytes);
+            m_mapping = nullptr;
+            m_mapped_bytes = 0;
+            m_data = nullptr;
+
+            try
+            {
+                map(new_bytes);
+            }
+            catch (...)
+            {
+                try
+                {
+                    map(old_bytes);
+                }
+                catch (...)
+                {
+                    m_size = m_capacity = 0; // No mapping left - nothing can be accessed
+                }
+                throw;
+            }
+#endif
+        }
+        catch (...)
+        {
+            if (growing)
+                static_cast<void>(::ftruncate(m_fd, old_bytes));
+            throw;
+        }
+
+        m_capacity = new_capacity;
+
+        // The mapping is consistent already - a file which stays longer only keeps unused capacity
+        if (!growing && ::ftruncate(m_fd, new_bytes) != 0)
+            detail::throw_system_error("mapped_array: Cannot resize the file");
+    }
+
+    // Updates the size in memory and in the file header
+    template <class T, class GrowthPolicy>
+    inline void mapped_array<T, GrowthPolicy>::set_size(size_type size)
+    {
+        m_size = size;
+        header().size = size;
+    }
+
+    template <class T, class GrowthPolicy>
+    inline void mapped_array<T, GrowthPolicy>::require_writable() const
+    {
+        if (m_mode == map_mode::read_only)
+            throw std::logic_error("mapped_array: The array is read-only!");
+    }
+
+    // Unmaps the file and closes it
+    template <class T, class GrowthPolicy>
+    inline void mapped_array<T, GrowthPolicy>::release() noexcept
+    {
+        if (m_mapping)
+            ::munmap(m_mapping, m_mapped_bytes);
+        if (m_fd >= 0)
+            ::close(m_fd);
+
+        m_fd = -1;
+        m_mapping = nullptr;
+        m_mapped_bytes = 0;
+        m_data = nullptr;
+        m_size = m_capacity = 0;
+    }
+
+} // namespace ds
+
+#endif // MAPPED_ARRAY_GUARD
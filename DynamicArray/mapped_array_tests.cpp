@@ -0,0 +1,213 @@
+#define CATCH_CONFIG_MAIN
+#include "../Catch2/catch.hpp"
+#include "mapped_array.hpp"
+
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+
+using namespace ds;
+
+// Unique file in the temporary directory, removed when the test ends
+struct TempFile
+{
+    explicit TempFile(const char *name)
+        : path((std::filesystem::temp_directory_path() / (std::string("ds_") + name + "_" + std::to_string(::getpid()))).string())
+    {
+        std::remove(path.c_str());
+    }
+
+    ~TempFile() { std::remove(path.c_str()); }
+
+    std::string path;
+};
+
+struct Point
+{
+    int x, y;
+    double weight;
+};
+
+TEST_CASE("CONSTRUCTORS_DESTRUCTOR", "[CONSTRUCTOR][DESTRUCTOR]")
+{
+    SECTION("CREATES A NEW FILE")
+    {
+        TempFile file("create");
+        mapped_array<int> arr(file.path, map_mode::read_write, 4);
+
+        REQUIRE(arr.empty());
+        REQUIRE(arr.capacity() == 4);
+        REQUIRE_FALSE(arr.is_read_only());
+        REQUIRE(std::filesystem::file_size(file.path) == 64 + 4 * sizeof(int));
+        REQUIRE_THROWS((mapped_array<int>(file.path + "_", map_mode::read_write, 0)));
+    }
+
+    SECTION("REOPENS THE STORED ELEMENTS")
+    {
+        TempFile file("reopen");
+        {
+            mapped_array<Point> arr(file.path);
+            for (int i = 0; i < 100; i++)
+                arr.push_back({i, -i, i * 0.5});
+        }
+
+        mapped_array<Point> arr(file.path);
+
+        REQUIRE(arr.size() == 100);
+        REQUIRE(arr[42].x == 42);
+        REQUIRE(arr.back().weight == 49.5);
+
+        arr.push_back({100, -100, 50});
+        REQUIRE(arr.size() == 101);
+    }
+
+    SECTION("REJECTS FOREIGN FILES")
+    {
+        TempFile file("foreign");
+        {
+            std::ofstream out(file.path, std::ios::binary);
+            out << std::string(128, 'x');
+        }
+
+        REQUIRE_THROWS_AS(mapped_array<int>(file.path), std::runtime_error);
+        REQUIRE_THROWS_AS(mapped_array<int>(file.path + "_missing", map_mode::read_only), std::system_error);
+    }
+
+    SECTION("REJECTS A DIFFERENT ELEMENT SIZE")
+    {
+        TempFile file("element_size");
+        {
+            mapped_array<int> arr(file.path);
+            arr.push_back(1);
+        }
+
+        REQUIRE_THROWS_AS(mapped_array<double>(file.path), std::runtime_error);
+    }
+
+    SECTION("MOVE")
+    {
+        TempFile file("move");
+        mapped_array<int> arr(file.path);
+        arr.push_back(7);
+
+        mapped_array<int> moved(std::move(arr));
+        REQUIRE(moved.size() == 1);
+        REQUIRE(moved.front() == 7);
+        REQUIRE(arr.size() == 0);
+    }
+}
+
+TEST_CASE("DEFAULT OPERATIONS", "[OPERATIONS]")
+{
+    SECTION("GROWS THE FILE")
+    {
+        TempFile file("grow");
+        mapped_array<long> arr(file.path, map_mode::read_write, 2);
+
+        for (long i = 0; i < 10000; i++)
+            arr.push_back(i);
+
+        REQUIRE(arr.size() == 10000);
+        REQUIRE(arr.capacity() >= 10000);
+        REQUIRE(arr.at(9999) == 9999);
+        REQUIRE_THROWS(arr.at(10000));
+        REQUIRE(std::filesystem::file_size(file.path) == 64 + arr.capacity() * sizeof(long));
+    }
+
+    SECTION("APPEND, POP BACK AND CLEAR")
+    {
+        TempFile file("append");
+        mapped_array<int> arr(file.path, map_mode::read_write, 2);
+        const int values[] = {1, 2, 3, 4, 5};
+
+        arr.append(values, 5);
+        arr.append(arr.data(), 3); // Source inside the mapping
+        REQUIRE(arr.size() == 8);
+        REQUIRE(arr[7] == 3);
+
+        arr.pop_back();
+        REQUIRE(arr.back() == 2);
+
+        arr.clear();
+        REQUIRE(arr.empty());
+        REQUIRE_THROWS(arr.pop_back());
+        REQUIRE_THROWS(arr.front());
+    }
+
+    SECTION("RESERVE AND SHRINK TO FIT")
+    {
+        TempFile file("capacity");
+        mapped_array<int> arr(file.path);
+
+        arr.reserve(1000);
+        REQUIRE(arr.capacity() == 1000);
+
+        arr.push_back(1);
+        arr.shrink_to_fit();
+        REQUIRE(arr.capacity() == 1);
+        REQUIRE(std::filesystem::file_size(file.path) == 64 + sizeof(int));
+        REQUIRE(arr[0] == 1);
+
+        arr.push_back(2); // Grows again after the shrink
+        REQUIRE(arr.capacity() >= 2);
+        REQUIRE(std::filesystem::file_size(file.path) == 64 + arr.capacity() * sizeof(int));
+        REQUIRE(arr[1] == 2);
+    }
+
+    SECTION("READ ONLY")
+    {
+        TempFile file("read_only");
+        {
+            mapped_array<int> arr(file.path);
+            arr.push_back(1);
+            arr.push_back(2);
+            arr.sync();
+        }
+
+        mapped_array<int> arr(file.path, map_mode::read_only);
+        const mapped_array<int> &view = arr; // Reads go through the const overloads
+
+        REQUIRE(arr.is_read_only());
+        REQUIRE(arr.size() == 2);
+        REQUIRE(view[1] == 2);
+        REQUIRE(view.back() == 2);
+        REQUIRE(*view.begin() == 1);
+        REQUIRE_THROWS_AS(arr.push_back(3), std::logic_error);
+        REQUIRE_THROWS_AS(arr.clear(), std::logic_error);
+
+        // Writable access to the PROT_READ pages is refused instead of faulting
+        REQUIRE_THROWS_AS(arr[0] = 42, std::logic_error);
+        REQUIRE_THROWS_AS(arr.at(0), std::logic_error);
+        REQUIRE_THROWS_AS(arr.front(), std::logic_error);
+        REQUIRE_THROWS_AS(arr.data(), std::logic_error);
+        REQUIRE_THROWS_AS(arr.begin(), std::logic_error);
+        REQUIRE(view[0] == 1);
+    }
+
+    SECTION("SHARED BETWEEN MAPPINGS")
+    {
+        TempFile file("shared");
+        mapped_array<int> writer(file.path);
+        writer.push_back(1);
+
+        const mapped_array<int> reader(file.path, map_mode::read_only);
+        writer[0] = 42;
+
+        REQUIRE(reader[0] == 42); // Same page cache pages
+    }
+}
+
+TEST_CASE("ITERATOR", "[ITERATOR]")
+{
+    TempFile file("iterator");
+    mapped_array<int> arr(file.path);
+    for (int i = 1; i <= 4; i++)
+        arr.push_back(i);
+
+    int sum = 0;
+    for (int el : arr)
+        sum += el;
+
+    REQUIRE(sum == 10);
+    REQUIRE(arr.cend() - arr.cbegin() == 4);
+}
@@ -0,0 +1,142 @@
+#ifndef MMAP_ALLOCATOR_GUARD
+#define MMAP_ALLOCATOR_GUARD
+
+/*
+ *  Allocator for very large dynamic_array buffers.
+ *  Blocks of at least Threshold bytes are anonymous mmap() mappings
+ *  (advised for transparent huge pages) and grow with mremap(), which
+ *  moves page table entries instead of copying the data.
+ *  Smaller blocks come from ::operator new.
+ *
+ *  dynamic_array grows through reallocate() for trivially copyable
+ *  element types. On other platforms than Linux every block comes from
+ *  ::operator new and reallocate() copies.
+*/
+
+#include <cstddef>   // std::size_t
+#include <cstring>   // std::memcpy
+#include <new>       // std::bad_alloc, ::operator new
+#include <stdexcept> // std::length_error
+
+#ifdef __linux__
+#include <sys/mman.h> // mmap, mremap, munmap, madvise
+#endif
+
+namespace ds
+{
+    template <class T, std::size_t Threshold = (std::size_t(1) << 20)>
+    class mmap_allocator
+    {
+    public:
+        using value_type = T;
+        using is_always_equal = std::true_type; // Stateless
+
+        template <class U>
+        struct rebind
+        {
+            using other = mmap_allocator<U, Threshold>;
+        };
+
+        mmap_allocator() = default;
+
+        template <class U>
+        mmap_allocator(const mmap_allocator<U, Threshold> &) noexcept {}
+
+        // Storage for count objects, no constructors are called
+        T *allocate(std::size_t count)
+        {
+            return static_cast<T *>(allocate_bytes(bytes(count)));
+        }
+
+        void deallocate(T *ptr, std::size_t count) noexcept
+        {
+            // count was validated by allocate() - the product can not overflow here
+            deallocate_bytes(ptr, count * sizeof(T));
+        }
+
+        // Resizes the block at ptr holding old_count objects to new_count objects and
+        // returns its (possibly new) address. The objects are relocated bytewise,
+        // therefore it may only be used for trivially copyable types.
+        T *reallocate(T *ptr, std::size_t old_count, std::size_t new_count)
+        {
+            const std::size_t old_bytes = bytes(old_count);
+            const std::size_t new_bytes = bytes(new_count);
+
+#ifdef __linux__
+            if (is_mapped(old_bytes) && is_mapped(new_bytes))
+            {
+                void *moved = ::mremap(ptr, old_bytes, new_bytes, MREMAP_MAYMOVE);
+                if (moved == MAP_FAILED)
+                    throw std::bad_alloc();
+
+                return static_cast<T *>(moved);
+            }
+#endif
+
+            void *temp = allocate_bytes(new_bytes);
+            std::memcpy(temp, ptr, old_bytes < new_bytes ? old_bytes : new_bytes);
+            deallocate_bytes(ptr, old_bytes);
+
+            return static_cast<T *>(temp);
+        }
+
+        bool operator==(const mmap_allocator &) const { return true; }
+        bool operator!=(const mmap_allocator &) const { return false; }
+
+        ///
+        // Helpers
+    private:
+        static std::size_t bytes(std::size_t count)
+        {
+            if (count > std::size_t(-1) / sizeof(T))
+                throw std::length_error("mmap_allocator: Allocation size overflow!");
+
+            return count * sizeof(T);
+        }
+
+        static bool is_mapped(std::size_t bytes)
+        {
+#ifdef __linux__
+            return bytes >= Threshold;
+#else
+            (void)bytes;
+            return false;
+#endif
+        }
+
+        static void *allocate_bytes(std::size_t bytes)
+        {
+#ifdef __linux__
+            if (is_mapped(bytes))
+            {
+                void *ptr = ::mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+                if (ptr == MAP_FAILED)
+                    throw std::bad_alloc();
+
+#ifdef MADV_HUGEPAGE
+                ::madvise(ptr, bytes, MADV_HUGEPAGE); // Only a hint - failure is harmless
+#endif
+                return ptr;
+            }
+#endif
+
+            return ::operator new(bytes);
+        }
+
+        static void deallocate_bytes(void *ptr, std::size_t bytes) noexcept
+        {
+#ifdef __linux__
+            if (is_mapped(bytes))
+            {
+                ::munmap(ptr, bytes);
+                return;
+            }
+#endif
+
+            ::operator delete(ptr);
+        }
+    };
+
+} // namespace ds
+
+#endif // MMAP_ALLOCATOR_GUARD
@@ -0,0 +1,435 @@
+#ifndef PARALLEL_SORT_GUARD
+#define PARALLEL_SORT_GUARD
+
+/*
+ *  Parallel sorting of dynamic_array storage on a thread_pool.
+ *
+ *  parallel_sort / parallel_stable_sort - the array is cut into one chunk
+ *  per thread, the chunks are sorted concurrently and then merged pairwise;
+ *  every merge is split into independent pieces (co-ranking) so all threads
+ *  stay busy until the last round.
+ *  parallel_radix_sort - LSD radix sort (8 bits per pass) for integral
+ *  elements, passes where all elements share the digit are skipped.
+ *
+ *  Arrays shorter than DS_PARALLEL_SORT_THRESHOLD are sorted sequentially.
+*/
+
+#include "dynamic_array.hpp"
+#include "thread_pool.hpp"
+
+#include <algorithm>   // std::sort, std::stable_sort, std::merge
+#include <array>       // Radix histograms
+#include <cstddef>     // std::size_t
+#include <functional>  // std::less
+#include <memory>      // std::allocator, std::unique_ptr
+#include <type_traits> // Radix key types
+#include <vector>      // Per chunk histograms
+
+// Below this size the sort runs on the calling thread only
+#ifndef DS_PARALLEL_SORT_THRESHOLD
+#define DS_PARALLEL_SORT_THRESHOLD (1 << 15)
+#endif
+
+namespace ds
+{
+    namespace detail
+    {
+        namespace parallel
+        {
+            // Smallest chunk worth a task of its own
+            inline constexpr std::size_t min_chunk = 4096;
+
+            // Number of chunks for count elements on pool - a power of two, so the merge rounds pair up evenly
+            inline std::size_t chunk_count(std::size_t count, const thread_pool &pool)
+            {
+                const std::size_t threads = pool.size() + 1; // Workers and the calling thread
+                std::size_t chunks = 1;
+                while (chunks < threads && count / (chunks * 2) >= min_chunk)
+                    chunks *= 2;
+
+                return chunks;
+            }
+
+            // Start of chunk index when count elements are cut into chunks parts
+            inline std::size_t chunk_begin(std::size_t count, std::size_t chunks, std::size_t index)
+            {
+                return count / chunks * index + (count % chunks) * index / chunks;
+            }
+
+            // Number of elements of a taken by a stable merge of a and b before the output position k
+            template <class T, class Compare>
+            std::size_t co_rank(std::size_t k, const T *a, std::size_t a_size, const T *b, std::size_t b_size, Compare &comp)
+            {
+                std::size_t low = k > b_size ? k - b_size : 0;
+                std::size_t high = k < a_size ? k : a_size;
+
+                while (low < high)
+                {
+                    const std::size_t i = low + (high - low) / 2;
+                    const std::size_t j = k - i;
+
+                    if (!comp(b[j - 1], a[i])) // a[i] precedes b[j - 1] - take more from a
+                        low = i + 1;
+                    else
+                        high = i;
+                }
+
+                return low;
+            }
+
+            // Stable merge of [a, a + a_size) and [b, b + b_size), moved into the constructed out. If comp throws,
+            // taken_a and taken_b tell how many elements of a and b were moved - they sit at the front of out.
+            template <class T, class Compare>
+            void move_merge(T *a, std::size_t a_size, T *b, std::size_t b_size, T *out, Compare &comp,
+                            std::size_t &taken_a, std::size_t &taken_b)
+            {
+                std::size_t i = 0, j = 0;
+                try
+                {
+                    while (i < a_size && j < b_size)
+                    {
+                        if (comp(b[j], a[i]))
+                        {
+                            out[i + j] = std::move(b[j]);
+                            j++;
+                        }
+                        else
+                        {
+                            out[i + j] = std::move(a[i]);
+                            i++;
+                        }
+                    }
+                }
+                catch (...)
+                {
+                    taken_a = i;
+                    taken_b = j;
+                    throw;
+                }
+
+                std::move(a + i, a + a_size, out + i + j);
+                std::move(b + j, b + b_size, out + a_size + j);
+                taken_a = a_size;
+                taken_b = b_size;
+            }
+
+            // Uninitialized buffer of count elements which destroys them on exit
+            template <class T>
+            class merge_buffer
+            {
+            public:
+                explicit merge_buffer(std::size_t count) : m_data(m_alloc.allocate(count)), m_size(count) {}
+
+                ~merge_buffer()
+                {
+                    if (m_constructed)
+                        std::destroy(m_data, m_data + m_size);
+                    m_alloc.deallocate(m_data, m_size);
+                }
+
+                merge_buffer(const merge_buffer &) = delete;
+                merge_buffer &operator=(const merge_buffer &) = delete;
+
+                T *data() { return m_data; }
+                void constructed() { m_constructed = true; }
+
+            private:
+                std::allocator<T> m_alloc;
+                T *m_data;
+                std::size_t m_size;
+                bool m_constructed = false;
+            };
+
+            // O(n log n / p + n log p) - Sorts [first, first + count) on pool
+            template <bool Stable, class T, class Compare>
+            void merge_sort(T *first, std::size_t count, Compare comp, thread_pool &pool)
+            {
+                const std::size_t chunks = chunk_count(count, pool);
+
+                // Moving into the buffer must not fail halfway, otherwise the elements could not be restored
+                if (chunks == 1 || !std::is_nothrow_move_constructible_v<T>)
+                {
+                    if constexpr (Stable)
+                        std::stable_sort(first, first + count, comp);
+                    else
+                        std::sort(first, first + count, comp);
+                    return;
+                }
+
+                merge_buffer<T> buffer(count);
+
+                // Chunks already moved into the buffer - one entry per task, so no vector<bool>
+                std::vector<char> moved(chunks, 0);
+
+                try
+                {
+                    pool.parallel_for(chunks, [&](std::size_t index)
+                                      {
+                                          T *begin = first + chunk_begin(count, chunks, index);
+                                          T *end = first + chunk_begin(count, chunks, index + 1);
+
+                                          if constexpr (Stable)
+                                              std::stable_sort(begin, end, comp);
+                                          else
+                                              std::sort(begin, end, comp);
+
+                                          std::uninitialized_move(begin, end, buffer.data() + (begin - first));
+                                          moved[index] = 1;
+                                      });
+                }
+                catch (...)
+                {
+                    // comp threw in some chunk - the moved ones go back, so no element is lost or leaked
+                    for (std::size_t index = 0; index < chunks; index++)
+                    {
+                        if (!moved[index])
+                            continue;
+
+                        const std::size_t begin = chunk_begin(count, chunks, index);
+                        const std::size_t end = chunk_begin(count, chunks, index + 1);
+                        std::move(buffer.data() + begin, buffer.data() + end, first + begin);
+                        std::destroy(buffer.data() + begin, buffer.data() + end);
+                    }
+                    throw;
+                }
+                buffer.constructed();
+
+                // Sorted runs of width chunks are merged from src into dst, the roles swap every round
+                T *src = buffer.data();
+                T *dst = first;
+
+                // Start of the a-run part of every merge piece, computed before any element is moved
+                std::vector<std::size_t> splits(chunks);
+
+                // Elements every merge piece took from its a-run and b-run - what goes back if comp throws
+                std::vector<std::size_t> taken_a(chunks), taken_b(chunks);
+
+                for (std::size_t width = 1; width < chunks; width *= 2)
+                {
+                    // Each pair of runs is split into 2 * width output pieces - chunks tasks per round
+                    auto piece_bounds = [&, width](std::size_t index, std::size_t &low, std::size_t &mid,
+                                                   std::size_t &high, std::size_t &out)
+                    {
+                        const std::size_t pair = index / (2 * width);
+                        const std::size_t piece = index % (2 * width);
+
+                        low = chunk_begin(count, chunks, pair * 2 * width);
+                        mid = chunk_begin(count, chunks, pair * 2 * width + width);
+                        high = chunk_begin(count, chunks, (pair + 1) * 2 * width);
+                        out = (high - low) * piece / (2 * width);
+                    };
+
+                    // Piece index merges src[low + a_begin, low + a_end) and src[b_begin, b_end) into dst[low + out_begin, ...)
+                    auto piece_runs = [&, width](std::size_t index, std::size_t &low, std::size_t &mid, std::size_t &out_begin,
+                                                 std::size_t &a_begin, std::size_t &a_end, std::size_t &b_begin, std::size_t &b_end)
+                    {
+                        std::size_t high;
+                        piece_bounds(index, low, mid, high, out_begin);
+
+                        // The last piece of a pair ends with both runs
+                        const bool last = index % (2 * width) == 2 * width - 1;
+                        const std::size_t out_end = last ? high - low : (high - low) * (index % (2 * width) + 1) / (2 * width);
+                        a_begin = splits[index];
+                        a_end = last ? mid - low : splits[index + 1];
+                        b_begin = mid + (out_begin - a_begin);
+                        b_end = mid + (out_end - a_end);
+                    };
+
+                    bool merging = false;
+                    try
+                    {
+                        for (std::size_t index = 0; index < chunks; index++)
+                        {
+                            std::size_t low, mid, high, out;
+                            piece_bounds(index, low, mid, high, out);
+                            splits[index] = co_rank(out, src + low, mid - low, src + mid, high - mid, comp);
+                            taken_a[index] = taken_b[index] = 0;
+                        }
+
+                        merging = true;
+                        pool.parallel_for(chunks, [&](std::size_t index)
+                                          {
+                                              std::size_t low, mid, out_begin, a_begin, a_end, b_begin, b_end;
+                                              piece_runs(index, low, mid, out_begin, a_begin, a_end, b_begin, b_end);
+
+                                              move_merge(src + low + a_begin, a_end - a_begin, src + b_begin, b_end - b_begin,
+                                                         dst + low + out_begin, comp, taken_a[index], taken_b[index]);
+                                          });
+                    }
+                    catch (...)
+                    {
+                        // comp threw - every merged element goes back to the slot of src it came from (in some order),
+                        // so src holds all elements again and they end up in first
+                        if (merging)
+                        {
+                            for (std::size_t index = 0; index < chunks; index++)
+                            {
+                                std::size_t low, mid, out_begin, a_begin, a_end, b_begin, b_end;
+                                piece_runs(index, low, mid, out_begin, a_begin, a_end, b_begin, b_end);
+
+                                T *merged = dst + low + out_begin;
+                                std::move(merged, merged + taken_a[index], src + low + a_begin);
+                                std::move(merged + taken_a[index], merged + taken_a[index] + taken_b[index], src + b_begin);
+                            }
+                        }
+
+                        if (src != first)
+                            std::move(src, src + count, first);
+                        throw;
+                    }
+
+                    std::swap(src, dst);
+                }
+
+                // Odd number of rounds - the result is in the buffer
+                if (src != first)
+                {
+                    pool.parallel_for(chunks, [&](std::size_t index)
+                                      {
+                                          const std::size_t begin = chunk_begin(count, chunks, index);
+                                          const std::size_t end = chunk_begin(count, chunks, index + 1);
+                                          std::move(src + begin, src + end, first + begin);
+                                      });
+                }
+            }
+
+            // Unsigned key of value which orders like value itself
+            template <class T>
+            inline std::make_unsigned_t<T> radix_key(T value)
+            {
+                using key_type = std::make_unsigned_t<T>;
+                if constexpr (std::is_signed_v<T>)
+                    return static_cast<key_type>(value) ^ (key_type(1) << (sizeof(T) * 8 - 1)); // Negatives first
+                else
+                    return value;
+            }
+
+            // O(n * sizeof(T) / p) - Sorts [first, first + count) by 8 bit digits, least significant first.
+            // Returns the number of passes which moved the elements
+            template <class T>
+            std::size_t radix_sort(T *first, std::size_t count, thread_pool &pool)
+            {
+                using histogram = std::array<std::size_t, 256>;
+
+                const std::size_t chunks = chunk_count(count, pool);
+                std::unique_ptr<T[]> buffer(new T[count]);
+                std::vector<histogram> counts(chunks);
+
+                T *src = first;
+                T *dst = buffer.get();
+                std::size_t passes = 0;
+
+                for (std::size_t shift = 0; shift < sizeof(T) * 8; shift += 8)
+                {
+                    auto digit = [shift](T value)
+                    { return static_cast<std::size_t>((radix_key(value) >> shift) & 0xFF); };
+
+                    pool.parallel_for(chunks, [&](std::size_t index)
+                                      {
+                                          histogram &local = counts[index];
+                                          local.fill(0);
+
+                                          const std::size_t end = chunk_begin(count, chunks, index + 1);
+                                          for (std::size_t i = chunk_begin(count, chunks, index); i < end; i++)
+                                              local[digit(src[i])]++;
+                                      });
+
+                    // Every chunk scatters its elements of digit d behind those of the chunks before it
+                    bool trivial = false;
+                    std::size_t offset = 0;
+                    for (std::size_t d = 0; d < 256; d++)
+                    {
+                        const std::size_t digit_begin = offset;
+                        for (std::size_t index = 0; index < chunks; index++)
+                        {
+                            const std::size_t size = counts[index][d];
+                            counts[index][d] = offset;
+                            offset += size;
+                        }
+
+                        // The histograms are per chunk - the total of the digit is summed over all of them
+                        if (offset - digit_begin == count)
+                            trivial = true;
+                    }
+
+                    if (trivial)
+                        continue; // Every element has the same digit - the pass would not move anything
+
+                    pool.parallel_for(chunks, [&](std::size_t index)
+                                      {
+                                          histogram &position = counts[index];
+
+                                          const std::size_t end = chunk_begin(count, chunks, index + 1);
+                                          for (std::size_t i = chunk_begin(count, chunks, index); i < end; i++)
+                                              dst[position[digit(src[i])]++] = src[i];
+                                      });
+
+                    std::swap(src, dst);
+                    passes++;
+                }
+
+                if (src != first)
+                {
+                    pool.parallel_for(chunks, [&](std::size_t index)
+                                      {
+                                          const std::size_t begin = chunk_begin(count, chunks, index);
+                                          const std::size_t end = chunk_begin(count, chunks, index + 1);
+                                          std::copy(src + begin, src + end, first + begin);
+                                      });
+                }
+
+                return passes;
+            }
+        } // namespace parallel
+    } // namespace detail
+
+    // Sorts arr by comp (not stable) using the threads of pool
+    template <class T, class Allocator, class GrowthPolicy, class Compare = std::less<>>
+    void parallel_sort(dynamic_array<T, Allocator, GrowthPolicy> &arr, Compare comp = Compare(),
+                       thread_pool &pool = thread_pool::global())
+    {
+        if (arr.size() < 2)
+            return;
+
+        T *first = arr.data();
+        if (arr.size() < DS_PARALLEL_SORT_THRESHOLD)
+            std::sort(first, first + arr.size(), comp);
+        else
+            detail::parallel::merge_sort<false>(first, arr.size(), comp, pool);
+    }
+
+    // Sorts arr by comp, equal elements keep their order
+    template <class T, class Allocator, class GrowthPolicy, class Compare = std::less<>>
+    void parallel_stable_sort(dynamic_array<T, Allocator, GrowthPolicy> &arr, Compare comp = Compare(),
+                              thread_pool &pool = thread_pool::global())
+    {
+        if (arr.size() < 2)
+            return;
+
+        T *first = arr.data();
+        if (arr.size() < DS_PARALLEL_SORT_THRESHOLD)
+            std::stable_sort(first, first + arr.size(), comp);
+        else
+            detail::parallel::merge_sort<true>(first, arr.size(), comp, pool);
+    }
+
+    // Sorts arr of integers in ascending order with a radix sort
+    template <class T, class Allocator, class GrowthPolicy>
+    void parallel_radix_sort(dynamic_array<T, Allocator, GrowthPolicy> &arr, thread_pool &pool = thread_pool::global())
+    {
+        static_assert(std::is_integral_v<T> && !std::is_same_v<T, bool>,
+                      "parallel_radix_sort: The elements have to be integers!");
+
+        if (arr.size() < 2)
+            return;
+
+        T *first = arr.data();
+        if (arr.size() < DS_PARALLEL_SORT_THRESHOLD)
+            std::sort(first, first + arr.size());
+        else
+            detail::parallel::radix_sort(first, arr.size(), pool);
+    }
+
+} // namespace ds
+
+#endif // PARALLEL_SORT_GUARD
@@ -0,0 +1,258 @@
+#define CATCH_CONFIG_MAIN
+#include "../Catch2/catch.hpp"
+#include "parallel_sort.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <utility>
+
+using namespace ds;
+
+// Random values in [low, high]
+template <class T>
+dynamic_array<T> randomArray(std::size_t size, T low, T high, unsigned int seed = 42)
+{
+    std::mt19937_64 gen(seed);
+    std::uniform_int_distribution<long long> dist(low, high);
+
+    dynamic_array<T> arr(size);
+    for (std::size_t i = 0; i < size; i++)
+        arr.push_back(static_cast<T>(dist(gen)));
+
+    return arr;
+}
+
+template <class T>
+bool isSorted(dynamic_array<T> &arr)
+{
+    return arr.size() < 2 || std::is_sorted(&arr[0], &arr[0] + arr.size());
+}
+
+TEST_CASE("THREAD POOL", "[THREAD_POOL]")
+{
+    SECTION("PARALLEL FOR RUNS EVERY INDEX ONCE")
+    {
+        thread_pool pool(3);
+        const std::size_t TASKS = 100;
+        std::atomic<int> hits[TASKS] = {};
+
+        pool.parallel_for(TASKS, [&](std::size_t i)
+                          { hits[i]++; });
+
+        REQUIRE(pool.size() == 3);
+        REQUIRE(std::all_of(hits, hits + TASKS, [](const std::atomic<int> &hit)
+                            { return hit == 1; }));
+    }
+
+    SECTION("EXCEPTIONS REACH THE CALLER")
+    {
+        thread_pool pool(2);
+
+        REQUIRE_THROWS_AS(pool.parallel_for(8, [](std::size_t i)
+                                            { if (i == 5) throw std::runtime_error("task"); }),
+                          std::runtime_error);
+
+        std::atomic<int> done{0};
+        pool.parallel_for(4, [&](std::size_t)
+                          { done++; });
+        REQUIRE(done == 4); // Still usable
+    }
+}
+
+TEST_CASE("PARALLEL SORT", "[SORT]")
+{
+    thread_pool pool(4);
+
+    SECTION("SMALL ARRAYS USE THE SEQUENTIAL FALLBACK")
+    {
+        dynamic_array<int> empty;
+        dynamic_array<int> foo = {5, 3, 9, 1, 7};
+
+        parallel_sort(empty, std::less<>(), pool);
+        parallel_sort(foo, std::less<>(), pool);
+
+        REQUIRE(empty.empty());
+        REQUIRE(foo == dynamic_array<int>({1, 3, 5, 7, 9}));
+    }
+
+    SECTION("MATCHES STD::SORT")
+    {
+        // Sizes around the threshold and not divisible by the chunk count
+        for (std::size_t size : {std::size_t(DS_PARALLEL_SORT_THRESHOLD) - 1, std::size_t(100003), std::size_t(1) << 20})
+        {
+            dynamic_array<int> foo = randomArray<int>(size, -1000000, 1000000);
+            dynamic_array<int> expect(foo);
+            std::sort(&expect[0], &expect[0] + size);
+
+            parallel_sort(foo, std::less<>(), pool);
+
+            REQUIRE(foo == expect);
+        }
+    }
+
+    SECTION("CUSTOM COMPARISON AND NON-TRIVIAL ELEMENTS")
+    {
+        const std::size_t SIZE = 200000;
+        dynamic_array<int> keys = randomArray<int>(SIZE, 0, 1 << 30);
+        dynamic_array<std::string> foo(SIZE);
+        for (std::size_t i = 0; i < SIZE; i++)
+            foo.push_back(std::to_string(keys[i]));
+
+        parallel_sort(foo, std::greater<>(), pool);
+
+        REQUIRE(foo.size() == SIZE);
+        REQUIRE(std::is_sorted(&foo[0], &foo[0] + SIZE, std::greater<>()));
+    }
+
+    SECTION("THROWING COMPARISON LOSES NO ELEMENT")
+    {
+        const std::size_t SIZE = 200000;
+        dynamic_array<int> keys = randomArray<int>(SIZE, 0, 1 << 30);
+        dynamic_array<std::string> foo(SIZE);
+        for (std::size_t i = 0; i < SIZE; i++)
+            foo.push_back(std::to_string(keys[i]) + " - long enough for the heap");
+        foo[SIZE - 1] = "poison"; // Only the last chunk fails, the others are already in the buffer
+
+        dynamic_array<std::string> expect(foo);
+        std::sort(&expect[0], &expect[0] + SIZE);
+
+        auto comp = [](const std::string &lhs, const std::string &rhs)
+        {
+            if (lhs == "poison" || rhs == "poison")
+                throw std::runtime_error("comparison");
+            return lhs < rhs;
+        };
+
+        REQUIRE_THROWS_AS(parallel_sort(foo, comp, pool), std::runtime_error);
+
+        REQUIRE(foo.size() == SIZE);
+        std::sort(&foo[0], &foo[0] + SIZE);
+        REQUIRE(foo == expect);
+    }
+
+    SECTION("THROWING COMPARISON IN A MERGE ROUND LOSES NO ELEMENT")
+    {
+        const std::size_t SIZE = 200000;
+        dynamic_array<int> keys = randomArray<int>(SIZE, 0, 1 << 30);
+        dynamic_array<std::string> foo(SIZE);
+        for (std::size_t i = 0; i < SIZE; i++)
+            foo.push_back(std::to_string(keys[i]) + " - long enough for the heap");
+
+        dynamic_array<std::string> expect(foo);
+        std::sort(&expect[0], &expect[0] + SIZE);
+
+        // The number of comparisons is the same in every run - count them once
+        std::atomic<std::size_t> calls{0};
+        std::size_t limit = 0;
+        auto comp = [&](const std::string &lhs, const std::string &rhs)
+        {
+            if (++calls > limit)
+                throw std::runtime_error("comparison");
+            return lhs < rhs;
+        };
+
+        limit = std::size_t(-1);
+        dynamic_array<std::string> sorted(foo);
+        parallel_sort(sorted, comp, pool);
+        const std::size_t total = calls;
+
+        // The last rounds merge all elements - each throws after about SIZE comparisons
+        for (std::size_t before_end : {SIZE / 2, SIZE + SIZE / 2})
+        {
+            dynamic_array<std::string> bar(foo);
+            calls = 0;
+            limit = total - before_end;
+
+            REQUIRE_THROWS_AS(parallel_sort(bar, comp, pool), std::runtime_error);
+
+            REQUIRE(bar.size() == SIZE);
+            std::sort(&bar[0], &bar[0] + SIZE);
+            REQUIRE(bar == expect);
+        }
+    }
+
+    SECTION("STABLE SORT KEEPS THE ORDER OF EQUAL ELEMENTS")
+    {
+        const std::size_t SIZE = 300001;
+        dynamic_array<int> keys = randomArray<int>(SIZE, 0, 99); // Many duplicates
+        dynamic_array<std::pair<int, std::size_t>> foo(SIZE);
+        for (std::size_t i = 0; i < SIZE; i++)
+            foo.emplace_back(keys[i], i);
+
+        parallel_stable_sort(foo, [](const auto &lhs, const auto &rhs)
+                             { return lhs.first < rhs.first; },
+                             pool);
+
+        REQUIRE(std::is_sorted(&foo[0], &foo[0] + SIZE)); // Pairs - by key, then original position
+    }
+
+    SECTION("DEFAULT POOL")
+    {
+        dynamic_array<double> foo(100000);
+        for (int i = 100000; i > 0; i--)
+            foo.push_back(i * 0.5);
+
+        parallel_sort(foo);
+
+        REQUIRE(foo.front() == 0.5);
+        REQUIRE(isSorted(foo));
+    }
+}
+
+TEST_CASE("PARALLEL RADIX SORT", "[SORT][RADIX]")
+{
+    thread_pool pool(4);
+
+    SECTION("SIGNED KEYS")
+    {
+        dynamic_array<std::int64_t> foo = randomArray<std::int64_t>(1 << 20, INT64_MIN, INT64_MAX);
+        dynamic_array<std::int64_t> expect(foo);
+        std::sort(&expect[0], &expect[0] + expect.size());
+
+        parallel_radix_sort(foo, pool);
+
+        REQUIRE(foo == expect);
+    }
+
+    SECTION("UNSIGNED KEYS WITH CONSTANT DIGITS")
+    {
+        // The upper bytes are all zero - those passes are skipped
+        dynamic_array<std::uint32_t> foo = randomArray<std::uint32_t>(500000, 0, 0xFFFF);
+        dynamic_array<std::uint32_t> expect(foo);
+        std::sort(&expect[0], &expect[0] + expect.size());
+
+        dynamic_array<std::uint32_t> bar(foo);
+        parallel_radix_sort(foo, pool);
+
+        REQUIRE(foo == expect);
+
+        // Split into several chunks - the digit totals are summed over all of them
+        REQUIRE(detail::parallel::chunk_count(bar.size(), pool) > 1);
+        REQUIRE(detail::parallel::radix_sort(bar.data(), bar.size(), pool) == 2);
+        REQUIRE(bar == expect);
+
+        // 64 bit keys with small values - only the lowest digit differs
+        dynamic_array<std::int64_t> baz = randomArray<std::int64_t>(500000, 0, 255);
+        dynamic_array<std::int64_t> sorted(baz);
+        std::sort(&sorted[0], &sorted[0] + sorted.size());
+
+        REQUIRE(detail::parallel::radix_sort(baz.data(), baz.size(), pool) == 1);
+        REQUIRE(baz == sorted);
+    }
+
+    SECTION("SMALL INTEGERS")
+    {
+        dynamic_array<std::int8_t> foo = randomArray<std::int8_t>(100000, -128, 127);
+        dynamic_array<short> bar = {3, -1, 2};
+
+        parallel_radix_sort(foo, pool);
+        parallel_radix_sort(bar);
+
+        REQUIRE(isSorted(foo));
+        REQUIRE(foo.front() == -128);
+        REQUIRE(bar == dynamic_array<short>({-1, 2, 3}));
+    }
+}
@@ -0,0 +1,665 @@
+#ifndef SEGMENTED_ARRAY_GUARD
+#define SEGMENTED_ARRAY_GUARD
+
+/*
+ *  Random access sequence container (array) with the dynamic_array interface
+ *  whose elements are never relocated.
+ *
+ *  The storage is a list of blocks: block 0 holds FirstBlock elements and
+ *  every further block twice as many as the one before. Growing allocates
+ *  the next block only, so pointers, references and iterators stay valid
+ *  until their element is removed. The blocks are found through a fixed
+ *  directory (one pointer per possible block), the block and offset of an
+ *  index are computed from its highest set bit - O(1) random access.
+*/
+
+#include "dynamic_array.hpp" // Shared element helpers
+
+#include <algorithm>   // std::min
+#include <cstddef>     // std::size_t
+#include <iterator>    // Iterator category
+#include <limits>      // Directory size
+#include <memory>      // std::allocator_traits
+#include <stdexcept>   // Exceptions
+#include <type_traits> // Const iterators
+#include <utility>     // std::move_if_noexcept
+
+namespace ds
+{
+    namespace detail
+    {
+        // Position of the highest set bit of value (value > 0)
+        constexpr unsigned int highest_bit(std::size_t value)
+        {
+#if defined(__GNUC__) || defined(__clang__)
+            return static_cast<unsigned int>(std::numeric_limits<unsigned long long>::digits - 1 - __builtin_clzll(value));
+#else
+            unsigned int bit = 0;
+            while (value >>= 1)
+                bit++;
+            return bit;
+#endif
+        }
+
+        // Block layout of the segmented containers: block k holds FirstBlock << k elements
+        template <std::size_t FirstBlock>
+        struct block_layout
+        {
+            static_assert(FirstBlock > 0 && (FirstBlock & (FirstBlock - 1)) == 0, "block_layout: FirstBlock has to be a power of two");
+
+            static constexpr unsigned int first_shift = highest_bit(FirstBlock);
+            static constexpr std::size_t max_blocks = std::numeric_limits<std::size_t>::digits - first_shift;
+
+            // Elements in block
+            static std::size_t block_size(std::size_t block) { return FirstBlock << block; }
+
+            // Index of the first element of block (the capacity of the blocks before it)
+            static std::size_t block_start(std::size_t block) { return (FirstBlock << block) - FirstBlock; }
+
+            // O(1) - Block holding index
+            static std::size_t block_of(std::size_t index) { return highest_bit(index + FirstBlock) - first_shift; }
+
+            // O(1) - Position of index inside its block
+            static std::size_t offset_of(std::size_t index)
+            {
+                const std::size_t shifted = index + FirstBlock;
+                return shifted - (std::size_t(1) << highest_bit(shifted));
+            }
+        };
+
+        // Random access iterator of the segmented containers - an index into the owner, every dereference
+        // asks the owner for the address (Owner::locate). T and Owner are const-qualified for const iterators.
+        template <class T, class Owner>
+        class indexed_iterator
+        {
+            template <class, class>
+            friend class indexed_iterator;
+            friend std::remove_const_t<Owner>;
+
+        public:
+            using iterator_category = std::random_access_iterator_tag;
+            using value_type = std::remove_const_t<T>;
+            using difference_type = std::ptrdiff_t;
+            using pointer = T *;
+            using reference = T &;
+
+            indexed_iterator() = default;
+
+            // iterator -> const_iterator
+            template <class U, class OtherOwner, class = std::enable_if_t<std::is_same_v<const U, T> && !std::is_same_v<U, T>>>
+            indexed_iterator(const indexed_iterator<U, OtherOwner> &other) : m_owner(other.m_owner), m_index(other.m_index) {}
+
+            reference operator*() const { return *m_owner->locate(m_index); }
+            pointer operator->() const { return m_owner->locate(m_index); }
+            reference operator[](difference_type offset) const { return *m_owner->locate(m_index + offset); }
+
+            indexed_iterator &operator++() // prefix
+            {
+                ++m_index;
+                return *this;
+            }
+
+            indexed_iterator operator++(int) // postfix
+            {
+                indexed_iterator copy(*this);
+                ++m_index;
+                return copy;
+            }
+
+            indexed_iterator &operator--() // prefix
+            {
+                --m_index;
+                return *this;
+            }
+
+            indexed_iterator operator--(int) // postfix
+            {
+                indexed_iterator copy(*this);
+                --m_index;
+                return copy;
+            }
+
+            indexed_iterator &operator+=(difference_type offset)
+            {
+                m_index += offset;
+                return *this;
+            }
+
+            indexed_iterator &operator-=(difference_type offset)
+            {
+                m_index -= offset;
+                return *this;
+            }
+
+            friend indexed_iterator operator+(indexed_iterator it, difference_type offset) { return it += offset; }
+            friend indexed_iterator operator+(difference_type offset, indexed_iterator it) { return it += offset; }
+            friend indexed_iterator operator-(indexed_iterator it, difference_type offset) { return it -= offset; }
+
+            friend difference_type operator-(const indexed_iterator &lhs, const indexed_iterator &rhs)
+            {
+                return static_cast<difference_type>(lhs.m_index) - static_cast<difference_type>(rhs.m_index);
+            }
+
+            // Comparison operators - iterators of the same container
+            friend bool operator==(const indexed_iterator &lhs, const indexed_iterator &rhs) { return lhs.m_index == rhs.m_index; }
+            friend bool operator!=(const indexed_iterator &lhs, const indexed_iterator &rhs) { return lhs.m_index != rhs.m_index; }
+            friend bool operator<(const indexed_iterator &lhs, const indexed_iterator &rhs) { return lhs.m_index < rhs.m_index; }
+            friend bool operator>(const indexed_iterator &lhs, const indexed_iterator &rhs) { return rhs < lhs; }
+            friend bool operator<=(const indexed_iterator &lhs, const indexed_iterator &rhs) { return !(rhs < lhs); }
+            friend bool operator>=(const indexed_iterator &lhs, const indexed_iterator &rhs) { return !(lhs < rhs); }
+
+        private:
+            indexed_iterator(Owner *owner, std::size_t index) : m_owner(owner), m_index(index) {}
+
+            Owner *m_owner = nullptr;
+            std::size_t m_index = 0;
+        };
+    } // namespace detail
+
+    template <class T, std::size_t FirstBlock = INIT_CAPACITY, class Allocator = std::allocator<T>>
+    class segmented_array
+    {
+        using alloc_traits = std::allocator_traits<Allocator>;
+        using layout = detail::block_layout<FirstBlock>;
+
+        template <class, class>
+        friend class detail::indexed_iterator;
+
+    public:
+        using value_type = T;
+        using allocator_type = Allocator;
+        using size_type = std::size_t;
+        using difference_type = std::ptrdiff_t;
+        using reference = T &;
+        using const_reference = const T &;
+
+        using iterator = detail::indexed_iterator<T, segmented_array>;
+        using const_iterator = detail::indexed_iterator<const T, const segmented_array>;
+
+        // Constructors, Destructors; Gang of Four
+
+        // Constructs an empty container, no block is allocated until the first element
+        explicit segmented_array(const Allocator &alloc = Allocator());
+
+        // Constructs a container with a copy of each of the elements in il, in the same order.
+        segmented_array(const std::initializer_list<T> &i_list, const Allocator &alloc = Allocator());
+
+        // Constructs a container with a copy of each of the elements and keep the original order
+        // The allocator is obtained by select_on_container_copy_construction
+        segmented_array(const segmented_array &other);
+
+        // Allocator-extended copy constructor
+        segmented_array(const segmented_array &other, const Allocator &alloc);
+
+        // Move constructor - takes over the blocks and the allocator, other is left empty with no storage
+        segmented_array(segmented_array &&other) noexcept;
+
+        // Copy assignment operator (copy-and-swap idiom)
+        // The allocator is replaced only if it propagates on copy assignment
+        segmented_array &operator=(const segmented_array &other);
+
+        // Move assignment operator - takes over the blocks if the allocator propagates on move assignment
+        // or the allocators compare equal, otherwise the elements are moved one by one
+        segmented_array &operator=(segmented_array &&other) noexcept(alloc_traits::propagate_on_container_move_assignment::value ||
+                                                                     alloc_traits::is_always_equal::value);
+
+        // Destructor
+        ~segmented_array();
+
+        ///
+        // Basic Operations
+
+        // Add one element to the back - no existing element moves
+        void push_back(const T &el);
+        void push_back(T &&el);
+
+        // Constructs an element in place at the back from args
+        template <class... Args>
+        T &emplace_back(Args &&...args);
+
+        ///
+        // Access operations
+        const T &operator[](size_type index) const;
+        T &operator[](size_type index);
+        const T &at(size_type index) const;
+        T &at(size_type index);
+        const T &front() const;
+        T &front();
+        const T &back() const;
+        T &back();
+
+        ///
+        // Remove operations
+        void pop_back();
+
+        // Destroys all elements, the blocks are kept for reuse
+        void clear();
+
+        ///
+        // Capacity operations
+
+        // Allocates blocks until new_capacity elements fit
+        void reserve(size_type new_capacity);
+
+        // Releases the blocks behind the last element
+        void shrink_to_fit();
+
+        size_type size() const { return m_size; }
+        size_type capacity() const { return block_start(m_blocks); }
+        size_type max_size() const;
+        bool empty() const { return m_size == 0; }
+        allocator_type get_allocator() const { return m_alloc; }
+
+        // Number of allocated blocks
+        size_type block_count() const { return m_blocks; }
+
+        // Comparison operators
+        bool operator==(const segmented_array &other) const;
+
+        ///
+        // Iterator - random access through the directory
+        iterator begin() noexcept { return iterator(this, 0); }
+        iterator end() noexcept { return iterator(this, m_size); }
+        const_iterator begin() const noexcept { return const_iterator(this, 0); }
+        const_iterator end() const noexcept { return const_iterator(this, m_size); }
+        const_iterator cbegin() const noexcept { return begin(); }
+        const_iterator cend() const noexcept { return end(); }
+
+    private:
+        Allocator m_alloc;
+        T *m_directory[layout::max_blocks] = {}; // Fixed - growing never moves the directory either
+        size_type m_size = 0;
+        size_type m_blocks = 0; // Allocated blocks - always the first m_blocks directory entries
+
+        ///
+        // Helpers
+    private:
+        static size_type block_size(size_type block) { return layout::block_size(block); }
+        static size_type block_start(size_type block) { return layout::block_start(block); }
+
+        // O(1) - Address of the element at index
+        T *locate(size_type index) const { return m_directory[layout::block_of(index)] + layout::offset_of(index); }
+
+        void add_block();
+        void destroy_elements() noexcept;
+        void release() noexcept;
+        void steal(segmented_array &src) noexcept;
+
+        // The allocators are exchanged only if they propagate on swap,
+        // otherwise they must compare equal.
+        friend void swap(segmented_array &first, segmented_array &second) noexcept
+        {
+            using std::swap;
+            if constexpr (alloc_traits::propagate_on_container_swap::value)
+            {
+                swap(first.m_alloc, second.m_alloc);
+            }
+            else
+            {
+                assert(first.m_alloc == second.m_alloc);
+            }
+
+            swap(first.m_directory, second.m_directory);
+            swap(first.m_size, second.m_size);
+            swap(first.m_blocks, second.m_blocks);
+        }
+    };
+
+    // O(1) - Constant time
+    template <class T, std::size_t FirstBlock, class Allocator>
+    inline segmented_array<T, FirstBlock, Allocator>::segmented_array(const Allocator &alloc)
+        : m_alloc(alloc)
+    {
+    }
+
+    // O(n) - Linear time
+    template <class T, std::size_t FirstBlock, class Allocator>
+    inline segmented_array<T, FirstBlock, Allocator>::segmented_array(const std::initializer_list<T> &i_list, const Allocator &alloc)
+        : m_alloc(alloc)
+    {
+        try
+        {
+            reserve(i_list.size());
+            for (const T &el : i_list)
+                push_back(el);
+        }
+        catch (...)
+        {
+            release();
+            throw;
+        }
+    }
+
+    // O(n) - Linear time
+    template <class T, std::size_t FirstBlock, class Allocator>
+    inline segmented_array<T, FirstBlock, Allocator>::segmented_array(const segmented_array &other)
+        : segmented_array(other, alloc_traits::select_on_container_copy_construction(other.m_alloc))
+    {
+    }
+
+    // O(n) - Linear time
+    template <class T, std::size_t FirstBlock, class Allocator>
+    inline segmented_array<T, FirstBlock, Allocator>::segmented_array(const segmented_array &other, const Allocator &alloc)
+        : m_alloc(alloc)
+    {
+        try
+        {
+            reserve(other.m_size);
+            for (const T &el : other)
+                push_back(el);
+        }
+        catch (...)
+        {
+            release();
+            throw;
+        }
+    }
+
+    // O(1) - Constant time
+    template <class T, std::size_t FirstBlock, class Allocator>
+    inline segmented_array<T, FirstBlock, Allocator>::segmented_array(segmented_array &&other) noexcept
+        : m_alloc(std::move(other.m_alloc))
+    {
+        steal(other);
+    }
+
+    // O(n) - Linear time
+    // The copy is made with the allocator *this should end up with, so the
+    // following swap never has to exchange unequal allocators.
+    template <class T, std::size_t FirstBlock, class Allocator>
+    inline segmented_array<T, FirstBlock, Allocator> &segmented_array<T, FirstBlock, Allocator>::operator=(const segmented_array &other)
+    {
+        if (this == &other)
+            return *this;
+
+        if constexpr (alloc_traits::propagate_on_container_copy_assignment::value)
+        {
+            segmented_array copy(other, other.m_alloc);
+            this->release(); // Releases the blocks with the allocator that owns them
+            m_alloc = other.m_alloc;
+            swap(*this, copy);
+        }
+        else
+        {
+            segmented_array copy(other, m_alloc);
+            swap(*this, copy);
+        }
+
+        return *this;
+    }
+
+    // O(1) - Constant time, O(n) if the allocators differ and do not propagate
+    template <class T, std::size_t FirstBlock, class Allocator>
+    inline segmented_array<T, FirstBlock, Allocator> &segmented_array<T, FirstBlock, Allocator>::operator=(segmented_array &&other) noexcept(
+        alloc_traits::propagate_on_container_move_assignment::value || alloc_traits::is_always_equal::value)
+    {
+        if (this == &other)
+            return *this;
+
+        if constexpr (alloc_traits::propagate_on_container_move_assignment::value)
+        {
+            release(); // Releases the blocks with the allocator that owns them
+            m_alloc = std::move(other.m_alloc);
+            steal(other);
+        }
+        else
+        {
+            if (alloc_traits::is_always_equal::value || m_alloc == other.m_alloc)
+            {
+                release();
+                steal(other);
+            }
+            else
+            {
+                // The blocks of other can not be freed by m_alloc - move the elements into blocks of our own
+                segmented_array moved(m_alloc);
+                moved.reserve(other.m_size);
+                for (T &el : other)
+                    moved.emplace_back(std::move_if_noexcept(el));
+
+                swap(*this, moved);
+                other.clear();
+            }
+        }
+
+        return *this;
+    }
+
+    // O(n) - Linear time
+    template <class T, std::size_t FirstBlock, class Allocator>
+    inline segmented_array<T, FirstBlock, Allocator>::~segmented_array()
+    {
+        release();
+    }
+
+    // O(1) - Constant time
+    template <class T, std::size_t FirstBlock, class Allocator>
+    inline void segmented_array<T, FirstBlock, Allocator>::push_back(const T &el)
+    {
+        emplace_back(el);
+    }
+
+    // O(1) - Constant time
+    template <class T, std::size_t FirstBlock, class Allocator>
+    inline void segmented_array<T, FirstBlock, Allocator>::push_back(T &&el)
+    {
+        emplace_back(std::move(el));
+    }
+
+    // O(1) - Constant time (a new block is allocated, nothing is copied)
+    template <class T, std::size_t FirstBlock, class Allocator>
+    template <class... Args>
+    inline T &segmented_array<T, FirstBlock, Allocator>::emplace_back(Args &&...args)
+    {
+        if (m_size == capacity())
+            add_block(); // Existing elements stay where they are, so args may refer to one of them
+
+        T *slot = locate(m_size);
+        alloc_traits::construct(m_alloc, slot, std::forward<Args>(args)...);
+        m_size++;
+
+        return *slot;
+    }
+
+    // O(1) - Constant time
+    template <class T, std::size_t FirstBlock, class Allocator>
+    inline const T &segmented_array<T, FirstBlock, Allocator>::operator[](size_type index) const
+    {
+        detail::check_subscript(index, m_size); // Policy selected by DS_BOUNDS_CHECK
+
+        return *locate(index);
+    }
+
+    // O(1) - Constant time
+    template <class T, std::size_t FirstBlock, class Allocator>
+    inline T &segmented_array<T, FirstBlock, Allocator>::operator[](size_type index)
+    {
+        detail::check_subscript(index, m_size);
+
+        return *locate(index);
+    }
+
+    // O(1) - Constant time
+    template <class T, std::size_t FirstBlock, class Allocator>
+    inline const T &segmented_array<T, FirstBlock, Allocator>::at(size_type index) const
+    {
+        if (index >= m_size)
+            throw std::out_of_range("Invalid index!");
+
+        return *locate(index);
+    }
+
+    // O(1) - Constant time
+    template <class T, std::size_t FirstBlock, class Allocator>
+    inline T &segmented_array<T, FirstBlock, Allocator>::at(size_type index)
+    {
+        if (index >= m_size)
+            throw std::out_of_range("Invalid index!");
+
+        return *locate(index);
+    }
+
+    // O(1) - Constant time
+    template <class T, std::size_t FirstBlock, class Allocator>
+    inline const T &segmented_array<T, FirstBlock, Allocator>::front() const
+    {
+        if (m_size == 0)
+            throw std::logic_error("Empty container!");
+
+        return *m_directory[0];
+    }
+
+    // O(1) - Constant time
+    template <class T, std::size_t FirstBlock, class Allocator>
+    inline T &segmented_array<T, FirstBlock, Allocator>::front()
+    {
+        if (m_size == 0)
+            throw std::logic_error("Empty container!");
+
+        return *m_directory[0];
+    }
+
+    // O(1) - Constant time
+    template <class T, std::size_t FirstBlock, class Allocator>
+    inline const T &segmented_array<T, FirstBlock, Allocator>::back() const
+    {
+        if (m_size == 0)
+            throw std::logic_error("Empty container!");
+
+        return *locate(m_size - 1);
+    }
+
+    // O(1) - Constant time
+    template <class T, std::size_t FirstBlock, class Allocator>
+    inline T &segmented_array<T, FirstBlock, Allocator>::back()
+    {
+        if (m_size == 0)
+            throw std::logic_error("Empty container!");
+
+        return *locate(m_size - 1);
+    }
+
+    // O(1) - Constant time
+    template <class T, std::size_t FirstBlock, class Allocator>
+    inline void segmented_array<T, FirstBlock, Allocator>::pop_back()
+    {
+        if (m_size == 0)
+            throw std::logic_error("Empty container!");
+
+        alloc_traits::destroy(m_alloc, locate(--m_size));
+    }
+
+    // O(n) - Linear time
+    template <class T, std::size_t FirstBlock, class Allocator>
+    inline void segmented_array<T, FirstBlock, Allocator>::clear()
+    {
+        destroy_elements();
+    }
+
+    // O(log n) - Logarithmic time (one allocation per missing block)
+    template <class T, std::size_t FirstBlock, class Allocator>
+    inline void segmented_array<T, FirstBlock, Allocator>::reserve(size_type new_capacity)
+    {
+        if (new_capacity > max_size())
+            throw std::length_error("Requested capacity exceeds max_size()!");
+
+        while (capacity() < new_capacity)
+            add_block();
+    }
+
+    // O(log n) - Logarithmic time
+    template <class T, std::size_t FirstBlock, class Allocator>
+    inline void segmented_array<T, FirstBlock, Allocator>::shrink_to_fit()
+    {
+        while (m_blocks > 0 && block_start(m_blocks - 1) >= m_size)
+        {
+            m_blocks--;
+            alloc_traits::deallocate(m_alloc, m_directory[m_blocks], block_size(m_blocks));
+            m_directory[m_blocks] = nullptr;
+        }
+    }
+
+    // O(1) - Constant time
+    template <class T, std::size_t FirstBlock, class Allocator>
+    inline typename segmented_array<T, FirstBlock, Allocator>::size_type segmented_array<T, FirstBlock, Allocator>::max_size() const
+    {
+        // Iterator differences must fit in std::ptrdiff_t
+        const size_type max_elements = std::numeric_limits<std::ptrdiff_t>::max() / sizeof(T);
+        const size_type alloc_max = alloc_traits::max_size(m_alloc);
+
+        return alloc_max < max_elements ? alloc_max : max_elements;
+    }
+
+    // O(n) - Linear time
+    template <class T, std::size_t FirstBlock, class Allocator>
+    inline bool segmented_array<T, FirstBlock, Allocator>::operator==(const segmented_array &other) const
+    {
+        if (m_size != other.m_size)
+            return false;
+
+        // Both arrays have the same block layout - compare block by block
+        for (size_type block = 0; block_start(block) < m_size; block++)
+        {
+            const size_type count = std::min(block_size(block), m_size - block_start(block));
+            if (!detail::equal(m_directory[block], other.m_directory[block], count))
+                return false;
+        }
+
+        return true;
+    }
+
+    ///
+    // Helpers
+
+    // Allocates the next block
+    template <class T, std::size_t FirstBlock, class Allocator>
+    inline void segmented_array<T, FirstBlock, Allocator>::add_block()
+    {
+        if (block_start(m_blocks + 1) > max_size())
+            throw std::length_error("Maximum capacity reached!");
+
+        m_directory[m_blocks] = alloc_traits::allocate(m_alloc, block_size(m_blocks));
+        m_blocks++;
+    }
+
+    // Destroys the elements block by block
+    template <class T, std::size_t FirstBlock, class Allocator>
+    inline void segmented_array<T, FirstBlock, Allocator>::destroy_elements() noexcept
+    {
+        for (size_type block = 0; block_start(block) < m_size; block++)
+        {
+            const size_type count = std::min(block_size(block), m_size - block_start(block));
+            detail::destroy_range(m_alloc, m_directory[block], m_directory[block] + count);
+        }
+
+        m_size = 0;
+    }
+
+    // Destroys the elements and deallocates every block
+    template <class T, std::size_t FirstBlock, class Allocator>
+    inline void segmented_array<T, FirstBlock, Allocator>::release() noexcept
+    {
+        destroy_elements();
+        shrink_to_fit();
+    }
+
+    // Takes over the blocks of src, src is left empty with no storage
+    template <class T, std::size_t FirstBlock, class Allocator>
+    inline void segmented_array<T, FirstBlock, Allocator>::steal(segmented_array &src) noexcept
+    {
+        for (size_type block = 0; block < src.m_blocks; block++)
+        {
+            m_directory[block] = src.m_directory[block];
+            src.m_directory[block] = nullptr;
+        }
+
+        m_size = src.m_size;
+        m_blocks = src.m_blocks;
+
+        src.m_size = 0;
+        src.m_blocks = 0;
+    }
+
+} // namespace ds
+
+#endif // SEGMENTED_ARRAY_GUARD
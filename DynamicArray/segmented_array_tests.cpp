@@ -0,0 +1,188 @@
+#define CATCH_CONFIG_MAIN
+#include "../Catch2/catch.hpp"
+#include "segmented_array.hpp"
+
+#include <algorithm>
+#include <memory_resource>
+#include <numeric>
+#include <string>
+#include <vector>
+
+using namespace ds;
+
+TEST_CASE("CONSTRUCTORS", "[CONSTRUCTOR]")
+{
+    segmented_array<int> def;
+
+    REQUIRE(def.size() == 0);
+    REQUIRE(def.empty());
+    REQUIRE(def.capacity() == 0);
+    REQUIRE(def.block_count() == 0);
+    REQUIRE_THROWS(def.at(0));
+    REQUIRE_THROWS(def.front());
+
+    segmented_array<std::string, 4> foo = {"a", "b", "c", "d", "e"};
+    REQUIRE(foo.size() == 5);
+    REQUIRE(foo.capacity() == 12); // Blocks of 4 and 8
+    REQUIRE(foo.block_count() == 2);
+    REQUIRE(foo[4] == "e");
+
+    segmented_array<std::string, 4> bar(foo);
+    REQUIRE(bar == foo);
+    bar[0] = "z";
+    REQUIRE(foo[0] == "a");
+
+    bar = foo;
+    REQUIRE(bar == foo);
+
+    SECTION("COPY ASSIGNMENT KEEPS A NON-PROPAGATING ALLOCATOR")
+    {
+        using pmr_array = segmented_array<int, 4, std::pmr::polymorphic_allocator<int>>;
+        std::pmr::monotonic_buffer_resource first, second;
+        pmr_array source({1, 2, 3, 4, 5}, &first);
+        pmr_array target(&second);
+
+        target = source;
+        REQUIRE(target == source);
+        REQUIRE(target.get_allocator().resource() == &second);
+
+        // Copy construction selects the default resource
+        pmr_array copy(source);
+        REQUIRE(copy.get_allocator().resource() == std::pmr::get_default_resource());
+    }
+
+    SECTION("MOVE")
+    {
+        const std::string *first = &bar[0];
+        segmented_array<std::string, 4> moved(std::move(bar));
+        REQUIRE(&moved[0] == first); // The blocks are taken over
+        REQUIRE(moved == foo);
+        REQUIRE(bar.empty());
+        REQUIRE(bar.block_count() == 0);
+
+        bar.push_back("q"); // The moved-from container is usable again
+        REQUIRE(bar.front() == "q");
+
+        bar = std::move(moved);
+        REQUIRE(&bar[0] == first);
+        REQUIRE(bar == foo);
+        REQUIRE(moved.empty());
+    }
+
+    SECTION("MOVE ASSIGNMENT KEEPS A NON-PROPAGATING ALLOCATOR")
+    {
+        using pmr_array = segmented_array<int, 4, std::pmr::polymorphic_allocator<int>>;
+        std::pmr::monotonic_buffer_resource first, second;
+        pmr_array source({1, 2, 3, 4, 5}, &first);
+        pmr_array target(&second);
+
+        target = std::move(source); // Unequal resources - the elements are moved one by one
+        REQUIRE(target == pmr_array({1, 2, 3, 4, 5}));
+        REQUIRE(target.get_allocator().resource() == &second);
+        REQUIRE(source.empty());
+    }
+}
+
+TEST_CASE("DEFAULT OPERATIONS", "[OPERATIONS]")
+{
+    segmented_array<int, 2> foo;
+
+    SECTION("INDEXING ACROSS BLOCKS")
+    {
+        for (int i = 0; i < 1000; i++)
+            foo.push_back(i);
+
+        REQUIRE(foo.size() == 1000);
+        REQUIRE(foo.capacity() >= 1000);
+        REQUIRE(foo.front() == 0);
+        REQUIRE(foo.back() == 999);
+
+        bool in_order = true;
+        for (int i = 0; i < 1000; i++)
+            in_order = in_order && foo[i] == i && foo.at(i) == i;
+        REQUIRE(in_order);
+        REQUIRE_THROWS(foo.at(1000));
+    }
+
+    SECTION("ADDRESSES ARE STABLE WHILE GROWING")
+    {
+        foo.push_back(7);
+        int *first = &foo.front();
+
+        std::vector<int *> addresses;
+        for (int i = 0; i < 5000; i++)
+            addresses.push_back(&foo.emplace_back(i));
+
+        REQUIRE(first == &foo[0]);
+        REQUIRE(*first == 7);
+
+        bool stable = true;
+        for (int i = 0; i < 5000; i++)
+            stable = stable && addresses[i] == &foo[i + 1];
+        REQUIRE(stable);
+    }
+
+    SECTION("PUSH BACK OF ITS OWN ELEMENT")
+    {
+        segmented_array<std::string, 1> bar;
+        bar.push_back("first");
+        bar.push_back(bar.front()); // Grows - the argument is not moved
+
+        REQUIRE(bar[1] == "first");
+    }
+
+    SECTION("POP BACK AND CLEAR KEEP THE BLOCKS")
+    {
+        for (int i = 0; i < 10; i++)
+            foo.push_back(i);
+
+        foo.pop_back();
+        REQUIRE(foo.size() == 9);
+        REQUIRE(foo.back() == 8);
+
+        const std::size_t capacity = foo.capacity();
+        foo.clear();
+        REQUIRE(foo.empty());
+        REQUIRE(foo.capacity() == capacity);
+        REQUIRE_THROWS(foo.pop_back());
+    }
+
+    SECTION("RESERVE AND SHRINK TO FIT")
+    {
+        foo.reserve(100);
+        REQUIRE(foo.capacity() >= 100);
+
+        for (int i = 0; i < 10; i++)
+            foo.push_back(i);
+        int *el = &foo[9];
+
+        foo.shrink_to_fit();
+        REQUIRE(foo.capacity() == 14); // Blocks of 2, 4 and 8
+        REQUIRE(&foo[9] == el);
+
+        foo.clear();
+        foo.shrink_to_fit();
+        REQUIRE(foo.capacity() == 0);
+        REQUIRE_THROWS_AS(foo.reserve(foo.max_size() + 1), std::length_error);
+    }
+}
+
+TEST_CASE("ITERATORS", "[ITERATOR]")
+{
+    segmented_array<int, 4> foo;
+    for (int i = 0; i < 300; i++)
+        foo.push_back((i * 37) % 300);
+
+    REQUIRE(foo.end() - foo.begin() == 300);
+    REQUIRE(std::accumulate(foo.cbegin(), foo.cend(), 0) == 299 * 300 / 2);
+
+    std::sort(foo.begin(), foo.end());
+    REQUIRE(std::is_sorted(foo.begin(), foo.end()));
+    REQUIRE(foo[150] == 150);
+
+    segmented_array<int, 4>::const_iterator it = foo.begin() + 10;
+    REQUIRE(*it == 10);
+    REQUIRE(it[5] == 15);
+    REQUIRE(it == foo.cbegin() + 10);
+    REQUIRE(std::lower_bound(foo.begin(), foo.end(), 42) - foo.begin() == 42);
+}
@@ -0,0 +1,689 @@
+#ifndef SERIALIZATION_GUARD
+#define SERIALIZATION_GUARD
+
+/*
+ *  Versioned binary save / load of dynamic_array.
+ *
+ *  Every file starts with a 48 byte header, stored little-endian:
+ *      magic "DSARRBIN", format version, byte order of the writer,
+ *      payload format, element size, element count, payload size and
+ *      the checksum of the payload.
+ *
+ *  Trivially copyable elements are the payload as they are in memory
+ *  ("raw" format): saving is one write of header and buffer (writev() for
+ *  files), loading reads the payload straight into the array storage.
+ *  Arithmetic elements written on a machine with the other byte order are
+ *  swapped after loading.
+ *
+ *  Other element types are streamed one by one through ds::serializer<T>
+ *  ("streamed" format). std::basic_string is supported out of the box,
+ *  further types can specialize serializer.
+*/
+
+#include "dynamic_array.hpp"
+
+#include <cerrno>       // errno
+#include <cstdint>      // Header fields
+#include <cstring>      // std::memcpy
+#include <fstream>      // Streamed files
+#include <istream>      // Loading
+#include <ostream>      // Saving
+#include <stdexcept>    // Format errors
+#include <streambuf>    // Checksumming streams
+#include <string>       // File path, string serializer
+#include <system_error> // OS failures
+
+#include <fcntl.h>    // open
+#include <sys/stat.h> // fstat
+#include <sys/uio.h>  // writev
+#include <unistd.h>   // read, close, lseek
+
+namespace ds
+{
+    namespace detail
+    {
+        // Length of an input which can not be told in advance
+        inline constexpr std::uint64_t unknown_length = std::numeric_limits<std::uint64_t>::max();
+
+        // Bytes left to read from is - the rest of the payload while loading, unknown_length if it can not be told
+        inline std::uint64_t bytes_left(std::istream &is);
+    } // namespace detail
+
+    // Element codec of the streamed format - specialize for own types.
+    // write() puts value on the stream, read() constructs the next element from it.
+    template <class T, class = void>
+    struct serializer;
+
+    // Plain bytes
+    template <class T>
+    struct serializer<T, std::enable_if_t<std::is_trivially_copyable_v<T>>>
+    {
+        static void write(std::ostream &os, const T &value)
+        {
+            os.write(reinterpret_cast<const char *>(&value), sizeof(T));
+        }
+
+        static T read(std::istream &is)
+        {
+            T value;
+            is.read(reinterpret_cast<char *>(&value), sizeof(T));
+            return value;
+        }
+    };
+
+    // Length followed by the characters
+    template <class CharT, class Traits, class Alloc>
+    struct serializer<std::basic_string<CharT, Traits, Alloc>>
+    {
+        using string_type = std::basic_string<CharT, Traits, Alloc>;
+
+        static void write(std::ostream &os, const string_type &value)
+        {
+            serializer<std::uint64_t>::write(os, value.size());
+            os.write(reinterpret_cast<const char *>(value.data()), value.size() * sizeof(CharT));
+        }
+
+        static string_type read(std::istream &is)
+        {
+            // Checked against the input before anything is allocated
+            const std::uint64_t length = serializer<std::uint64_t>::read(is);
+            if (!is || length > string_type().max_size() || length > detail::bytes_left(is) / sizeof(CharT))
+                throw std::runtime_error("serialization: Corrupted string length!");
+
+            string_type value;
+            value.resize(static_cast<std::size_t>(length));
+            is.read(reinterpret_cast<char *>(value.data()), value.size() * sizeof(CharT));
+            return value;
+        }
+    };
+
+    namespace detail
+    {
+        inline bool little_endian()
+        {
+            const std::uint16_t one = 1;
+            unsigned char first;
+            std::memcpy(&first, &one, 1);
+            return first == 1;
+        }
+
+        // 64 bit checksum of a byte sequence which may be fed in pieces.
+        // The bytes are consumed as little-endian words, so the result does not depend on the machine.
+        class checksum
+        {
+        public:
+            void update(const void *bytes, std::size_t count)
+            {
+                const unsigned char *ptr = static_cast<const unsigned char *>(bytes);
+
+                if (count == 0)
+                    return;
+
+                // Complete a word left over from the last call
+                while (m_tail_size && count)
+                {
+                    m_tail[m_tail_size++] = *ptr++;
+                    count--;
+                    if (m_tail_size == sizeof(m_tail))
+                    {
+                        mix(load(m_tail));
+                        m_tail_size = 0;
+                    }
+                }
+
+                for (; count >= 8; ptr += 8, count -= 8)
+                    mix(load(ptr));
+
+                std::memcpy(m_tail + m_tail_size, ptr, count);
+                m_tail_size += count;
+            }
+
+            std::uint64_t value() const
+            {
+                checksum last(*this);
+                std::memset(last.m_tail + last.m_tail_size, 0, sizeof(m_tail) - last.m_tail_size);
+                last.mix(load(last.m_tail) ^ m_tail_size);
+
+                return last.m_hash;
+            }
+
+        private:
+            static std::uint64_t load(const unsigned char *ptr)
+            {
+                std::uint64_t word;
+                std::memcpy(&word, ptr, 8);
+                return little_endian() ? word : __builtin_bswap64(word);
+            }
+
+            void mix(std::uint64_t word)
+            {
+                m_hash = (m_hash ^ word) * 0x9E3779B97F4A7C15ull;
+                m_hash ^= m_hash >> 29;
+            }
+
+            std::uint64_t m_hash = 0xCBF29CE484222325ull;
+            unsigned char m_tail[8];
+            std::size_t m_tail_size = 0;
+        };
+
+        // Output buffer which only counts and checksums what is written to it
+        class checksum_streambuf : public std::streambuf
+        {
+        public:
+            std::uint64_t bytes = 0;
+            detail::checksum sum;
+
+        protected:
+            std::streamsize xsputn(const char *s, std::streamsize count) override
+            {
+                sum.update(s, static_cast<std::size_t>(count));
+                bytes += static_cast<std::uint64_t>(count);
+                return count;
+            }
+
+            int_type overflow(int_type ch) override
+            {
+                if (!traits_type::eq_int_type(ch, traits_type::eof()))
+                {
+                    const char c = traits_type::to_char_type(ch);
+                    xsputn(&c, 1);
+                }
+
+                return traits_type::not_eof(ch);
+            }
+        };
+
+        // Input buffer over exactly limit bytes of source, checksumming them on the way
+        class bounded_streambuf : public std::streambuf
+        {
+        public:
+            bounded_streambuf(std::streambuf *source, std::uint64_t limit) : m_source(source), m_left(limit) {}
+
+            std::uint64_t left() const { return m_left + (egptr() - gptr()); }
+            detail::checksum sum;
+
+        protected:
+            int_type underflow() override
+            {
+                if (gptr() < egptr())
+                    return traits_type::to_int_type(*gptr());
+                if (m_left == 0)
+                    return traits_type::eof();
+
+                const std::streamsize wanted = static_cast<std::streamsize>(m_left < sizeof(m_buffer) ? m_left : sizeof(m_buffer));
+                const std::streamsize got = m_source->sgetn(m_buffer, wanted);
+                if (got <= 0)
+                    return traits_type::eof();
+
+                m_left -= static_cast<std::uint64_t>(got);
+                sum.update(m_buffer, static_cast<std::size_t>(got));
+                setg(m_buffer, m_buffer, m_buffer + got);
+
+                return traits_type::to_int_type(*gptr());
+            }
+
+        private:
+            std::streambuf *m_source;
+            std::uint64_t m_left;
+            char m_buffer[4096];
+        };
+
+        // Bytes between the read position of is and its end, unknown_length if is can not seek
+        inline std::uint64_t remaining_bytes(std::istream &is)
+        {
+            const std::istream::pos_type here = is.tellg();
+            if (here == std::istream::pos_type(-1))
+                return unknown_length;
+
+            is.seekg(0, std::ios::end);
+            const std::istream::pos_type end = is.tellg();
+            if (end == std::istream::pos_type(-1))
+            {
+                is.clear();
+                is.seekg(here);
+                return unknown_length;
+            }
+
+            is.seekg(here);
+            return static_cast<std::uint64_t>(end - here);
+        }
+
+        inline std::uint64_t bytes_left(std::istream &is)
+        {
+            if (const bounded_streambuf *payload = dynamic_cast<const bounded_streambuf *>(is.rdbuf()))
+                return payload->left();
+
+            return remaining_bytes(is);
+        }
+
+        ///
+        // Header
+
+        enum class payload_format : std::uint8_t
+        {
+            raw = 0,
+            streamed = 1
+        };
+
+        struct array_header
+        {
+            static constexpr char magic[8] = {'D', 'S', 'A', 'R', 'R', 'B', 'I', 'N'};
+            static constexpr std::uint16_t current_version = 1;
+            static constexpr std::size_t bytes = 48;
+
+            std::uint16_t version = current_version;
+            bool little_endian = detail::little_endian();
+            payload_format format = payload_format::raw;
+            std::uint32_t element_size = 0;
+            std::uint64_t count = 0;
+            std::uint64_t payload_bytes = 0;
+            std::uint64_t checksum = 0;
+
+            static void put(unsigned char *dest, std::uint64_t value, std::size_t size)
+            {
+                for (std::size_t i = 0; i < size; i++)
+                    dest[i] = static_cast<unsigned char>(value >> (8 * i));
+            }
+
+            static std::uint64_t get(const unsigned char *src, std::size_t size)
+            {
+                std::uint64_t value = 0;
+                for (std::size_t i = 0; i < size; i++)
+                    value |= std::uint64_t(src[i]) << (8 * i);
+                return value;
+            }
+
+            void encode(unsigned char (&dest)[bytes]) const
+            {
+                std::memset(dest, 0, bytes);
+                std::memcpy(dest, magic, sizeof(magic));
+                put(dest + 8, version, 2);
+                dest[10] = little_endian ? 1 : 2;
+                dest[11] = static_cast<unsigned char>(format);
+                put(dest + 12, element_size, 4);
+                put(dest + 16, count, 8);
+                put(dest + 24, payload_bytes, 8);
+                put(dest + 32, checksum, 8);
+            }
+
+            static array_header decode(const unsigned char (&src)[bytes])
+            {
+                if (std::memcmp(src, magic, sizeof(magic)) != 0)
+                    throw std::runtime_error("serialization: Not a dynamic_array file!");
+
+                array_header header;
+                header.version = static_cast<std::uint16_t>(get(src + 8, 2));
+                if (header.version != current_version)
+                    throw std::runtime_error("serialization: Unsupported format version!");
+                if (src[10] != 1 && src[10] != 2)
+                    throw std::runtime_error("serialization: Invalid byte order!");
+
+                header.little_endian = src[10] == 1;
+                header.format = static_cast<payload_format>(src[11]);
+                header.element_size = static_cast<std::uint32_t>(get(src + 12, 4));
+                header.count = get(src + 16, 8);
+                header.payload_bytes = get(src + 24, 8);
+                header.checksum = get(src + 32, 8);
+
+                return header;
+            }
+        };
+
+        template <class T>
+        inline constexpr payload_format format_of = std::is_trivially_copyable_v<T> ? payload_format::raw : payload_format::streamed;
+
+        // Header describing arr; the streamed payload is serialized once to measure and checksum it
+        template <class T, class Allocator, class GrowthPolicy>
+        array_header make_header(const dynamic_array<T, Allocator, GrowthPolicy> &arr)
+        {
+            array_header header;
+            header.format = format_of<T>;
+            header.element_size = sizeof(T);
+            header.count = arr.size();
+
+            if constexpr (format_of<T> == payload_format::raw)
+            {
+                header.payload_bytes = arr.size() * sizeof(T);
+                detail::checksum sum;
+                sum.update(arr.data(), header.payload_bytes);
+                header.checksum = sum.value();
+            }
+            else
+            {
+                checksum_streambuf counter;
+                std::ostream os(&counter);
+                for (const T &el : arr)
+                    serializer<T>::write(os, el);
+
+                header.payload_bytes = counter.bytes;
+                header.checksum = counter.sum.value();
+            }
+
+            return header;
+        }
+
+        // Checks that header describes an array of T
+        template <class T>
+        void validate(const array_header &header)
+        {
+            if (header.format != format_of<T>)
+                throw std::runtime_error("serialization: The payload format does not match the element type!");
+            if (header.element_size != sizeof(T))
+                throw std::runtime_error("serialization: The element size does not match!");
+
+            if constexpr (format_of<T> == payload_format::raw)
+            {
+                if (header.count > std::numeric_limits<std::uint64_t>::max() / sizeof(T) || header.payload_bytes != header.count * sizeof(T))
+                    throw std::runtime_error("serialization: Corrupted header!");
+
+                if (header.little_endian != little_endian() && !std::is_arithmetic_v<T>)
+                    throw std::runtime_error("serialization: Byte order mismatch!");
+            }
+            else if (header.little_endian != little_endian())
+            {
+                throw std::runtime_error("serialization: Byte order mismatch!");
+            }
+        }
+
+        // Reverses the bytes of every element
+        template <class T>
+        void swap_bytes(T *data, std::size_t count)
+        {
+            for (std::size_t i = 0; i < count; i++)
+            {
+                unsigned char *bytes = reinterpret_cast<unsigned char *>(data + i);
+                for (std::size_t low = 0, high = sizeof(T) - 1; low < high; low++, high--)
+                    std::swap(bytes[low], bytes[high]);
+            }
+        }
+
+        // Direct access to the storage of dynamic_array for loading
+        struct array_io
+        {
+            // Returns storage for capacity elements, the elements of arr are kept
+            template <class T, class Allocator, class GrowthPolicy>
+            static T *storage(dynamic_array<T, Allocator, GrowthPolicy> &arr, std::size_t capacity)
+            {
+                arr.reserve(capacity);
+                return arr.m_data;
+            }
+
+            // Makes the count elements written to the storage part of arr
+            template <class T, class Allocator, class GrowthPolicy>
+            static void commit(dynamic_array<T, Allocator, GrowthPolicy> &arr, std::size_t count)
+            {
+                static_assert(std::is_trivially_copyable_v<T>, "Only bytes of trivially copyable types can become elements");
+                arr.m_size = count;
+            }
+        };
+
+        // Verifies and finishes a raw payload read into the storage of arr
+        template <class T, class Allocator, class GrowthPolicy>
+        void finish_raw(dynamic_array<T, Allocator, GrowthPolicy> &arr, const array_header &header)
+        {
+            detail::checksum sum;
+            sum.update(arr.data(), header.payload_bytes);
+            if (sum.value() != header.checksum)
+                throw std::runtime_error("serialization: Checksum mismatch!");
+
+            array_io::commit(arr, header.count);
+            if (header.little_endian != little_endian())
+                swap_bytes(arr.data(), arr.size());
+        }
+
+        // Storage reserved ahead of a payload of unknown length - it then doubles with the bytes
+        // actually received, so a corrupted count can not commit a huge allocation
+        inline constexpr std::size_t unverified_chunk_bytes = std::size_t(1) << 20;
+
+        // Reads the raw payload described by header into arr (left empty on failure).
+        // available is the length of the input (or unknown_length), read(dest, bytes) returns false on its premature end.
+        template <class T, class Allocator, class GrowthPolicy, class Reader>
+        void read_raw(dynamic_array<T, Allocator, GrowthPolicy> &arr, const array_header &header, std::uint64_t available, Reader read)
+        {
+            arr.clear();
+
+            // A count the input can not hold is rejected before anything is allocated
+            if (header.payload_bytes > available)
+                throw std::runtime_error("serialization: Truncated payload!");
+            if (header.count > arr.max_size())
+                throw std::runtime_error("serialization: Corrupted header!");
+
+            const std::size_t count = static_cast<std::size_t>(header.count);
+            std::size_t step = available == unknown_length ? std::max<std::size_t>(unverified_chunk_bytes / sizeof(T), 1) : count;
+            std::size_t done = 0;
+
+            try
+            {
+                while (done < count)
+                {
+                    step = std::min(step, count - done);
+                    T *dest = array_io::storage(arr, done + step);
+                    if (!read(dest + done, step * sizeof(T)))
+                        throw std::runtime_error("serialization: Truncated payload!");
+
+                    done += step;
+                    array_io::commit(arr, done); // Relocated if the storage grows again
+                    step *= 2;
+                }
+
+                finish_raw(arr, header);
+            }
+            catch (...)
+            {
+                arr.clear();
+                throw;
+            }
+        }
+
+        [[noreturn]] inline void throw_io_error(const char *what)
+        {
+            throw std::system_error(errno, std::generic_category(), what);
+        }
+
+        // Closes the descriptor on scope exit
+        struct file_descriptor
+        {
+            int fd;
+            ~file_descriptor()
+            {
+                if (fd >= 0)
+                    ::close(fd);
+            }
+        };
+    } // namespace detail
+
+    ///
+    // Streams
+
+    // Writes arr to os - header and raw payload with two write() calls,
+    // or element by element through serializer<T>
+    template <class T, class Allocator, class GrowthPolicy>
+    void save(const dynamic_array<T, Allocator, GrowthPolicy> &arr, std::ostream &os)
+    {
+        const detail::array_header header = detail::make_header(arr);
+        unsigned char bytes[detail::array_header::bytes];
+        header.encode(bytes);
+
+        os.write(reinterpret_cast<const char *>(bytes), sizeof(bytes));
+
+        if constexpr (detail::format_of<T> == detail::payload_format::raw)
+        {
+            if (arr.size())
+                os.write(reinterpret_cast<const char *>(arr.data()), static_cast<std::streamsize>(header.payload_bytes));
+        }
+        else
+        {
+            for (const T &el : arr)
+                serializer<T>::write(os, el);
+        }
+
+        if (!os)
+            throw std::runtime_error("serialization: Write failed!");
+    }
+
+    // Replaces the elements of arr with the array stored in is.
+    // Throws std::runtime_error on a malformed or corrupted input (arr is left empty then).
+    template <class T, class Allocator, class GrowthPolicy>
+    void load(dynamic_array<T, Allocator, GrowthPolicy> &arr, std::istream &is)
+    {
+        unsigned char bytes[detail::array_header::bytes];
+        if (!is.read(reinterpret_cast<char *>(bytes), sizeof(bytes)))
+            throw std::runtime_error("serialization: Truncated header!");
+
+        const detail::array_header header = detail::array_header::decode(bytes);
+        detail::validate<T>(header);
+
+        if constexpr (detail::format_of<T> == detail::payload_format::raw)
+        {
+            detail::read_raw(arr, header, detail::remaining_bytes(is), [&](void *dest, std::size_t bytes)
+                             { return static_cast<bool>(is.read(static_cast<char *>(dest), static_cast<std::streamsize>(bytes))); });
+        }
+        else
+        {
+            arr.clear();
+
+            detail::bounded_streambuf payload(is.rdbuf(), header.payload_bytes);
+            std::istream in(&payload);
+
+            try
+            {
+                for (std::uint64_t i = 0; i < header.count; i++)
+                {
+                    arr.push_back(serializer<T>::read(in));
+                    if (!in)
+                        throw std::runtime_error("serialization: Truncated payload!");
+                }
+
+                if (payload.left() != 0 || payload.sum.value() != header.checksum)
+                    throw std::runtime_error("serialization: Checksum mismatch!");
+            }
+            catch (...)
+            {
+                arr.clear();
+                throw;
+            }
+        }
+    }
+
+    ///
+    // Files
+
+    // Writes arr to the file at path (created or truncated).
+    // The raw format is written with a single writev() of header and buffer.
+    template <class T, class Allocator, class GrowthPolicy>
+    void save(const dynamic_array<T, Allocator, GrowthPolicy> &arr, const std::string &path)
+    {
+        if constexpr (detail::format_of<T> == detail::payload_format::raw)
+        {
+            const detail::array_header header = detail::make_header(arr);
+            unsigned char bytes[detail::array_header::bytes];
+            header.encode(bytes);
+
+            detail::file_descriptor file{::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644)};
+            if (file.fd < 0)
+                detail::throw_io_error("serialization: Cannot open the file");
+
+            iovec parts[2] = {{bytes, sizeof(bytes)},
+                              {const_cast<T *>(arr.data()), static_cast<std::size_t>(header.payload_bytes)}};
+            int first = 0;
+
+            // Large buffers may be written partially - continue where the kernel stopped
+            while (first < 2)
+            {
+                const ssize_t written = ::writev(file.fd, parts + first, 2 - first);
+                if (written < 0)
+                {
+                    if (errno == EINTR)
+                        continue;
+                    detail::throw_io_error("serialization: Write failed");
+                }
+
+                std::size_t done = static_cast<std::size_t>(written);
+                while (first < 2 && done >= parts[first].iov_len)
+                    done -= parts[first++].iov_len;
+                if (first < 2)
+                {
+                    parts[first].iov_base = static_cast<char *>(parts[first].iov_base) + done;
+                    parts[first].iov_len -= done;
+                }
+            }
+
+            if (::close(file.fd) != 0)
+            {
+                file.fd = -1;
+                detail::throw_io_error("serialization: Write failed");
+            }
+            file.fd = -1;
+        }
+        else
+        {
+            std::ofstream os(path, std::ios::binary | std::ios::trunc);
+            if (!os)
+                throw std::runtime_error("serialization: Cannot open the file!");
+
+            save(arr, os);
+        }
+    }
+
+    // Replaces the elements of arr with the array stored in the file at path.
+    // The raw payload is read with a single read() into the array storage.
+    template <class T, class Allocator, class GrowthPolicy>
+    void load(dynamic_array<T, Allocator, GrowthPolicy> &arr, const std::string &path)
+    {
+        if constexpr (detail::format_of<T> == detail::payload_format::raw)
+        {
+            detail::file_descriptor file{::open(path.c_str(), O_RDONLY | O_CLOEXEC)};
+            if (file.fd < 0)
+                detail::throw_io_error("serialization: Cannot open the file");
+
+            // Reads exactly count bytes, false on a premature end of file
+            auto read_all = [&](void *dest, std::size_t count)
+            {
+                char *ptr = static_cast<char *>(dest);
+                while (count)
+                {
+                    const ssize_t got = ::read(file.fd, ptr, count);
+                    if (got < 0)
+                    {
+                        if (errno == EINTR)
+                            continue;
+                        detail::throw_io_error("serialization: Read failed");
+                    }
+                    if (got == 0)
+                        return false;
+
+                    ptr += got;
+                    count -= static_cast<std::size_t>(got);
+                }
+                return true;
+            };
+
+            unsigned char bytes[detail::array_header::bytes];
+            if (!read_all(bytes, sizeof(bytes)))
+                throw std::runtime_error("serialization: Truncated header!");
+
+            const detail::array_header header = detail::array_header::decode(bytes);
+            detail::validate<T>(header);
+
+            // The rest of a regular file is its payload - devices and pipes can not tell their length
+            struct stat info;
+            const off_t position = ::lseek(file.fd, 0, SEEK_CUR);
+            std::uint64_t available = detail::unknown_length;
+            if (::fstat(file.fd, &info) == 0 && S_ISREG(info.st_mode) && position >= 0)
+                available = info.st_size > position ? static_cast<std::uint64_t>(info.st_size - position) : 0;
+
+            detail::read_raw(arr, header, available, read_all);
+        }
+        else
+        {
+            std::ifstream is(path, std::ios::binary);
+            if (!is)
+                throw std::runtime_error("serialization: Cannot open the file!");
+
+            load(arr, is);
+        }
+    }
+
+} // namespace ds
+
+#endif // SERIALIZATION_GUARD
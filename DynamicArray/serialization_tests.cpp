@@ -0,0 +1,253 @@
+#define CATCH_CONFIG_MAIN
+#include "../Catch2/catch.hpp"
+#include "serialization.hpp"
+
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <sstream>
+#include <string>
+
+using namespace ds;
+
+struct Sample
+{
+    int id;
+    float value;
+    char tag[4];
+};
+
+// Input buffer which can not seek - the length of its content is unknown to the reader
+struct unseekable_buf : std::streambuf
+{
+    explicit unseekable_buf(std::string &bytes) { setg(bytes.data(), bytes.data(), bytes.data() + bytes.size()); }
+};
+
+// Stores value little-endian into 8 bytes of the header at offset
+static void patch(std::string &bytes, std::size_t offset, std::uint64_t value)
+{
+    for (std::size_t i = 0; i < 8; i++)
+        bytes[offset + i] = static_cast<char>(value >> (8 * i));
+}
+
+// Saved form of arr
+template <class T>
+std::string saved(const dynamic_array<T> &arr)
+{
+    std::ostringstream os(std::ios::binary);
+    save(arr, os);
+    return os.str();
+}
+
+TEST_CASE("RAW FORMAT", "[SERIALIZATION]")
+{
+    SECTION("ROUND TRIP THROUGH A STREAM")
+    {
+        dynamic_array<double> foo;
+        for (int i = 0; i < 1000; i++)
+            foo.push_back(i * 0.25);
+
+        const std::string bytes = saved(foo);
+        REQUIRE(bytes.size() == 48 + 1000 * sizeof(double));
+
+        dynamic_array<double> bar = {1.0, 2.0};
+        std::istringstream is(bytes, std::ios::binary);
+        load(bar, is);
+
+        REQUIRE(bar == foo);
+    }
+
+    SECTION("ROUND TRIP THROUGH A FILE")
+    {
+        const std::string path = (std::filesystem::temp_directory_path() / "ds_serialization_raw.bin").string();
+
+        dynamic_array<Sample> foo;
+        for (int i = 0; i < 5000; i++)
+            foo.push_back({i, i * 1.5f, {'a', 'b', 'c', '\0'}});
+
+        save(foo, path);
+        REQUIRE(std::filesystem::file_size(path) == 48 + 5000 * sizeof(Sample));
+
+        dynamic_array<Sample> bar;
+        load(bar, path);
+        std::remove(path.c_str());
+
+        REQUIRE(bar.size() == foo.size());
+        REQUIRE(bar[4999].id == 4999);
+        REQUIRE(bar[10].value == 15.0f);
+        REQUIRE(std::string(bar[0].tag) == "abc");
+    }
+
+    SECTION("EMPTY ARRAY")
+    {
+        dynamic_array<int> foo;
+        dynamic_array<int> bar = {1, 2, 3};
+
+        std::istringstream is(saved(foo), std::ios::binary);
+        load(bar, is);
+
+        REQUIRE(bar.empty());
+    }
+
+    SECTION("FOREIGN BYTE ORDER IS SWAPPED")
+    {
+        dynamic_array<std::uint32_t> foo = {0x01020304, 0xAABBCCDD};
+        std::string bytes = saved(foo);
+
+        // Rewrite as if a machine of the other byte order had saved the array
+        bytes[10] = bytes[10] == 1 ? 2 : 1;
+        for (std::size_t i = 48; i < bytes.size(); i += 4)
+            std::swap(bytes[i], bytes[i + 3]), std::swap(bytes[i + 1], bytes[i + 2]);
+
+        // The checksum covers the stored bytes
+        dynamic_array<std::uint32_t> swapped = {0x04030201, 0xDDCCBBAA};
+        const std::string expect = saved(swapped);
+        bytes.replace(32, 8, expect, 32, 8);
+
+        dynamic_array<std::uint32_t> bar;
+        std::istringstream is(bytes, std::ios::binary);
+        load(bar, is);
+
+        REQUIRE(bar == foo);
+    }
+}
+
+TEST_CASE("STREAMED FORMAT", "[SERIALIZATION]")
+{
+    dynamic_array<std::string> foo = {"alpha", "", std::string(1000, 'x'), "omega"};
+
+    SECTION("ROUND TRIP")
+    {
+        const std::string bytes = saved(foo);
+
+        dynamic_array<std::string> bar = {"old"};
+        std::istringstream is(bytes, std::ios::binary);
+        load(bar, is);
+
+        REQUIRE(bar == foo);
+    }
+
+    SECTION("ROUND TRIP THROUGH A FILE")
+    {
+        const std::string path = (std::filesystem::temp_directory_path() / "ds_serialization_streamed.bin").string();
+
+        save(foo, path);
+        dynamic_array<std::string> bar;
+        load(bar, path);
+        std::remove(path.c_str());
+
+        REQUIRE(bar == foo);
+    }
+
+    SECTION("STOPS AT THE END OF THE PAYLOAD")
+    {
+        std::stringstream ss(std::ios::in | std::ios::out | std::ios::binary);
+        save(foo, ss);
+        ss << "trailing";
+
+        dynamic_array<std::string> bar;
+        load(bar, ss);
+
+        std::string rest;
+        ss >> rest;
+        REQUIRE(bar == foo);
+        REQUIRE(rest == "trailing");
+    }
+}
+
+TEST_CASE("INVALID INPUT", "[SERIALIZATION]")
+{
+    dynamic_array<int> foo = {1, 2, 3, 4};
+    const std::string bytes = saved(foo);
+    dynamic_array<int> bar;
+
+    SECTION("CORRUPTED PAYLOAD")
+    {
+        std::string corrupted = bytes;
+        corrupted[50] ^= 0x10;
+
+        std::istringstream is(corrupted, std::ios::binary);
+        REQUIRE_THROWS_WITH(load(bar, is), Catch::Contains("Checksum"));
+        REQUIRE(bar.empty());
+    }
+
+    SECTION("TRUNCATED INPUT")
+    {
+        std::istringstream header(bytes.substr(0, 20), std::ios::binary);
+        std::istringstream payload(bytes.substr(0, bytes.size() - 1), std::ios::binary);
+
+        REQUIRE_THROWS_AS(load(bar, header), std::runtime_error);
+        REQUIRE_THROWS_AS(load(bar, payload), std::runtime_error);
+    }
+
+    SECTION("CORRUPTED COUNT")
+    {
+        // Consistent with the payload size, so only the input length can reveal it
+        const std::uint64_t count = std::uint64_t(1) << 40;
+        std::string corrupted = bytes;
+        patch(corrupted, 16, count);
+        patch(corrupted, 24, count * sizeof(int));
+
+        std::istringstream seekable(corrupted, std::ios::binary);
+        REQUIRE_THROWS_WITH(load(bar, seekable), Catch::Contains("Truncated"));
+
+        unseekable_buf buffer(corrupted);
+        std::istream unseekable(&buffer);
+        REQUIRE_THROWS_WITH(load(bar, unseekable), Catch::Contains("Truncated"));
+        REQUIRE(bar.capacity() * sizeof(int) <= (std::size_t(1) << 20)); // Grown with the received bytes only
+
+        const std::string path = (std::filesystem::temp_directory_path() / "ds_serialization_count.bin").string();
+        {
+            std::ofstream file(path, std::ios::binary | std::ios::trunc);
+            file << corrupted;
+        }
+        REQUIRE_THROWS_WITH(load(bar, path), Catch::Contains("Truncated"));
+        std::remove(path.c_str());
+
+        // A count above max_size() is a corrupted header, not a failed allocation
+        patch(corrupted, 16, std::numeric_limits<std::uint64_t>::max() / sizeof(int));
+        patch(corrupted, 24, std::numeric_limits<std::uint64_t>::max() / sizeof(int) * sizeof(int));
+        unseekable_buf huge(corrupted);
+        std::istream unbounded(&huge);
+        REQUIRE_THROWS_WITH(load(bar, unbounded), Catch::Contains("Corrupted header"));
+        REQUIRE(bar.empty());
+
+        // The unseekable input still loads a valid array
+        std::string valid = bytes;
+        unseekable_buf source(valid);
+        std::istream in(&source);
+        load(bar, in);
+        REQUIRE(bar == foo);
+    }
+
+    SECTION("CORRUPTED STRING LENGTH")
+    {
+        dynamic_array<std::string> strings = {"alpha", "beta"};
+        std::string corrupted = saved(strings);
+        patch(corrupted, 48, std::uint64_t(1) << 40); // Length of the first string
+
+        dynamic_array<std::string> loaded;
+        std::istringstream is(corrupted, std::ios::binary);
+        REQUIRE_THROWS_WITH(load(loaded, is), Catch::Contains("string length"));
+        REQUIRE(loaded.empty());
+    }
+
+    SECTION("WRONG ELEMENT TYPE")
+    {
+        std::istringstream as_double(bytes, std::ios::binary);
+        std::istringstream as_string(bytes, std::ios::binary);
+        dynamic_array<double> doubles;
+        dynamic_array<std::string> strings;
+
+        REQUIRE_THROWS_WITH(load(doubles, as_double), Catch::Contains("element size"));
+        REQUIRE_THROWS_WITH(load(strings, as_string), Catch::Contains("format"));
+    }
+
+    SECTION("NOT A DYNAMIC ARRAY")
+    {
+        std::istringstream is(std::string(100, 'x'), std::ios::binary);
+        REQUIRE_THROWS_WITH(load(bar, is), Catch::Contains("Not a dynamic_array"));
+        REQUIRE_THROWS_AS(load(bar, std::string("/nonexistent/ds_file")), std::system_error);
+    }
+}
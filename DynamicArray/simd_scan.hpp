@@ -0,0 +1,594 @@
+#ifndef SIMD_SCAN_GUARD
+#define SIMD_SCAN_GUARD
+
+/*
+ *  Vectorized equality scans (find / count) and stream compaction (remove)
+ *  over contiguous arrays of integral and floating-point values, used by
+ *  dynamic_array, and word-wise popcount / AND / OR / XOR / ANDNOT used by
+ *  dynamic_bitset.
+ *  AVX2 and SSE4.2 kernels are selected at run time on x86-64 (GCC/Clang),
+ *  every other target uses the scalar loops.
+ *  Floating-point values compare with ==, so NaN never matches.
+*/
+
+#include <array>       // Compaction tables
+#include <cstddef>     // std::size_t
+#include <cstdint>     // Mask types
+#include <cstring>     // std::memcpy
+#include <type_traits> // Supported element types
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define DS_SIMD_X86 1
+#include <immintrin.h>
+#endif
+
+namespace ds
+{
+    namespace detail
+    {
+        namespace simd
+        {
+            // Element types the kernels can compare lane by lane
+            template <class T>
+            inline constexpr bool is_vectorizable =
+                (std::is_integral_v<T> && (sizeof(T) == 1 || sizeof(T) == 2 || sizeof(T) == 4 || sizeof(T) == 8)) ||
+                std::is_same_v<T, float> || std::is_same_v<T, double>;
+
+            // Scalar fallback - index of the first match or count if there is none
+            template <class T>
+            inline std::size_t find_scalar(const T *data, std::size_t count, T value)
+            {
+                for (std::size_t i = 0; i < count; i++)
+                {
+                    if (data[i] == value)
+                        return i;
+                }
+
+                return count;
+            }
+
+            template <class T>
+            inline std::size_t count_scalar(const T *data, std::size_t count, T value)
+            {
+                std::size_t matches = 0;
+                for (std::size_t i = 0; i < count; i++)
+                    matches += data[i] == value;
+
+                return matches;
+            }
+
+            // Moves the elements of [first, last) not equal to value to data + kept onwards (kept <= first),
+            // keeping their order - returns the new kept count. Branchless: every element is written,
+            // the output position only advances for the kept ones.
+            template <class T>
+            inline std::size_t compact_scalar(T *data, std::size_t first, std::size_t last, std::size_t kept, T value)
+            {
+                for (std::size_t i = first; i < last; i++)
+                {
+                    const T el = data[i];
+                    data[kept] = el;
+                    kept += !(el == value);
+                }
+
+                return kept;
+            }
+
+            template <class T>
+            inline std::size_t remove_scalar(T *data, std::size_t count, T value)
+            {
+                return compact_scalar(data, 0, count, 0, value);
+            }
+
+#ifdef DS_SIMD_X86
+            enum class isa
+            {
+                scalar,
+                sse42,
+                avx2
+            };
+
+            // The best instruction set of this CPU - detected once
+            inline isa detect()
+            {
+                static const isa level = []
+                {
+                    __builtin_cpu_init();
+                    if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("popcnt"))
+                        return isa::avx2;
+                    if (__builtin_cpu_supports("sse4.2") && __builtin_cpu_supports("popcnt"))
+                        return isa::sse42;
+                    return isa::scalar;
+                }();
+
+                return level;
+            }
+
+            // Bit pattern of value as a signed integer of the same size
+            template <class T>
+            inline auto bits_of(T value)
+            {
+                using bits_type = std::conditional_t<sizeof(T) == 1, std::int8_t,
+                                  std::conditional_t<sizeof(T) == 2, std::int16_t,
+                                  std::conditional_t<sizeof(T) == 4, std::int32_t, std::int64_t>>>;
+                bits_type bits;
+                std::memcpy(&bits, &value, sizeof(T));
+                return bits;
+            }
+
+            ///
+            // AVX2 - 32 bytes per vector
+
+            // Vector with value in every lane
+            template <class T>
+            __attribute__((target("avx2"))) inline __m256i avx2_broadcast(T value)
+            {
+                if constexpr (sizeof(T) == 1)
+                    return _mm256_set1_epi8(bits_of(value));
+                else if constexpr (sizeof(T) == 2)
+                    return _mm256_set1_epi16(bits_of(value));
+                else if constexpr (sizeof(T) == 4)
+                    return _mm256_set1_epi32(bits_of(value));
+                else
+                    return _mm256_set1_epi64x(bits_of(value));
+            }
+
+            // All ones in the lanes of block equal to needle
+            template <class T>
+            __attribute__((target("avx2"))) inline __m256i avx2_equal(__m256i block, __m256i needle)
+            {
+                if constexpr (std::is_same_v<T, float>)
+                    return _mm256_castps_si256(_mm256_cmp_ps(_mm256_castsi256_ps(block), _mm256_castsi256_ps(needle), _CMP_EQ_OQ));
+                else if constexpr (std::is_same_v<T, double>)
+                    return _mm256_castpd_si256(_mm256_cmp_pd(_mm256_castsi256_pd(block), _mm256_castsi256_pd(needle), _CMP_EQ_OQ));
+                else if constexpr (sizeof(T) == 1)
+                    return _mm256_cmpeq_epi8(block, needle);
+                else if constexpr (sizeof(T) == 2)
+                    return _mm256_cmpeq_epi16(block, needle);
+                else if constexpr (sizeof(T) == 4)
+                    return _mm256_cmpeq_epi32(block, needle);
+                else
+                    return _mm256_cmpeq_epi64(block, needle);
+            }
+
+            template <class T>
+            __attribute__((target("avx2"))) inline __m256i avx2_load_equal(const T *ptr, __m256i needle)
+            {
+                return avx2_equal<T>(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(ptr)), needle);
+            }
+
+            template <class T>
+            __attribute__((target("avx2,popcnt"))) inline std::size_t find_avx2(const T *data, std::size_t count, T value)
+            {
+                constexpr std::size_t lanes = 32 / sizeof(T);
+                const __m256i needle = avx2_broadcast(value);
+                std::size_t i = 0;
+
+                // Four vectors per iteration until one of them holds a match
+                for (; i + 4 * lanes <= count; i += 4 * lanes)
+                {
+                    const __m256i any = _mm256_or_si256(
+                        _mm256_or_si256(avx2_load_equal(data + i, needle), avx2_load_equal(data + i + lanes, needle)),
+                        _mm256_or_si256(avx2_load_equal(data + i + 2 * lanes, needle), avx2_load_equal(data + i + 3 * lanes, needle)));
+
+                    if (!_mm256_testz_si256(any, any))
+                        break;
+                }
+
+                for (; i + lanes <= count; i += lanes)
+                {
+                    const std::uint32_t mask = _mm256_movemask_epi8(avx2_load_equal(data + i, needle));
+                    if (mask)
+                        return i + __builtin_ctz(mask) / sizeof(T);
+                }
+
+                return i + find_scalar(data + i, count - i, value);
+            }
+
+            template <class T>
+            __attribute__((target("avx2,popcnt"))) inline std::size_t count_avx2(const T *data, std::size_t count, T value)
+            {
+                constexpr std::size_t lanes = 32 / sizeof(T);
+                const __m256i needle = avx2_broadcast(value);
+                std::size_t i = 0, matches = 0;
+
+                for (; i + lanes <= count; i += lanes)
+                {
+                    const std::uint32_t mask = _mm256_movemask_epi8(avx2_load_equal(data + i, needle));
+                    matches += __builtin_popcount(mask);
+                }
+
+                return matches / sizeof(T) + count_scalar(data + i, count - i, value);
+            }
+
+            // Lane permutations which pack the 32-bit lanes selected by an 8 bit mask to the front
+            inline constexpr std::array<std::array<std::uint32_t, 8>, 256> compress_table32 = []
+            {
+                std::array<std::array<std::uint32_t, 8>, 256> table{};
+                for (std::uint32_t mask = 0; mask < 256; mask++)
+                {
+                    std::uint32_t out = 0;
+                    for (std::uint32_t lane = 0; lane < 8; lane++)
+                    {
+                        if (mask & (1u << lane))
+                            table[mask][out++] = lane;
+                    }
+                }
+                return table;
+            }();
+
+            // Same for 64-bit lanes selected by a 4 bit mask - each lane is a pair of 32-bit lanes
+            inline constexpr std::array<std::array<std::uint32_t, 8>, 16> compress_table64 = []
+            {
+                std::array<std::array<std::uint32_t, 8>, 16> table{};
+                for (std::uint32_t mask = 0; mask < 16; mask++)
+                {
+                    std::uint32_t out = 0;
+                    for (std::uint32_t lane = 0; lane < 4; lane++)
+                    {
+                        if (mask & (1u << lane))
+                        {
+                            table[mask][out++] = 2 * lane;
+                            table[mask][out++] = 2 * lane + 1;
+                        }
+                    }
+                }
+                return table;
+            }();
+
+            // Stream compaction. Every vector is loaded before anything is stored over it and the output
+            // never passes the input, so full-width stores behind the kept lanes only hit consumed elements.
+            // 32 and 64-bit lanes are packed with a permutation, vectors of narrower lanes that hold a match
+            // fall back to the scalar loop.
+            template <class T>
+            __attribute__((target("avx2,popcnt"))) inline std::size_t remove_avx2(T *data, std::size_t count, T value)
+            {
+                constexpr std::size_t lanes = 32 / sizeof(T);
+                const __m256i needle = avx2_broadcast(value);
+                std::size_t i = 0, kept = 0;
+
+                for (; i + lanes <= count; i += lanes)
+                {
+                    const __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(data + i));
+                    const __m256i equal = avx2_equal<T>(block, needle);
+
+                    if (_mm256_testz_si256(equal, equal))
+                    {
+                        _mm256_storeu_si256(reinterpret_cast<__m256i *>(data + kept), block);
+                        kept += lanes;
+                    }
+                    else if constexpr (sizeof(T) == 4)
+                    {
+                        const std::uint32_t keep = ~static_cast<std::uint32_t>(_mm256_movemask_ps(_mm256_castsi256_ps(equal))) & 0xFF;
+                        const __m256i order = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(compress_table32[keep].data()));
+                        _mm256_storeu_si256(reinterpret_cast<__m256i *>(data + kept), _mm256_permutevar8x32_epi32(block, order));
+                        kept += __builtin_popcount(keep);
+                    }
+                    else if constexpr (sizeof(T) == 8)
+                    {
+                        const std::uint32_t keep = ~static_cast<std::uint32_t>(_mm256_movemask_pd(_mm256_castsi256_pd(equal))) & 0xF;
+                        const __m256i order = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(compress_table64[keep].data()));
+                        _mm256_storeu_si256(reinterpret_cast<__m256i *>(data + kept), _mm256_permutevar8x32_epi32(block, order));
+                        kept += __builtin_popcount(keep);
+                    }
+                    else
+                    {
+                        kept = compact_scalar(data, i, i + lanes, kept, value);
+                    }
+                }
+
+                return compact_scalar(data, i, count, kept, value);
+            }
+
+            ///
+            // SSE4.2 - 16 bytes per vector
+
+            // Vector with value in every lane
+            template <class T>
+            __attribute__((target("sse4.2"))) inline __m128i sse42_broadcast(T value)
+            {
+                if constexpr (sizeof(T) == 1)
+                    return _mm_set1_epi8(bits_of(value));
+                else if constexpr (sizeof(T) == 2)
+                    return _mm_set1_epi16(bits_of(value));
+                else if constexpr (sizeof(T) == 4)
+                    return _mm_set1_epi32(bits_of(value));
+                else
+                    return _mm_set1_epi64x(bits_of(value));
+            }
+
+            template <class T>
+            __attribute__((target("sse4.2"))) inline __m128i sse42_load_equal(const T *ptr, __m128i needle)
+            {
+                const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i *>(ptr));
+
+                if constexpr (std::is_same_v<T, float>)
+                    return _mm_castps_si128(_mm_cmpeq_ps(_mm_castsi128_ps(block), _mm_castsi128_ps(needle)));
+                else if constexpr (std::is_same_v<T, double>)
+                    return _mm_castpd_si128(_mm_cmpeq_pd(_mm_castsi128_pd(block), _mm_castsi128_pd(needle)));
+                else if constexpr (sizeof(T) == 1)
+                    return _mm_cmpeq_epi8(block, needle);
+                else if constexpr (sizeof(T) == 2)
+                    return _mm_cmpeq_epi16(block, needle);
+                else if constexpr (sizeof(T) == 4)
+                    return _mm_cmpeq_epi32(block, needle);
+                else
+                    return _mm_cmpeq_epi64(block, needle);
+            }
+
+            template <class T>
+            __attribute__((target("sse4.2,popcnt"))) inline std::size_t find_sse42(const T *data, std::size_t count, T value)
+            {
+                constexpr std::size_t lanes = 16 / sizeof(T);
+                const __m128i needle = sse42_broadcast(value);
+                std::size_t i = 0;
+
+                for (; i + lanes <= count; i += lanes)
+                {
+                    const std::uint32_t mask = _mm_movemask_epi8(sse42_load_equal(data + i, needle));
+                    if (mask)
+                        return i + __builtin_ctz(mask) / sizeof(T);
+                }
+
+                return i + find_scalar(data + i, count - i, value);
+            }
+
+            template <class T>
+            __attribute__((target("sse4.2,popcnt"))) inline std::size_t count_sse42(const T *data, std::size_t count, T value)
+            {
+                constexpr std::size_t lanes = 16 / sizeof(T);
+                const __m128i needle = sse42_broadcast(value);
+                std::size_t i = 0, matches = 0;
+
+                for (; i + lanes <= count; i += lanes)
+                {
+                    const std::uint32_t mask = _mm_movemask_epi8(sse42_load_equal(data + i, needle));
+                    matches += __builtin_popcount(mask);
+                }
+
+                return matches / sizeof(T) + count_scalar(data + i, count - i, value);
+            }
+
+            // Vectors without a match are stored whole, the others are packed by the scalar loop
+            template <class T>
+            __attribute__((target("sse4.2,popcnt"))) inline std::size_t remove_sse42(T *data, std::size_t count, T value)
+            {
+                constexpr std::size_t lanes = 16 / sizeof(T);
+                const __m128i needle = sse42_broadcast(value);
+                std::size_t i = 0, kept = 0;
+
+                for (; i + lanes <= count; i += lanes)
+                {
+                    const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + i));
+                    if (_mm_movemask_epi8(sse42_load_equal(data + i, needle)) == 0)
+                    {
+                        _mm_storeu_si128(reinterpret_cast<__m128i *>(data + kept), block);
+                        kept += lanes;
+                    }
+                    else
+                    {
+                        kept = compact_scalar(data, i, i + lanes, kept, value);
+                    }
+                }
+
+                return compact_scalar(data, i, count, kept, value);
+            }
+#endif // DS_SIMD_X86
+
+            ///
+            // Dispatch
+
+            // Index of the first element equal to value, count if there is none
+            template <class T>
+            inline std::size_t find(const T *data, std::size_t count, T value)
+            {
+#ifdef DS_SIMD_X86
+                switch (detect())
+                {
+                case isa::avx2:
+                    return find_avx2(data, count, value);
+                case isa::sse42:
+                    return find_sse42(data, count, value);
+                default:
+                    break;
+                }
+#endif
+                return find_scalar(data, count, value);
+            }
+
+            // Number of elements equal to value
+            template <class T>
+            inline std::size_t count(const T *data, std::size_t count, T value)
+            {
+#ifdef DS_SIMD_X86
+                switch (detect())
+                {
+                case isa::avx2:
+                    return count_avx2(data, count, value);
+                case isa::sse42:
+                    return count_sse42(data, count, value);
+                default:
+                    break;
+                }
+#endif
+                return count_scalar(data, count, value);
+            }
+
+            // Removes the elements equal to value keeping the order of the rest - returns how many are left
+            template <class T>
+            inline std::size_t remove(T *data, std::size_t count, T value)
+            {
+#ifdef DS_SIMD_X86
+                switch (detect())
+                {
+                case isa::avx2:
+                    return remove_avx2(data, count, value);
+                case isa::sse42:
+                    return remove_sse42(data, count, value);
+                default:
+                    break;
+                }
+#endif
+                return remove_scalar(data, count, value);
+            }
+
+            ///
+            // Bit operations over arrays of 64-bit words (dynamic_bitset)
+
+            enum class bit_op
+            {
+                and_,
+                or_,
+                xor_,
+                and_not // lhs & ~rhs
+            };
+
+            // Set bits of one word
+            inline unsigned int popcount_word(std::uint64_t word)
+            {
+#if defined(__GNUC__) || defined(__clang__)
+                return static_cast<unsigned int>(__builtin_popcountll(word));
+#else
+                word = word - ((word >> 1) & 0x5555555555555555ULL);
+                word = (word & 0x3333333333333333ULL) + ((word >> 2) & 0x3333333333333333ULL);
+                word = (word + (word >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+                return static_cast<unsigned int>((word * 0x0101010101010101ULL) >> 56);
+#endif
+            }
+
+            template <bit_op Op>
+            inline std::uint64_t apply_word(std::uint64_t lhs, std::uint64_t rhs)
+            {
+                if constexpr (Op == bit_op::and_)
+                    return lhs & rhs;
+                else if constexpr (Op == bit_op::or_)
+                    return lhs | rhs;
+                else if constexpr (Op == bit_op::xor_)
+                    return lhs ^ rhs;
+                else
+                    return lhs & ~rhs;
+            }
+
+            inline std::size_t popcount_scalar(const std::uint64_t *words, std::size_t count)
+            {
+                std::size_t bits = 0;
+                for (std::size_t i = 0; i < count; i++)
+                    bits += popcount_word(words[i]);
+
+                return bits;
+            }
+
+            // dest[i] = dest[i] Op src[i] - dest and src may be the same array
+            template <bit_op Op>
+            inline void bitwise_scalar(std::uint64_t *dest, const std::uint64_t *src, std::size_t count)
+            {
+                for (std::size_t i = 0; i < count; i++)
+                    dest[i] = apply_word<Op>(dest[i], src[i]);
+            }
+
+#ifdef DS_SIMD_X86
+            // Four independent sums - the popcnt instructions do not wait for each other
+            __attribute__((target("popcnt"))) inline std::size_t popcount_popcnt(const std::uint64_t *words, std::size_t count)
+            {
+                std::uint64_t sums[4] = {};
+                std::size_t i = 0;
+                for (; i + 4 <= count; i += 4)
+                {
+                    sums[0] += _mm_popcnt_u64(words[i]);
+                    sums[1] += _mm_popcnt_u64(words[i + 1]);
+                    sums[2] += _mm_popcnt_u64(words[i + 2]);
+                    sums[3] += _mm_popcnt_u64(words[i + 3]);
+                }
+
+                for (; i < count; i++)
+                    sums[0] += _mm_popcnt_u64(words[i]);
+
+                return sums[0] + sums[1] + sums[2] + sums[3];
+            }
+
+            template <bit_op Op>
+            __attribute__((target("avx2"))) inline __m256i avx2_apply(__m256i lhs, __m256i rhs)
+            {
+                if constexpr (Op == bit_op::and_)
+                    return _mm256_and_si256(lhs, rhs);
+                else if constexpr (Op == bit_op::or_)
+                    return _mm256_or_si256(lhs, rhs);
+                else if constexpr (Op == bit_op::xor_)
+                    return _mm256_xor_si256(lhs, rhs);
+                else
+                    return _mm256_andnot_si256(rhs, lhs); // Negates its first operand
+            }
+
+            template <bit_op Op>
+            __attribute__((target("avx2"))) inline void bitwise_avx2(std::uint64_t *dest, const std::uint64_t *src, std::size_t count)
+            {
+                std::size_t i = 0;
+                for (; i + 4 <= count; i += 4)
+                {
+                    const __m256i lhs = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(dest + i));
+                    const __m256i rhs = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(src + i));
+                    _mm256_storeu_si256(reinterpret_cast<__m256i *>(dest + i), avx2_apply<Op>(lhs, rhs));
+                }
+
+                bitwise_scalar<Op>(dest + i, src + i, count - i);
+            }
+
+            template <bit_op Op>
+            __attribute__((target("sse4.2"))) inline __m128i sse42_apply(__m128i lhs, __m128i rhs)
+            {
+                if constexpr (Op == bit_op::and_)
+                    return _mm_and_si128(lhs, rhs);
+                else if constexpr (Op == bit_op::or_)
+                    return _mm_or_si128(lhs, rhs);
+                else if constexpr (Op == bit_op::xor_)
+                    return _mm_xor_si128(lhs, rhs);
+                else
+                    return _mm_andnot_si128(rhs, lhs);
+            }
+
+            template <bit_op Op>
+            __attribute__((target("sse4.2"))) inline void bitwise_sse42(std::uint64_t *dest, const std::uint64_t *src, std::size_t count)
+            {
+                std::size_t i = 0;
+                for (; i + 2 <= count; i += 2)
+                {
+                    const __m128i lhs = _mm_loadu_si128(reinterpret_cast<const __m128i *>(dest + i));
+                    const __m128i rhs = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i));
+                    _mm_storeu_si128(reinterpret_cast<__m128i *>(dest + i), sse42_apply<Op>(lhs, rhs));
+                }
+
+                bitwise_scalar<Op>(dest + i, src + i, count - i);
+            }
+#endif // DS_SIMD_X86
+
+            // Number of set bits in count words
+            inline std::size_t popcount(const std::uint64_t *words, std::size_t count)
+            {
+#ifdef DS_SIMD_X86
+                if (detect() != isa::scalar) // Both vector levels come with popcnt
+                    return popcount_popcnt(words, count);
+#endif
+                return popcount_scalar(words, count);
+            }
+
+            // dest[i] = dest[i] Op src[i] for count words
+            template <bit_op Op>
+            inline void bitwise(std::uint64_t *dest, const std::uint64_t *src, std::size_t count)
+            {
+#ifdef DS_SIMD_X86
+                switch (detect())
+                {
+                case isa::avx2:
+                    return bitwise_avx2<Op>(dest, src, count);
+                case isa::sse42:
+                    return bitwise_sse42<Op>(dest, src, count);
+                default:
+                    break;
+                }
+#endif
+                bitwise_scalar<Op>(dest, src, count);
+            }
+        } // namespace simd
+    } // namespace detail
+} // namespace ds
+
+#endif // SIMD_SCAN_GUARD
@@ -0,0 +1,598 @@
+#ifndef SMALL_ARRAY_GUARD
+#define SMALL_ARRAY_GUARD
+
+/*
+ *  Random access sequence container (array) with the dynamic_array interface
+ *  which keeps up to N elements inside the object itself and only
+ *  allocates heap storage once it grows past N elements.
+*/
+
+#include "dynamic_array.hpp" // Shared element helpers and iterator
+
+namespace ds
+{
+    template <class T, std::size_t N>
+    class small_array
+    {
+        static_assert(N > 0, "small_array requires a non-zero inline capacity");
+
+    public:
+        using value_type = T;
+        using size_type = std::size_t;
+        using iterator = detail::array_iterator<T, small_array>;
+        using const_iterator = detail::array_iterator<const T, small_array>;
+
+        // Constructors, Destructors; Gang of Four
+
+        // Default - Constructs an empty container with selected or default (inline) initial m_capacity
+        explicit small_array(size_type m_capacity = N);
+
+        // Fill Constructor
+        explicit small_array(size_type m_capacity, const T &element);
+
+        // Constructs a container with a copy of each of the elements in il, in the same order.
+        small_array(const std::initializer_list<T> &i_list);
+
+        // Constructs a container with a copy of each of the elements and keep the original order
+        small_array(const small_array &other);
+
+        // Move constructor - takes over a heap buffer, inline elements are moved one by one.
+        // other is left empty and inline
+        small_array(small_array &&other) noexcept(std::is_nothrow_move_constructible_v<T>);
+
+        // Copy assignment operator (copy-and-swap idiom)
+        small_array &operator=(small_array other);
+
+        // Destructor
+        ~small_array();
+
+        ///
+        // Basic Operations
+
+        // Add one element to the back
+        void push_back(const T &el);
+        void push_back(T &&el);
+
+        // Constructs an element in place at the back from args
+        template <class... Args>
+        T &emplace_back(Args &&...args);
+
+        // Insert an element
+        void insert(size_type position, const T &val);
+        void insert(size_type position, T &&val);
+
+        // Constructs an element from args and inserts it before position
+        template <class... Args>
+        void emplace(size_type position, Args &&...args);
+
+        // Access operators
+        // operator[] is checked according to DS_BOUNDS_CHECK, at() always throws std::out_of_range
+        const T &operator[](size_type index) const;
+        T &operator[](size_type index);
+
+        const T &at(size_type index) const;
+        T &at(size_type index);
+
+        // Access first element
+        const T &front() const;
+        T &front();
+
+        // Access last element
+        const T &back() const;
+        T &back();
+
+        ///
+        // Remove operations
+        void pop_back();
+
+        // Erease an element from selected position
+        void erase(size_type position);
+
+        // Destroys all elements, the capacity is kept for reuse
+        void clear();
+
+        ///
+        // Capacity operations
+
+        // Releases the unused capacity - returns to the inline storage if the elements fit in it
+        void shrink_to_fit();
+
+        ///
+        // Information methods
+        size_type size() const;
+
+        size_type capacity() const;
+
+        // The largest number of elements the array can hold
+        size_type max_size() const;
+
+        bool empty() const;
+
+        // Checks whether the elements are stored inside the object
+        bool is_inline() const;
+
+        // Comparison operators
+        bool operator==(const small_array &other) const;
+
+        ///
+        // Elements are contiguous in the inline buffer or on the heap
+        T *data() noexcept { return m_data; }
+        const T *data() const noexcept { return m_data; }
+
+        ///
+        // Iterator - pointer behaviour
+        using Iterator = iterator;
+
+        iterator begin() noexcept { return iterator(m_data); }
+        iterator end() noexcept { return iterator(m_data + m_size); }
+        const_iterator begin() const noexcept { return const_iterator(m_data); }
+        const_iterator end() const noexcept { return const_iterator(m_data + m_size); }
+        const_iterator cbegin() const noexcept { return begin(); }
+        const_iterator cend() const noexcept { return end(); }
+
+        // Debug info methods
+    public:
+        void printInfo(std::ostream &os) const;
+
+    private:
+        T *m_data; // Points either to m_buffer or to heap storage
+        size_type m_size, m_capacity;
+
+        alignas(T) unsigned char m_buffer[N * sizeof(T)]; // Inline storage
+
+        inline static std::allocator<T> m_alloc; // Stateless - used for the heap storage
+
+        ///
+        // Helpers
+    private:
+        T *inline_data() { return reinterpret_cast<T *>(m_buffer); }
+        const T *inline_data() const { return reinterpret_cast<const T *>(m_buffer); }
+
+        static T *allocate(size_type count);
+        static void deallocate(T *ptr, size_type count) noexcept;
+
+        void init_storage(size_type capacity);
+        void release_storage() noexcept;
+        void steal(small_array &src) noexcept(std::is_nothrow_move_constructible_v<T>);
+
+        friend void swap(small_array &first, small_array &second) noexcept(std::is_nothrow_move_constructible_v<T>)
+        {
+            if (!first.is_inline() && !second.is_inline())
+            {
+                // Both on the heap - the buffers change owners
+                using std::swap;
+                swap(first.m_data, second.m_data);
+                swap(first.m_size, second.m_size);
+                swap(first.m_capacity, second.m_capacity);
+                return;
+            }
+
+            // Inline elements cannot change owners by a pointer swap
+            small_array temp(std::move(first));
+            first.steal(second);
+            second.steal(temp);
+        }
+        void reserve_size();
+        void reallocate(size_type new_capacity);
+    };
+
+    template <class T, std::size_t N>
+    inline small_array<T, N>::small_array(size_type m_capacity)
+        : m_size(0)
+    {
+        if (m_capacity == 0)
+            throw std::invalid_argument("Invalid initial m_capacity!");
+
+        init_storage(m_capacity);
+    }
+
+    template <class T, std::size_t N>
+    inline small_array<T, N>::small_array(size_type m_capacity, const T &element)
+        : small_array(m_capacity)
+    {
+        // T's copy ctor might fail and throw exception.
+        // detail::uninitialized_fill_n destroys the already constructed copies.
+        try
+        {
+            detail::uninitialized_fill_n(m_alloc, m_data, m_capacity, element);
+        }
+        catch (...)
+        {
+            std::cerr << "Invalid object copy operation!" << std::endl;
+            throw; // Rethrow the exception
+        }
+
+        m_size = m_capacity;
+    }
+
+    template <class T, std::size_t N>
+    inline small_array<T, N>::small_array(const std::initializer_list<T> &i_list)
+        : small_array(i_list.size() > N ? i_list.size() : N)
+    {
+        // T's copy ctor might fail and throw exception.
+        // The m_size would track the successfully constructed data.
+        for (const T &el : i_list)
+        {
+            ::new (static_cast<void *>(m_data + m_size)) T(el);
+            ++m_size;
+        }
+    }
+
+    template <class T, std::size_t N>
+    inline small_array<T, N>::small_array(const small_array &other)
+        : m_size(0)
+    {
+        init_storage(other.m_size > N ? other.m_capacity : N);
+        try
+        {
+            detail::uninitialized_copy(m_alloc, other.m_data, other.m_data + other.m_size, m_data);
+        }
+        catch (...)
+        {
+            release_storage();
+            throw;
+        }
+
+        m_size = other.m_size;
+    }
+
+    // O(1) - Constant time with heap storage, O(N) for inline elements
+    template <class T, std::size_t N>
+    inline small_array<T, N>::small_array(small_array &&other) noexcept(std::is_nothrow_move_constructible_v<T>)
+        : m_data(inline_data()), m_size(0), m_capacity(N)
+    {
+        steal(other);
+    }
+
+    // Copy-And-Swap idiom
+    template <class T, std::size_t N>
+    inline small_array<T, N> &small_array<T, N>::operator=(small_array other)
+    {
+        swap(*this, other);
+
+        return *this;
+    }
+
+    template <class T, std::size_t N>
+    inline small_array<T, N>::~small_array()
+    {
+        detail::destroy_range(m_alloc, m_data, m_data + m_size);
+        release_storage();
+    }
+
+    // Amortized constant complexity O(1)
+    template <class T, std::size_t N>
+    inline void small_array<T, N>::push_back(const T &el)
+    {
+        emplace_back(el);
+    }
+
+    // Amortized constant complexity O(1)
+    template <class T, std::size_t N>
+    inline void small_array<T, N>::push_back(T &&el)
+    {
+        emplace_back(std::move(el));
+    }
+
+    // Amortized constant complexity O(1)
+    template <class T, std::size_t N>
+    template <class... Args>
+    inline T &small_array<T, N>::emplace_back(Args &&...args)
+    {
+        if (m_size >= m_capacity)
+        {
+            T copy(std::forward<Args>(args)...); // args might refer to an element which is about to be relocated
+            reserve_size();
+            ::new (static_cast<void *>(m_data + m_size)) T(std::move(copy));
+        }
+        else
+        {
+            ::new (static_cast<void *>(m_data + m_size)) T(std::forward<Args>(args)...);
+        }
+
+        return m_data[m_size++];
+    }
+
+    // O(n) - Linear time
+    template <class T, std::size_t N>
+    inline void small_array<T, N>::insert(size_type position, const T &val)
+    {
+        emplace(position, val);
+    }
+
+    // O(n) - Linear time
+    template <class T, std::size_t N>
+    inline void small_array<T, N>::insert(size_type position, T &&val)
+    {
+        emplace(position, std::move(val));
+    }
+
+    // O(n) - Linear time
+    template <class T, std::size_t N>
+    template <class... Args>
+    inline void small_array<T, N>::emplace(size_type position, Args &&...args)
+    {
+        if (position >= m_size)
+        {
+            throw std::invalid_argument("Invalid insert position!");
+        }
+
+        // Built before shifting - args might refer to an element which is about to be moved
+        T copy(std::forward<Args>(args)...);
+
+        if (m_size >= m_capacity)
+        {
+            reserve_size(); // Guarantee enough capacity
+        }
+
+        detail::shift_right(m_alloc, m_data, m_size, position);
+        ++m_size;
+
+        m_data[position] = std::move(copy);
+    }
+
+    // O(n) - Linear time
+    template <class T, std::size_t N>
+    inline void small_array<T, N>::erase(size_type position)
+    {
+        if (position >= m_size)
+        {
+            throw std::invalid_argument("Invalid insert position!");
+        }
+
+        detail::shift_left(m_alloc, m_data, m_size, position);
+        --m_size;
+    }
+
+    // O(1) - Constant time
+    template <class T, std::size_t N>
+    inline void small_array<T, N>::pop_back()
+    {
+        if (m_size == 0)
+            throw std::logic_error("Invalid opration: Cannot pop from empty array!");
+
+        --m_size;
+        m_data[m_size].~T();
+    }
+
+    // O(n) - Linear time (destructors of the stored elements)
+    template <class T, std::size_t N>
+    inline void small_array<T, N>::clear()
+    {
+        detail::destroy_range(m_alloc, m_data, m_data + m_size);
+        m_size = 0;
+    }
+
+    // O(n) - Linear time
+    template <class T, std::size_t N>
+    inline void small_array<T, N>::shrink_to_fit()
+    {
+        if (is_inline() || m_capacity == m_size)
+            return;
+
+        reallocate(m_size);
+    }
+
+    // Helpers
+
+    template <class T, std::size_t N>
+    inline T *small_array<T, N>::allocate(size_type count)
+    {
+        return m_alloc.allocate(count); // Might throw bad_alloc
+    }
+
+    template <class T, std::size_t N>
+    inline void small_array<T, N>::deallocate(T *ptr, size_type count) noexcept
+    {
+        m_alloc.deallocate(ptr, count);
+    }
+
+    // Selects the inline buffer when capacity fits in it, heap storage otherwise
+    template <class T, std::size_t N>
+    inline void small_array<T, N>::init_storage(size_type capacity)
+    {
+        if (capacity <= N)
+        {
+            m_data = inline_data();
+            m_capacity = N;
+        }
+        else
+        {
+            m_data = allocate(capacity);
+            m_capacity = capacity;
+        }
+    }
+
+    template <class T, std::size_t N>
+    inline void small_array<T, N>::release_storage() noexcept
+    {
+        if (!is_inline())
+            deallocate(m_data, m_capacity);
+    }
+
+    // Moves the contents of src into this empty array and leaves src empty and inline.
+    // Heap buffers change owners, inline elements are moved one by one.
+    template <class T, std::size_t N>
+    inline void small_array<T, N>::steal(small_array &src) noexcept(std::is_nothrow_move_constructible_v<T>)
+    {
+        if (src.is_inline())
+        {
+            detail::uninitialized_move_if_noexcept(m_alloc, src.m_data, src.m_data + src.m_size, m_data);
+            detail::destroy_range(m_alloc, src.m_data, src.m_data + src.m_size);
+        }
+        else
+        {
+            release_storage();
+            m_data = src.m_data;
+            m_capacity = src.m_capacity;
+            src.m_data = src.inline_data();
+            src.m_capacity = N;
+        }
+
+        m_size = src.m_size;
+        src.m_size = 0;
+    }
+
+    // O(n) - Linear time
+    // Leaves the inline buffer for the heap once N elements are exceeded
+    template <class T, std::size_t N>
+    inline void small_array<T, N>::reserve_size()
+    {
+        reallocate(detail::next_capacity<growth::doubling>(m_capacity, max_size(), sizeof(T)));
+    }
+
+    // O(n) - Linear time
+    // Moves the elements into storage for new_capacity >= m_size elements - the inline buffer if they fit in it
+    template <class T, std::size_t N>
+    inline void small_array<T, N>::reallocate(size_type new_capacity)
+    {
+        T *temp = new_capacity <= N ? inline_data() : allocate(new_capacity);
+
+        try
+        {
+            detail::uninitialized_move_if_noexcept(m_alloc, m_data, m_data + m_size, temp);
+        }
+        catch (...)
+        {
+            if (temp != inline_data())
+                deallocate(temp, new_capacity);
+            throw;
+        }
+
+        detail::destroy_range(m_alloc, m_data, m_data + m_size);
+        release_storage();
+        m_data = temp;
+
+        m_capacity = temp == inline_data() ? N : new_capacity;
+    }
+
+    // Random access operations (operator [], front, back, at)
+
+    // O(1) - Constant time
+    template <class T, std::size_t N>
+    inline const T &small_array<T, N>::operator[](size_type index) const
+    {
+        detail::check_subscript(index, m_size); // Policy selected by DS_BOUNDS_CHECK
+
+        return m_data[index];
+    }
+
+    // O(1) - Constant time
+    template <class T, std::size_t N>
+    inline T &small_array<T, N>::operator[](size_type index)
+    {
+        detail::check_subscript(index, m_size); // Policy selected by DS_BOUNDS_CHECK
+
+        return m_data[index];
+    }
+
+    // O(1) - Constant time
+    template <class T, std::size_t N>
+    inline const T &small_array<T, N>::at(size_type index) const
+    {
+        if (index >= m_size)
+            throw std::out_of_range("Invalid index!");
+
+        return m_data[index];
+    }
+
+    // O(1) - Constant time
+    template <class T, std::size_t N>
+    inline T &small_array<T, N>::at(size_type index)
+    {
+        if (index >= m_size)
+            throw std::out_of_range("Invalid index!");
+
+        return m_data[index];
+    }
+
+    // O(1) - Constant time
+    template <class T, std::size_t N>
+    inline T &small_array<T, N>::front()
+    {
+        if (m_size == 0)
+            throw std::logic_error("Invalid opration: empty array!");
+
+        return m_data[0];
+    }
+
+    // O(1) - Constant time
+    template <class T, std::size_t N>
+    inline const T &small_array<T, N>::front() const
+    {
+        if (m_size == 0)
+            throw std::logic_error("Invalid opration: empty array!");
+
+        return m_data[0];
+    }
+
+    // O(1) - Constant time
+    template <class T, std::size_t N>
+    inline T &small_array<T, N>::back()
+    {
+        if (m_size == 0)
+            throw std::logic_error("Invalid opration: empty array!");
+
+        return m_data[m_size - 1];
+    }
+
+    // O(1) - Constant time
+    template <class T, std::size_t N>
+    inline const T &small_array<T, N>::back() const
+    {
+        if (m_size == 0)
+            throw std::logic_error("Invalid opration: empty array!");
+
+        return m_data[m_size - 1];
+    }
+
+    template <class T, std::size_t N>
+    inline bool small_array<T, N>::operator==(const small_array &other) const
+    {
+        if (this->m_size != other.m_size)
+            return false;
+
+        return detail::equal(m_data, other.m_data, m_size);
+    }
+
+    template <class T, std::size_t N>
+    inline typename small_array<T, N>::size_type small_array<T, N>::size() const
+    {
+        return m_size;
+    }
+
+    template <class T, std::size_t N>
+    inline typename small_array<T, N>::size_type small_array<T, N>::capacity() const
+    {
+        return m_capacity;
+    }
+
+    template <class T, std::size_t N>
+    inline typename small_array<T, N>::size_type small_array<T, N>::max_size() const
+    {
+        return std::numeric_limits<std::ptrdiff_t>::max() / sizeof(T);
+    }
+
+    template <class T, std::size_t N>
+    inline bool small_array<T, N>::empty() const
+    {
+        return m_size == 0;
+    }
+
+    template <class T, std::size_t N>
+    inline bool small_array<T, N>::is_inline() const
+    {
+        return m_data == inline_data();
+    }
+
+    // Debug Info
+    template <class T, std::size_t N>
+    inline void small_array<T, N>::printInfo(std::ostream &os) const
+    {
+        os << "Address: 0x" << this << "\nBuffer Address 0x" << m_data << (is_inline() ? " (inline)" : "")
+           << "\nm_size: " << m_size << "\nm_capacity: " << m_capacity << std::endl;
+    }
+
+} // namespace ds
+
+#endif // SMALL_ARRAY_GUARD
@@ -0,0 +1,217 @@
+#define CATCH_CONFIG_MAIN
+#include "../Catch2/catch.hpp"
+#include "small_array.hpp"
+
+#include <string>
+#include <type_traits>
+
+using namespace ds;
+
+TEST_CASE("CONSTRUCTORS_DESTRUCTOR", "[CONSTRUCTOR][DESTRUCTOR]")
+{
+    SECTION("DEFAULT")
+    {
+        const unsigned int INLINE_CAPACITY = 8;
+        small_array<int, INLINE_CAPACITY> def;
+
+        REQUIRE(def.size() == 0);
+        REQUIRE(def.empty());
+        REQUIRE(def.is_inline());
+        REQUIRE(def.capacity() == INLINE_CAPACITY);
+        REQUIRE_THROWS(def.at(0));
+    }
+
+    SECTION("CONSTRUCTOR WITH CAPACITY PARAMETER")
+    {
+        small_array<double, 4> small(2);
+        small_array<double, 4> big(32);
+
+        REQUIRE(small.is_inline());
+        REQUIRE(small.capacity() == 4);
+
+        REQUIRE_FALSE(big.is_inline());
+        REQUIRE(big.capacity() == 32);
+        REQUIRE_THROWS((small_array<double, 4>(0)));
+    }
+
+    SECTION("FILL CONSTRUCTOR")
+    {
+        const unsigned int SIZE = 10;
+        const double ELEMENT = 3.141592;
+
+        small_array<double, 16> foo(SIZE, ELEMENT);
+
+        REQUIRE(foo.size() == SIZE);
+        REQUIRE(foo.is_inline());
+        REQUIRE(foo.front() == ELEMENT);
+        REQUIRE(foo.back() == ELEMENT);
+    }
+
+    SECTION("CONSTRUCTOR WITH IL")
+    {
+        small_array<char, 2> foo = {'a', 'b', 'c'};
+
+        REQUIRE(foo.size() == 3);
+        REQUIRE_FALSE(foo.is_inline());
+        REQUIRE((foo[0] == 'a' && foo[1] == 'b' && foo[2] == 'c'));
+    }
+
+    SECTION("COPY CONSTRUCTOR AND OPERATOR=")
+    {
+        small_array<std::string, 2> inl = {"first", "second"};
+        small_array<std::string, 2> heap = {"a", "b", "c", "d"};
+
+        small_array<std::string, 2> copy(inl);
+        REQUIRE(copy == inl);
+        REQUIRE(copy.is_inline());
+
+        copy = heap;
+        REQUIRE(copy == heap);
+        REQUIRE_FALSE(copy.is_inline());
+
+        copy = inl;
+        REQUIRE(copy == inl);
+        REQUIRE(copy.is_inline());
+    }
+}
+
+TEST_CASE("DEFAULT OPERATIONS", "[OPERATIONS]")
+{
+    SECTION("PUSH BACK SPILLS TO THE HEAP")
+    {
+        const unsigned int INLINE_CAPACITY = 4;
+        small_array<std::string, INLINE_CAPACITY> foo;
+
+        for (unsigned int i = 0; i < INLINE_CAPACITY; i++)
+            foo.push_back(std::to_string(i));
+
+        REQUIRE(foo.is_inline());
+
+        foo.push_back(foo[0]);
+
+        REQUIRE_FALSE(foo.is_inline());
+        REQUIRE(foo.size() == INLINE_CAPACITY + 1);
+        REQUIRE(foo.capacity() == GROWTH_RATE * INLINE_CAPACITY);
+        REQUIRE(foo.back() == "0");
+    }
+
+    SECTION("INSERT, ERASE AND POP BACK")
+    {
+        small_array<int, 4> foo = {1, 2, 3, 4};
+        small_array<int, 4> expect = {1, 2, 5, 3, 4};
+
+        foo.insert(2, 5);
+        REQUIRE(foo == expect);
+        REQUIRE_THROWS(foo.insert(foo.size(), 0));
+
+        foo.erase(2);
+        foo.pop_back();
+        REQUIRE(foo == small_array<int, 4>({1, 2, 3}));
+    }
+
+    SECTION("EMPLACE AND MOVE-ONLY ELEMENTS")
+    {
+        small_array<std::unique_ptr<int>, 2> foo;
+        foo.push_back(std::make_unique<int>(1));
+        foo.emplace_back(new int(3));
+        foo.insert(1, std::make_unique<int>(2));
+        foo.emplace(0, new int(0));
+
+        REQUIRE_FALSE(foo.is_inline());
+        for (unsigned int i = 0; i < foo.size(); i++)
+            REQUIRE(*foo[i] == (int)i);
+    }
+
+    SECTION("CLEAR KEEPS CAPACITY, SHRINK TO FIT RELEASES IT")
+    {
+        small_array<int, 2> foo = {1, 2, 3};
+        const int *storage = foo.data();
+
+        foo.clear();
+
+        REQUIRE(foo.empty());
+        REQUIRE_FALSE(foo.is_inline());
+        REQUIRE(foo.capacity() == 3);
+        REQUIRE_THROWS(foo.front());
+
+        // Refilled without a new allocation
+        for (int i = 0; i < 3; i++)
+            foo.push_back(i);
+        REQUIRE(foo.data() == storage);
+
+        foo.push_back(3);
+        foo.shrink_to_fit();
+        REQUIRE(foo.capacity() == foo.size());
+        REQUIRE(foo == small_array<int, 2>({0, 1, 2, 3}));
+
+        foo.pop_back();
+        foo.pop_back();
+        foo.shrink_to_fit();
+        REQUIRE(foo.is_inline());
+        REQUIRE(foo.capacity() == 2);
+        REQUIRE(foo == small_array<int, 2>({0, 1}));
+    }
+}
+
+TEST_CASE("MOVE AND SWAP", "[OPERATIONS]")
+{
+    STATIC_REQUIRE(std::is_nothrow_move_constructible_v<small_array<std::string, 2>>);
+    STATIC_REQUIRE(std::is_nothrow_swappable_v<small_array<std::string, 2>>);
+
+    small_array<std::string, 2> inl = {"first"};
+    small_array<std::string, 2> heap = {"a", "b", "c", "d"};
+
+    SECTION("MOVE CONSTRUCTOR TAKES OVER THE HEAP BUFFER")
+    {
+        const std::string *storage = heap.data();
+
+        small_array<std::string, 2> foo(std::move(heap));
+        REQUIRE(foo.data() == storage);
+        REQUIRE(foo.size() == 4);
+        REQUIRE(heap.empty());
+        REQUIRE(heap.is_inline());
+
+        small_array<std::string, 2> bar(std::move(inl));
+        REQUIRE(bar.is_inline());
+        REQUIRE(bar.front() == "first");
+        REQUIRE(inl.empty());
+    }
+
+    SECTION("SWAP")
+    {
+        small_array<std::string, 2> other = {"w", "x", "y"};
+        const std::string *storage = heap.data();
+        const std::string *other_storage = other.data();
+
+        // Heap with heap - only the buffers change owners
+        swap(heap, other);
+        REQUIRE(heap.data() == other_storage);
+        REQUIRE(other.data() == storage);
+        REQUIRE(heap == small_array<std::string, 2>({"w", "x", "y"}));
+
+        // Inline with heap
+        swap(inl, other);
+        REQUIRE(inl.data() == storage);
+        REQUIRE(other.is_inline());
+        REQUIRE(other.front() == "first");
+        REQUIRE(inl.size() == 4);
+    }
+}
+
+TEST_CASE("ITERATOR", "[ITERATOR]")
+{
+    small_array<int, 8> vec = {1, 2, 3, 4};
+    bool EQUAL_FLAG = true;
+
+    int num = 1;
+    for (auto el : vec)
+    {
+        if (el != num++)
+        {
+            EQUAL_FLAG = false;
+            break;
+        }
+    }
+
+    REQUIRE(EQUAL_FLAG);
+}
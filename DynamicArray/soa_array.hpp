@@ -0,0 +1,457 @@
+#ifndef SOA_ARRAY_GUARD
+#define SOA_ARRAY_GUARD
+
+/*
+ *  Structure-of-arrays container: every field of a record lives in its own
+ *  contiguous dynamic_array column, so loops over a few fields only load
+ *  those columns into the cache.
+ *
+ *  Rows are accessed through lightweight proxies (arr[i].get<1>(),
+ *  structured bindings), columns as spans over contiguous memory
+ *  (arr.column<1>()). All columns grow together and always hold the same
+ *  number of elements.
+*/
+
+#include "dynamic_array.hpp" // Column storage
+
+#include <cstddef>     // std::size_t
+#include <tuple>       // Field list
+#include <type_traits> // Const proxies
+#include <utility>     // std::index_sequence
+
+namespace ds
+{
+    // View of count contiguous elements - T is const-qualified for read-only columns
+    template <class T>
+    class column_span
+    {
+    public:
+        column_span(T *data, std::size_t size) : m_data(data), m_size(size) {}
+
+        T *data() const { return m_data; }
+        std::size_t size() const { return m_size; }
+        bool empty() const { return m_size == 0; }
+
+        T &operator[](std::size_t index) const
+        {
+            detail::check_subscript(index, m_size); // Policy selected by DS_BOUNDS_CHECK
+
+            return m_data[index];
+        }
+
+        T *begin() const { return m_data; }
+        T *end() const { return m_data + m_size; }
+
+    private:
+        T *m_data;
+        std::size_t m_size;
+    };
+
+    template <class... Fields>
+    class soa_array;
+
+    // Proxy of one row of a soa_array - holds the array and the index, the fields are accessed in their columns.
+    // Const proxies give read-only access; a proxy converts to the const one.
+    template <bool Const, class... Fields>
+    class soa_row
+    {
+        friend class soa_array<Fields...>;
+        template <bool, class...>
+        friend class soa_row;
+
+        using owner_type = std::conditional_t<Const, const soa_array<Fields...>, soa_array<Fields...>>;
+        using value_type = std::tuple<Fields...>;
+
+    public:
+        template <std::size_t I>
+        using reference = std::conditional_t<Const, const std::tuple_element_t<I, value_type> &,
+                                             std::tuple_element_t<I, value_type> &>;
+
+        template <bool OtherConst, class = std::enable_if_t<Const && !OtherConst>>
+        soa_row(const soa_row<OtherConst, Fields...> &other) : m_owner(other.m_owner), m_index(other.m_index) {}
+
+        soa_row(const soa_row &) = default;
+
+        // Assignment copies the fields of the other row - a proxy behaves like the row itself
+        const soa_row &operator=(const soa_row &other) const
+        {
+            return *this = other.value();
+        }
+
+        // Field I of the row
+        template <std::size_t I>
+        reference<I> get() const
+        {
+            return std::get<I>(m_owner->m_columns)[m_index];
+        }
+
+        // Copy of the whole row
+        value_type value() const
+        {
+            return value(std::index_sequence_for<Fields...>());
+        }
+
+        // Assigns every field of the row
+        template <bool C = Const, class = std::enable_if_t<!C>>
+        const soa_row &operator=(const value_type &values) const
+        {
+            assign(values, std::index_sequence_for<Fields...>());
+            return *this;
+        }
+
+        std::size_t index() const { return m_index; }
+
+    private:
+        soa_row(owner_type *owner, std::size_t index) : m_owner(owner), m_index(index) {}
+
+        template <std::size_t... I>
+        value_type value(std::index_sequence<I...>) const
+        {
+            return value_type(get<I>()...);
+        }
+
+        template <std::size_t... I>
+        void assign(const value_type &values, std::index_sequence<I...>) const
+        {
+            ((get<I>() = std::get<I>(values)), ...);
+        }
+
+        owner_type *m_owner;
+        std::size_t m_index;
+    };
+
+    template <class... Fields>
+    class soa_array
+    {
+        static_assert(sizeof...(Fields) > 0, "soa_array requires at least one field");
+
+        template <bool, class...>
+        friend class soa_row;
+
+    public:
+        using size_type = std::size_t;
+        using value_type = std::tuple<Fields...>;
+
+        template <std::size_t I>
+        using field_type = std::tuple_element_t<I, value_type>;
+
+        // Proxies of one row - hold the array and the index, the elements are accessed in their columns
+        using row_reference = soa_row<false, Fields...>;
+        using const_row_reference = soa_row<true, Fields...>;
+
+        static constexpr size_type field_count = sizeof...(Fields);
+
+        // Constructors
+
+        // Constructs an empty container with room for m_capacity rows in every column
+        explicit soa_array(size_type m_capacity = INIT_CAPACITY);
+
+        ///
+        // Basic Operations
+
+        // Add one row to the back - one argument per field
+        void push_back(const Fields &...values);
+
+        // Constructs the fields of a new back row, each from its own argument
+        template <class... Args>
+        row_reference emplace_back(Args &&...args);
+
+        ///
+        // Access operations
+        row_reference operator[](size_type index);
+        const_row_reference operator[](size_type index) const;
+        row_reference at(size_type index);
+        const_row_reference at(size_type index) const;
+        row_reference front();
+        const_row_reference front() const;
+        row_reference back();
+        const_row_reference back() const;
+
+        // Contiguous elements of field I
+        template <std::size_t I>
+        column_span<field_type<I>> column();
+
+        template <std::size_t I>
+        column_span<const field_type<I>> column() const;
+
+        ///
+        // Remove operations
+        void pop_back();
+
+        // Erase the row at position
+        void erase(size_type position);
+
+        // Destroys all rows, the capacity is kept for reuse
+        void clear();
+
+        ///
+        // Capacity operations
+
+        // Makes room for at least new_capacity rows in every column
+        void reserve(size_type new_capacity);
+
+        size_type size() const;
+        size_type capacity() const;
+        size_type max_size() const;
+        bool empty() const;
+
+    private:
+        std::tuple<dynamic_array<Fields>...> m_columns;
+
+        ///
+        // Helpers
+    private:
+        template <class... Args, std::size_t... I>
+        void emplace_columns(std::index_sequence<I...>, Args &&...args);
+
+        static constexpr size_type row_bytes = (sizeof(Fields) + ...);
+    };
+
+    // O(1) - Constant time
+    template <class... Fields>
+    inline soa_array<Fields...>::soa_array(size_type m_capacity)
+        : m_columns(dynamic_array<Fields>(m_capacity)...)
+    {
+    }
+
+    // Amortized O(1) - Constant time
+    template <class... Fields>
+    inline void soa_array<Fields...>::push_back(const Fields &...values)
+    {
+        emplace_back(values...);
+    }
+
+    // Amortized O(1) - Constant time
+    template <class... Fields>
+    template <class... Args>
+    inline typename soa_array<Fields...>::row_reference soa_array<Fields...>::emplace_back(Args &&...args)
+    {
+        static_assert(sizeof...(Args) == sizeof...(Fields), "soa_array: One argument per field is required");
+
+        if (size() == capacity())
+        {
+            // Built before growing - args might refer to fields of a row which is about to be relocated
+            value_type row(std::forward<Args>(args)...);
+
+            // Grow all columns together, so no column reallocates in the middle of a row
+            reserve(detail::next_capacity<growth::doubling>(capacity(), max_size(), row_bytes));
+
+            std::apply([this](auto &...fields)
+                       { emplace_columns(std::index_sequence_for<Fields...>(), std::move(fields)...); },
+                       row);
+        }
+        else
+        {
+            // Nothing moves - args may refer to any row
+            emplace_columns(std::index_sequence_for<Fields...>(), std::forward<Args>(args)...);
+        }
+
+        return row_reference(this, size() - 1);
+    }
+
+    // O(1) - Constant time
+    template <class... Fields>
+    inline typename soa_array<Fields...>::row_reference soa_array<Fields...>::operator[](size_type index)
+    {
+        detail::check_subscript(index, size()); // Policy selected by DS_BOUNDS_CHECK
+
+        return row_reference(this, index);
+    }
+
+    // O(1) - Constant time
+    template <class... Fields>
+    inline typename soa_array<Fields...>::const_row_reference soa_array<Fields...>::operator[](size_type index) const
+    {
+        detail::check_subscript(index, size());
+
+        return const_row_reference(this, index);
+    }
+
+    // O(1) - Constant time
+    template <class... Fields>
+    inline typename soa_array<Fields...>::row_reference soa_array<Fields...>::at(size_type index)
+    {
+        if (index >= size())
+            throw std::out_of_range("Invalid index!");
+
+        return row_reference(this, index);
+    }
+
+    // O(1) - Constant time
+    template <class... Fields>
+    inline typename soa_array<Fields...>::const_row_reference soa_array<Fields...>::at(size_type index) const
+    {
+        if (index >= size())
+            throw std::out_of_range("Invalid index!");
+
+        return const_row_reference(this, index);
+    }
+
+    // O(1) - Constant time
+    template <class... Fields>
+    inline typename soa_array<Fields...>::row_reference soa_array<Fields...>::front()
+    {
+        if (empty())
+            throw std::logic_error("Empty container!");
+
+        return row_reference(this, 0);
+    }
+
+    // O(1) - Constant time
+    template <class... Fields>
+    inline typename soa_array<Fields...>::const_row_reference soa_array<Fields...>::front() const
+    {
+        if (empty())
+            throw std::logic_error("Empty container!");
+
+        return const_row_reference(this, 0);
+    }
+
+    // O(1) - Constant time
+    template <class... Fields>
+    inline typename soa_array<Fields...>::row_reference soa_array<Fields...>::back()
+    {
+        if (empty())
+            throw std::logic_error("Empty container!");
+
+        return row_reference(this, size() - 1);
+    }
+
+    // O(1) - Constant time
+    template <class... Fields>
+    inline typename soa_array<Fields...>::const_row_reference soa_array<Fields...>::back() const
+    {
+        if (empty())
+            throw std::logic_error("Empty container!");
+
+        return const_row_reference(this, size() - 1);
+    }
+
+    // O(1) - Constant time
+    template <class... Fields>
+    template <std::size_t I>
+    inline column_span<typename soa_array<Fields...>::template field_type<I>> soa_array<Fields...>::column()
+    {
+        auto &col = std::get<I>(m_columns);
+        return {col.data(), col.size()};
+    }
+
+    // O(1) - Constant time
+    template <class... Fields>
+    template <std::size_t I>
+    inline column_span<const typename soa_array<Fields...>::template field_type<I>> soa_array<Fields...>::column() const
+    {
+        const auto &col = std::get<I>(m_columns);
+        return {col.data(), col.size()};
+    }
+
+    // O(1) - Constant time
+    template <class... Fields>
+    inline void soa_array<Fields...>::pop_back()
+    {
+        if (empty())
+            throw std::logic_error("Empty container!");
+
+        std::apply([](auto &...col)
+                   { (col.pop_back(), ...); },
+                   m_columns);
+    }
+
+    // O(n) - Linear time
+    template <class... Fields>
+    inline void soa_array<Fields...>::erase(size_type position)
+    {
+        if (position >= size())
+            throw std::invalid_argument("Invalid position!");
+
+        std::apply([position](auto &...col)
+                   { (col.erase(position), ...); },
+                   m_columns);
+    }
+
+    // O(n) - Linear time
+    template <class... Fields>
+    inline void soa_array<Fields...>::clear()
+    {
+        std::apply([](auto &...col)
+                   { (col.clear(), ...); },
+                   m_columns);
+    }
+
+    // O(n) - Linear time
+    template <class... Fields>
+    inline void soa_array<Fields...>::reserve(size_type new_capacity)
+    {
+        // A column which fails leaves the earlier ones larger - harmless, the rows are untouched
+        std::apply([new_capacity](auto &...col)
+                   { (col.reserve(new_capacity), ...); },
+                   m_columns);
+    }
+
+    // O(1) - Constant time
+    template <class... Fields>
+    inline typename soa_array<Fields...>::size_type soa_array<Fields...>::size() const
+    {
+        return std::get<0>(m_columns).size();
+    }
+
+    // O(1) - Constant time
+    template <class... Fields>
+    inline typename soa_array<Fields...>::size_type soa_array<Fields...>::capacity() const
+    {
+        return std::apply([](const auto &...col)
+                          { return std::min({col.capacity()...}); },
+                          m_columns);
+    }
+
+    // O(1) - Constant time
+    template <class... Fields>
+    inline typename soa_array<Fields...>::size_type soa_array<Fields...>::max_size() const
+    {
+        return std::apply([](const auto &...col)
+                          { return std::min({col.max_size()...}); },
+                          m_columns);
+    }
+
+    // O(1) - Constant time
+    template <class... Fields>
+    inline bool soa_array<Fields...>::empty() const
+    {
+        return size() == 0;
+    }
+
+    ///
+    // Helpers
+
+    // Appends one field to every column; if a constructor throws, the columns already extended are rolled back
+    template <class... Fields>
+    template <class... Args, std::size_t... I>
+    inline void soa_array<Fields...>::emplace_columns(std::index_sequence<I...>, Args &&...args)
+    {
+        size_type done = 0;
+        try
+        {
+            ((std::get<I>(m_columns).emplace_back(std::forward<Args>(args)), ++done), ...);
+        }
+        catch (...)
+        {
+            ((I < done ? std::get<I>(m_columns).pop_back() : void()), ...);
+            throw;
+        }
+    }
+
+} // namespace ds
+
+// Row proxies decompose into their fields: auto [id, price] = arr[i];
+template <bool Const, class... Fields>
+struct std::tuple_size<ds::soa_row<Const, Fields...>> : std::integral_constant<std::size_t, sizeof...(Fields)>
+{
+};
+
+template <std::size_t I, bool Const, class... Fields>
+struct std::tuple_element<I, ds::soa_row<Const, Fields...>>
+{
+    using type = typename ds::soa_row<Const, Fields...>::template reference<I>;
+};
+
+#endif // SOA_ARRAY_GUARD
@@ -0,0 +1,155 @@
+#define CATCH_CONFIG_MAIN
+#include "../Catch2/catch.hpp"
+#include "soa_array.hpp"
+
+#include <numeric>
+#include <string>
+
+using namespace ds;
+
+// Throws on construction from a negative value
+struct Picky
+{
+    Picky(int value) : value(value)
+    {
+        if (value < 0)
+            throw std::runtime_error("negative");
+    }
+
+    int value;
+};
+
+TEST_CASE("CONSTRUCTORS", "[CONSTRUCTOR]")
+{
+    soa_array<int, double, std::string> def;
+
+    REQUIRE(def.size() == 0);
+    REQUIRE(def.empty());
+    REQUIRE(def.capacity() == INIT_CAPACITY);
+    REQUIRE(soa_array<int, double, std::string>::field_count == 3);
+    REQUIRE_THROWS(def.at(0));
+    REQUIRE_THROWS(def.front());
+
+    soa_array<int, char> small(2);
+    REQUIRE(small.capacity() == 2);
+}
+
+TEST_CASE("DEFAULT OPERATIONS", "[OPERATIONS]")
+{
+    soa_array<int, double, std::string> foo(2);
+
+    SECTION("PUSH BACK GROWS ALL COLUMNS")
+    {
+        for (int i = 0; i < 100; i++)
+            foo.push_back(i, i * 0.5, std::to_string(i));
+
+        REQUIRE(foo.size() == 100);
+        REQUIRE(foo.capacity() >= 100);
+        REQUIRE(foo.column<0>().size() == 100);
+        REQUIRE(foo.column<2>().size() == 100);
+        REQUIRE(foo[42].get<2>() == "42");
+        REQUIRE(foo.back().get<1>() == 49.5);
+    }
+
+    SECTION("EMPLACE BACK RETURNS THE ROW")
+    {
+        auto row = foo.emplace_back(1, 2.0, "three");
+
+        REQUIRE(row.index() == 0);
+        REQUIRE(row.get<0>() == 1);
+        REQUIRE(row.get<2>() == "three");
+    }
+
+    SECTION("PUSH BACK OF AN OWN ROW AT FULL CAPACITY")
+    {
+        foo.push_back(1, 1.5, "a string which does not fit the small buffer");
+        foo.push_back(2, 2.5, "b");
+        REQUIRE(foo.size() == foo.capacity());
+
+        // The arguments refer to the columns which are about to grow
+        foo.push_back(foo[0].get<0>(), foo[0].get<1>(), foo[0].get<2>());
+        REQUIRE(foo.size() == 3);
+        REQUIRE(foo[2].value() == foo[0].value());
+
+        soa_array<int, int> pairs(1);
+        pairs.push_back(3, 4);
+        pairs.emplace_back(pairs[0].get<1>(), pairs[0].get<0>()); // Across columns
+        REQUIRE(pairs[1].value() == std::make_tuple(4, 3));
+    }
+
+    SECTION("ROW PROXIES")
+    {
+        foo.push_back(1, 1.0, "a");
+        foo.push_back(2, 2.0, "b");
+
+        foo[0].get<1>() = 10.0;
+        REQUIRE(foo.front().get<1>() == 10.0);
+
+        foo[1] = std::make_tuple(20, 20.0, std::string("bb"));
+        REQUIRE(foo[1].value() == std::make_tuple(20, 20.0, std::string("bb")));
+
+        foo[0] = foo[1]; // Copies the fields, not the proxy
+        REQUIRE(foo[0].get<2>() == "bb");
+
+        auto [id, weight, name] = foo[0];
+        id = 7;
+        REQUIRE(foo[0].get<0>() == 7);
+        REQUIRE(weight == 20.0);
+        REQUIRE(name == "bb");
+
+        const auto &cfoo = foo;
+        soa_array<int, double, std::string>::const_row_reference crow = foo[1]; // Converts to a read-only row
+        static_assert(std::is_same_v<decltype(cfoo[0].get<0>()), const int &>);
+        REQUIRE(crow.get<0>() == 20);
+    }
+
+    SECTION("COLUMN SPANS")
+    {
+        for (int i = 1; i <= 10; i++)
+            foo.push_back(i, 1.0, "");
+
+        column_span<int> ids = foo.column<0>();
+        REQUIRE(std::accumulate(ids.begin(), ids.end(), 0) == 55);
+
+        for (int &id : ids)
+            id *= 2;
+        REQUIRE(foo[9].get<0>() == 20);
+
+        const auto &cfoo = foo;
+        column_span<const double> weights = cfoo.column<1>();
+        REQUIRE(weights.data() + 9 == &foo[9].get<1>());
+        REQUIRE(weights[3] == 1.0);
+    }
+
+    SECTION("POP BACK, ERASE AND CLEAR")
+    {
+        for (int i = 0; i < 5; i++)
+            foo.push_back(i, i, std::to_string(i));
+
+        foo.pop_back();
+        foo.erase(1);
+
+        REQUIRE(foo.size() == 3);
+        REQUIRE(foo[1].get<2>() == "2");
+        REQUIRE(foo[1].get<0>() == 2);
+        REQUIRE_THROWS(foo.erase(3));
+
+        const std::size_t capacity = foo.capacity();
+        foo.clear();
+        REQUIRE(foo.empty());
+        REQUIRE(foo.capacity() == capacity);
+        REQUIRE_THROWS(foo.pop_back());
+    }
+
+    SECTION("FAILED CONSTRUCTION LEAVES NO PARTIAL ROW")
+    {
+        soa_array<std::string, Picky> bar;
+        bar.push_back("ok", 1);
+
+        REQUIRE_THROWS(bar.emplace_back("bad", -1));
+
+        REQUIRE(bar.size() == 1);
+        REQUIRE(bar.column<0>().size() == 1);
+        REQUIRE(bar.column<1>().size() == 1);
+    }
+}
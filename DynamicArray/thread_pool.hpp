@@ -0,0 +1,189 @@
+#ifndef THREAD_POOL_GUARD
+#define THREAD_POOL_GUARD
+
+/*
+ *  Fixed-size pool of worker threads used by the parallel algorithms.
+ *  Tasks are run in FIFO order; parallel_for() splits a job into tasks
+ *  and blocks until all of them finished.
+*/
+
+#include <condition_variable> // Worker wake up
+#include <cstddef>            // std::size_t
+#include <exception>          // Propagating task failures
+#include <functional>         // std::function
+#include <mutex>              // Queue synchronization
+#include <queue>              // Task queue
+#include <stdexcept>          // Exception handling
+#include <thread>             // Workers
+#include <vector>             // Worker list
+
+namespace ds
+{
+    class thread_pool
+    {
+    public:
+        // Starts threads workers (at least one); defaults to the hardware concurrency
+        explicit thread_pool(std::size_t threads = std::thread::hardware_concurrency());
+
+        // Finishes the queued tasks and joins the workers
+        ~thread_pool();
+
+        thread_pool(const thread_pool &) = delete;
+        thread_pool &operator=(const thread_pool &) = delete;
+
+        // Number of worker threads
+        std::size_t size() const { return m_workers.size(); }
+
+        // Queues task for execution by one of the workers
+        void submit(std::function<void()> task);
+
+        // Calls fn(i) for every i in [0, count) - on the workers and the calling thread -
+        // and returns once all calls completed. Rethrows the first exception thrown by fn.
+        // If a task can not be queued, waits for the queued ones and rethrows that failure.
+        // Must not be called from inside a task of the same pool.
+        template <class Function>
+        void parallel_for(std::size_t count, Function fn);
+
+        // Pool shared by the parallel algorithms when none is passed explicitly
+        static thread_pool &global();
+
+    private:
+        void work();
+
+        std::vector<std::thread> m_workers;
+        std::queue<std::function<void()>> m_tasks;
+        std::mutex m_mutex;
+        std::condition_variable m_available;
+        bool m_stopping = false;
+    };
+
+    inline thread_pool::thread_pool(std::size_t threads)
+    {
+        if (threads == 0)
+            threads = 1;
+
+        m_workers.reserve(threads);
+        for (std::size_t i = 0; i < threads; i++)
+            m_workers.emplace_back(&thread_pool::work, this);
+    }
+
+    inline thread_pool::~thread_pool()
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_stopping = true;
+        }
+
+        m_available.notify_all();
+        for (std::thread &worker : m_workers)
+            worker.join();
+    }
+
+    inline void thread_pool::submit(std::function<void()> task)
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (m_stopping)
+                throw std::logic_error("thread_pool: Cannot submit to a stopping pool!");
+
+            m_tasks.push(std::move(task));
+        }
+
+        m_available.notify_one();
+    }
+
+    template <class Function>
+    inline void thread_pool::parallel_for(std::size_t count, Function fn)
+    {
+        if (count == 0)
+            return;
+
+        // Completion state shared with the queued tasks
+        std::mutex done_mutex;
+        std::condition_variable done;
+        std::size_t remaining = count - 1;
+        std::exception_ptr failure;
+
+        auto run = [&](std::size_t i)
+        {
+            try
+            {
+                fn(i);
+            }
+            catch (...)
+            {
+                std::lock_guard<std::mutex> lock(done_mutex);
+                if (!failure)
+                    failure = std::current_exception();
+            }
+        };
+
+        auto wait = [&]
+        {
+            std::unique_lock<std::mutex> lock(done_mutex);
+            done.wait(lock, [&]
+                      { return remaining == 0; });
+        };
+
+        for (std::size_t i = 1; i < count; i++)
+        {
+            try
+            {
+                submit([&, i]
+                       {
+                           run(i);
+
+                           std::lock_guard<std::mutex> lock(done_mutex);
+                           if (--remaining == 0)
+                               done.notify_one();
+                       });
+            }
+            catch (...)
+            {
+                // The queued tasks refer to this frame - they have to finish before it unwinds
+                {
+                    std::lock_guard<std::mutex> lock(done_mutex);
+                    remaining -= count - i; // Tasks i..count-1 were never queued
+                }
+                wait();
+                throw;
+            }
+        }
+
+        run(0); // The calling thread takes a share as well
+        wait();
+
+        if (failure)
+            std::rethrow_exception(failure);
+    }
+
+    inline thread_pool &thread_pool::global()
+    {
+        static thread_pool pool;
+        return pool;
+    }
+
+    inline void thread_pool::work()
+    {
+        for (;;)
+        {
+            std::function<void()> task;
+            {
+                std::unique_lock<std::mutex> lock(m_mutex);
+                m_available.wait(lock, [this]
+                                 { return m_stopping || !m_tasks.empty(); });
+
+                if (m_tasks.empty())
+                    return; // Stopping and nothing left to do
+
+                task = std::move(m_tasks.front());
+                m_tasks.pop();
+            }
+
+            task();
+        }
+    }
+
+} // namespace ds
+
+#endif // THREAD_POOL_GUARD